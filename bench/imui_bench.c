@@ -0,0 +1,492 @@
+#include "imui/imui.h"
+#include "imui/imui_toolbox.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define IMUI_BENCH_TEXT_ITEM_COUNT		1000u
+#define IMUI_BENCH_TEXT_ITEM_LENGTH		64u
+
+typedef struct ImuiBenchCorpus
+{
+	const char*		name;
+	const char*		sample;		// repeated to fill the corpus
+	char*			data;
+	size_t			length;
+} ImuiBenchCorpus;
+
+static ImuiBenchCorpus s_corpora[] =
+{
+	{ "ascii",		"The quick brown fox jumps over the lazy dog. 0123456789\n", NULL, 0u },
+	{ "latin",		"Fa\xc3\xa7" "ade na\xc3\xaf" "ve r\xc3\xa9sum\xc3\xa9 \xc3\xbc" "ber Stra\xc3\x9f" "e co\xc3\xb6perate\n", NULL, 0u },
+	{ "cyrillic",	"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xd0\xbc\xd0\xb8\xd1\x80 \xd1\x82\xd0\xb5\xd0\xba\xd1\x81\xd1\x82 hello\n", NULL, 0u },
+	{ "cjk",		"\xe4\xb8\x80\xe4\xba\x8c\xe4\xb8\x89\xe5\x9b\x9b\xe4\xba\x94 abc \xe4\xb8\x8a\xe4\xb8\x8b\xe5\xb7\xa6\xe5\x8f\xb3\n", NULL, 0u },
+	{ "mixed",		"Hello \xd0\xbc\xd0\xb8\xd1\x80 \xe4\xb8\x96\xe7\x95\x8c caf\xc3\xa9 plain ascii words in between\n", NULL, 0u },
+};
+
+typedef size_t (*ImuiBenchSceneFunc)( ImuiWindow* window, size_t windowIndex );	// returns the number of widgets
+
+typedef struct ImuiBenchScene
+{
+	const char*			name;
+	size_t				windowCount;
+	ImuiBenchSceneFunc	func;
+} ImuiBenchScene;
+
+typedef struct ImuiBenchPhases
+{
+	double*				build;
+	double*				layout;
+	double*				draw;
+} ImuiBenchPhases;
+
+static size_t	imuiBenchSceneDeepTree( ImuiWindow* window, size_t windowIndex );
+static size_t	imuiBenchSceneWideRow( ImuiWindow* window, size_t windowIndex );
+static size_t	imuiBenchSceneGrid( ImuiWindow* window, size_t windowIndex );
+static size_t	imuiBenchSceneTextList( ImuiWindow* window, size_t windowIndex );
+static size_t	imuiBenchSceneWindow( ImuiWindow* window, size_t windowIndex );
+
+static const ImuiBenchScene s_scenes[] =
+{
+	{ "deep_tree",		1u,		imuiBenchSceneDeepTree },
+	{ "wide_row",		1u,		imuiBenchSceneWideRow },
+	{ "grid",			1u,		imuiBenchSceneGrid },
+	{ "text_list",		1u,		imuiBenchSceneTextList },
+	{ "many_windows",	200u,	imuiBenchSceneWindow },
+};
+
+static char s_textItems[ IMUI_BENCH_TEXT_ITEM_COUNT ][ IMUI_BENCH_TEXT_ITEM_LENGTH ];
+
+static double imuiBenchGetTime()
+{
+	struct timespec time;
+	timespec_get( &time, TIME_UTC );
+	return (double)time.tv_sec + ((double)time.tv_nsec / 1000000000.0);
+}
+
+static void imuiBenchPrintHeader()
+{
+	printf( "benchmark,corpus,bytes,iterations,seconds,mb_per_second\n" );
+}
+
+static void imuiBenchPrintResult( const char* benchmark, const ImuiBenchCorpus* corpus, size_t iterations, double seconds )
+{
+	const double megaBytes = ((double)corpus->length * (double)iterations) / (1024.0 * 1024.0);
+	printf( "%s,%s,%zu,%zu,%.6f,%.2f\n", benchmark, corpus->name, corpus->length, iterations, seconds, megaBytes / seconds );
+}
+
+static bool imuiBenchCreateCorpus( ImuiBenchCorpus* corpus, size_t targetLength )
+{
+	const size_t sampleLength = strlen( corpus->sample );
+	const size_t sampleCount = targetLength / sampleLength;
+
+	corpus->length	= sampleLength * sampleCount;
+	corpus->data	= (char*)malloc( corpus->length + 1u );
+	if( !corpus->data )
+	{
+		return false;
+	}
+
+	for( size_t i = 0u; i < sampleCount; ++i )
+	{
+		memcpy( corpus->data + (i * sampleLength), corpus->sample, sampleLength );
+	}
+	corpus->data[ corpus->length ] = '\0';
+
+	return true;
+}
+
+static ImuiFont* imuiBenchCreateFont( ImuiContext* imui )
+{
+	static const uint32_t ranges[][ 2u ] =
+	{
+		{ 0x20u, 0x7eu },
+		{ 0xa0u, 0x17fu },
+		{ 0x400u, 0x4ffu },
+		{ 0x4e00u, 0x9fffu },
+		{ 0xfffdu, 0xfffdu }
+	};
+
+	size_t codepointCount = 0u;
+	for( size_t i = 0u; i < sizeof( ranges ) / sizeof( *ranges ); ++i )
+	{
+		codepointCount += ranges[ i ][ 1u ] - ranges[ i ][ 0u ] + 1u;
+	}
+
+	ImuiFontCodepoint* codepoints = (ImuiFontCodepoint*)calloc( codepointCount, sizeof( ImuiFontCodepoint ) );
+	if( !codepoints )
+	{
+		return NULL;
+	}
+
+	ImuiFontCodepoint* codepoint = codepoints;
+	for( size_t i = 0u; i < sizeof( ranges ) / sizeof( *ranges ); ++i )
+	{
+		for( uint32_t c = ranges[ i ][ 0u ]; c <= ranges[ i ][ 1u ]; ++c )
+		{
+			codepoint->codepoint	= c;
+			codepoint->width		= 7.0f;
+			codepoint->height		= 12.0f;
+			codepoint->advance		= c < 0x4e00u ? 8.0f : 14.0f;
+			codepoint++;
+		}
+	}
+
+	ImuiFontParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+	parameters.codepoints		= codepoints;
+	parameters.codepointCount	= codepointCount;
+	parameters.fontSize			= 16.0f;
+	parameters.lineGap			= 4.0f;
+
+	ImuiFont* font = imuiFontCreate( imui, &parameters );
+	free( codepoints );
+	return font;
+}
+
+static void imuiBenchText( ImuiContext* imui, ImuiFont* font, size_t iterations )
+{
+	for( size_t corpusIndex = 0u; corpusIndex < sizeof( s_corpora ) / sizeof( *s_corpora ); ++corpusIndex )
+	{
+		const ImuiBenchCorpus* corpus = &s_corpora[ corpusIndex ];
+
+		size_t glyphCount = 0u;
+		double startTime = imuiBenchGetTime();
+		for( size_t i = 0u; i < iterations; ++i )
+		{
+			glyphCount += imuiTextLayoutCalculateGlyphCount( corpus->data, corpus->length );
+		}
+		imuiBenchPrintResult( "glyph_count", corpus, iterations, imuiBenchGetTime() - startTime );
+
+		// new version every iteration to skip the layout cache
+		startTime = imuiBenchGetTime();
+		for( size_t i = 0u; i < iterations; ++i )
+		{
+			ImuiFrame* frame = imuiBegin( imui, (double)i );
+			imuiTextLayoutCreateStatic( imui, font, corpus->data, corpus->length, i );
+			imuiEnd( frame );
+		}
+		imuiBenchPrintResult( "layout", corpus, iterations, imuiBenchGetTime() - startTime );
+
+		(void)glyphCount;
+	}
+}
+
+static size_t imuiBenchSceneDeepTree( ImuiWindow* window, size_t windowIndex )
+{
+	(void)windowIndex;
+
+	const size_t depth = 256u;
+
+	ImuiWidget* widgets[ 256u ];
+	for( size_t i = 0u; i < depth; ++i )
+	{
+		widgets[ i ] = imuiWidgetBegin( window );
+		imuiWidgetSetLayoutVertical( widgets[ i ] );
+		imuiWidgetSetPadding( widgets[ i ], imuiBorderCreateAll( 1.0f ) );
+		imuiWidgetDrawColor( widgets[ i ], imuiColorCreate( (uint8_t)i, 64u, 128u, 255u ) );
+
+		imuiToolboxLabel( window, "Node" );
+	}
+
+	for( size_t i = depth; i > 0u; --i )
+	{
+		imuiWidgetEnd( widgets[ i - 1u ] );
+	}
+
+	return depth * 2u;
+}
+
+static size_t imuiBenchSceneWideRow( ImuiWindow* window, size_t windowIndex )
+{
+	(void)windowIndex;
+
+	const size_t count = 2000u;
+
+	ImuiWidget* row = imuiWidgetBegin( window );
+	imuiWidgetSetLayoutHorizontalSpacing( row, 2.0f );
+	for( size_t i = 0u; i < count; ++i )
+	{
+		ImuiWidget* cell = imuiWidgetBegin( window );
+		imuiWidgetSetFixedSizeFloat( cell, 16.0f, 16.0f );
+		imuiWidgetDrawColor( cell, imuiColorCreate( 255u, (uint8_t)i, 0u, 255u ) );
+		imuiWidgetEnd( cell );
+	}
+	imuiWidgetEnd( row );
+
+	return count + 1u;
+}
+
+static size_t imuiBenchSceneGrid( ImuiWindow* window, size_t windowIndex )
+{
+	(void)windowIndex;
+
+	const size_t columnCount	= 64u;
+	const size_t rowCount		= 64u;
+
+	ImuiWidget* grid = imuiWidgetBegin( window );
+	imuiWidgetSetLayoutGrid( grid, (uint32_t)columnCount, 2.0f, 2.0f );
+	for( size_t i = 0u; i < columnCount * rowCount; ++i )
+	{
+		ImuiWidget* cell = imuiWidgetBegin( window );
+		imuiWidgetSetFixedSizeFloat( cell, 12.0f, 12.0f );
+		imuiWidgetDrawColor( cell, imuiColorCreate( (uint8_t)(i % columnCount), (uint8_t)(i / columnCount), 128u, 255u ) );
+		imuiWidgetEnd( cell );
+	}
+	imuiWidgetEnd( grid );
+
+	return (columnCount * rowCount) + 1u;
+}
+
+static size_t imuiBenchSceneTextList( ImuiWindow* window, size_t windowIndex )
+{
+	(void)windowIndex;
+
+	ImuiWidget* list = imuiWidgetBegin( window );
+	imuiWidgetSetLayoutVertical( list );
+	for( size_t i = 0u; i < IMUI_BENCH_TEXT_ITEM_COUNT; ++i )
+	{
+		imuiToolboxLabel( window, s_textItems[ i ] );
+	}
+	imuiWidgetEnd( list );
+
+	return IMUI_BENCH_TEXT_ITEM_COUNT + 1u;
+}
+
+static size_t imuiBenchSceneWindow( ImuiWindow* window, size_t windowIndex )
+{
+	ImuiWidget* panel = imuiWidgetBegin( window );
+	imuiWidgetSetLayoutVerticalSpacing( panel, 4.0f );
+	imuiWidgetSetPadding( panel, imuiBorderCreateAll( 4.0f ) );
+	imuiWidgetDrawColor( panel, imuiColorCreate( 40u, 40u, 48u, 255u ) );
+
+	imuiToolboxLabel( window, s_textItems[ windowIndex % IMUI_BENCH_TEXT_ITEM_COUNT ] );
+	for( size_t i = 0u; i < 4u; ++i )
+	{
+		imuiToolboxButtonLabel( window, "Button" );
+	}
+
+	bool checked = (windowIndex & 1u) != 0u;
+	imuiToolboxCheckBox( window, &checked, "Check" );
+
+	float value = 0.5f;
+	imuiToolboxSlider( window, &value );
+
+	imuiWidgetEnd( panel );
+
+	return 8u;
+}
+
+static int imuiBenchCompareDouble( const void* lhs, const void* rhs )
+{
+	const double lhsValue = *(const double*)lhs;
+	const double rhsValue = *(const double*)rhs;
+	return lhsValue < rhsValue ? -1 : (lhsValue > rhsValue ? 1 : 0);
+}
+
+static double imuiBenchGetMedian( double* values, size_t count )
+{
+	qsort( values, count, sizeof( *values ), imuiBenchCompareDouble );
+	return values[ count / 2u ];
+}
+
+static void imuiBenchScenes( ImuiContext* imui, size_t frameCount )
+{
+	for( size_t i = 0u; i < IMUI_BENCH_TEXT_ITEM_COUNT; ++i )
+	{
+		snprintf( s_textItems[ i ], IMUI_BENCH_TEXT_ITEM_LENGTH, "Item %zu - The quick brown fox jumps over the lazy dog", i );
+	}
+
+	ImuiBenchPhases phases;
+	phases.build	= (double*)malloc( sizeof( double ) * frameCount );
+	phases.layout	= (double*)malloc( sizeof( double ) * frameCount );
+	phases.draw		= (double*)malloc( sizeof( double ) * frameCount );
+
+	size_t vertexCapacity = 0u;
+	size_t indexCapacity = 0u;
+	void* vertexData = NULL;
+	void* indexData = NULL;
+
+	printf( "scene,widgets,frames,build_us,layout_us,draw_us,total_us,commands,vertex_bytes\n" );
+
+	const ImuiSize surfaceSize = imuiSizeCreate( 1920.0f, 1080.0f );
+	for( size_t sceneIndex = 0u; sceneIndex < sizeof( s_scenes ) / sizeof( *s_scenes ); ++sceneIndex )
+	{
+		const ImuiBenchScene* scene = &s_scenes[ sceneIndex ];
+
+		size_t widgetCount = 0u;
+		size_t commandCount = 0u;
+		size_t vertexSize = 0u;
+
+		// two warm up frames so widget state and text layouts exist like in a running application
+		for( size_t frameIndex = 0u; frameIndex < frameCount + 2u; ++frameIndex )
+		{
+			imuiInputBegin( imui, NULL );
+			const ImuiInputState* input = imuiInputEnd( imui );
+
+			double buildTime = 0.0;
+			double layoutTime = 0.0;
+
+			double startTime = imuiBenchGetTime();
+			ImuiFrame* frame = imuiBegin( imui, (double)frameIndex / 60.0 );
+			ImuiSurface* surface = imuiSurfaceBegin( frame, "bench", surfaceSize, input, 1.0f );
+
+			widgetCount = 0u;
+			for( size_t windowIndex = 0u; windowIndex < scene->windowCount; ++windowIndex )
+			{
+				const float x = (float)((windowIndex * 37u) % 1700u);
+				const float y = (float)((windowIndex * 53u) % 900u);
+				const ImuiRect rect = scene->windowCount > 1u ? imuiRectCreate( x, y, 200.0f, 180.0f ) : imuiRectCreateSize( 0.0f, 0.0f, surfaceSize );
+
+				ImuiWindow* window = imuiWindowBeginId( surface, scene->name, (ImuiId)windowIndex, rect, (uint32_t)windowIndex );
+				widgetCount += scene->func( window, windowIndex );
+
+				const double layoutStartTime = imuiBenchGetTime();
+				imuiWindowEnd( window );
+				const double layoutEndTime = imuiBenchGetTime();
+
+				buildTime += layoutStartTime - startTime;
+				layoutTime += layoutEndTime - layoutStartTime;
+				startTime = layoutEndTime;
+			}
+
+			const double drawStartTime = imuiBenchGetTime();
+			imuiSurfaceEnd( surface );
+
+			size_t vertexDataSize;
+			size_t indexDataSize;
+			imuiSurfaceGetMaxBufferSizes( surface, &vertexDataSize, &indexDataSize );
+			if( vertexDataSize > vertexCapacity || indexDataSize > indexCapacity )
+			{
+				vertexCapacity	= vertexDataSize > vertexCapacity ? vertexDataSize * 2u : vertexCapacity;
+				indexCapacity	= indexDataSize > indexCapacity ? indexDataSize * 2u : indexCapacity;
+				free( vertexData );
+				free( indexData );
+				vertexData	= malloc( vertexCapacity );
+				indexData	= malloc( indexCapacity + 1u );
+			}
+
+			const ImuiDrawData* drawData = imuiSurfaceGenerateDrawData( surface, vertexData, &vertexDataSize, indexData, &indexDataSize );
+			const double drawEndTime = imuiBenchGetTime();
+
+			imuiEnd( frame );
+
+			commandCount	= drawData->commandCount;
+			vertexSize		= vertexDataSize;
+			if( frameIndex < 2u )
+			{
+				continue;
+			}
+
+			phases.build[ frameIndex - 2u ]		= buildTime;
+			phases.layout[ frameIndex - 2u ]	= layoutTime;
+			phases.draw[ frameIndex - 2u ]		= drawEndTime - drawStartTime;
+		}
+
+		// medians are more stable across runs than averages
+		const double build	= imuiBenchGetMedian( phases.build, frameCount ) * 1000000.0;
+		const double layout	= imuiBenchGetMedian( phases.layout, frameCount ) * 1000000.0;
+		const double draw	= imuiBenchGetMedian( phases.draw, frameCount ) * 1000000.0;
+		printf( "%s,%zu,%zu,%.2f,%.2f,%.2f,%.2f,%zu,%zu\n", scene->name, widgetCount, frameCount, build, layout, draw, build + layout + draw, commandCount, vertexSize );
+	}
+
+	free( vertexData );
+	free( indexData );
+	free( phases.build );
+	free( phases.layout );
+	free( phases.draw );
+}
+
+int main( int argc, char* argv[] )
+{
+	const char* suite = "all";
+	size_t iterations = 20u;
+	size_t frameCount = 100u;
+	size_t corpusLength = 1024u * 1024u;
+	for( int i = 1; i + 1 < argc; i += 2 )
+	{
+		if( strcmp( argv[ i ], "--iterations" ) == 0 )
+		{
+			iterations = (size_t)strtoul( argv[ i + 1 ], NULL, 10 );
+		}
+		else if( strcmp( argv[ i ], "--bytes" ) == 0 )
+		{
+			corpusLength = (size_t)strtoul( argv[ i + 1 ], NULL, 10 );
+		}
+		else if( strcmp( argv[ i ], "--frames" ) == 0 )
+		{
+			frameCount = (size_t)strtoul( argv[ i + 1 ], NULL, 10 );
+		}
+		else if( strcmp( argv[ i ], "--suite" ) == 0 )
+		{
+			suite = argv[ i + 1 ];
+		}
+	}
+
+	const bool runText		= strcmp( suite, "all" ) == 0 || strcmp( suite, "text" ) == 0;
+	const bool runScenes	= strcmp( suite, "all" ) == 0 || strcmp( suite, "scenes" ) == 0;
+	if( (!runText && !runScenes) || frameCount == 0u )
+	{
+		fprintf( stderr, "Usage: imui_bench [--suite all|text|scenes] [--iterations n] [--bytes n] [--frames n]\n" );
+		return 1;
+	}
+
+	for( size_t i = 0u; i < sizeof( s_corpora ) / sizeof( *s_corpora ); ++i )
+	{
+		if( !imuiBenchCreateCorpus( &s_corpora[ i ], corpusLength ) )
+		{
+			fprintf( stderr, "Failed to create corpus '%s'.\n", s_corpora[ i ].name );
+			return 1;
+		}
+	}
+
+	ImuiParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+
+	ImuiContext* imui = imuiCreate( &parameters );
+	if( !imui )
+	{
+		fprintf( stderr, "Failed to create context.\n" );
+		return 1;
+	}
+
+	ImuiFont* font = imuiBenchCreateFont( imui );
+	if( !font )
+	{
+		fprintf( stderr, "Failed to create font.\n" );
+		imuiDestroy( imui );
+		return 1;
+	}
+
+	ImuiToolboxTheme theme;
+	imuiToolboxThemeFillDefault( &theme, font );
+	imuiToolboxThemeSet( &theme );
+
+	// every suite prints its own csv header, suites are separated by an empty line
+	if( runText )
+	{
+		imuiBenchPrintHeader();
+		imuiBenchText( imui, font, iterations );
+	}
+
+	if( runScenes )
+	{
+		if( runText )
+		{
+			printf( "\n" );
+		}
+		imuiBenchScenes( imui, frameCount );
+	}
+
+	imuiFontDestroy( imui, font );
+	imuiDestroy( imui );
+
+	for( size_t i = 0u; i < sizeof( s_corpora ) / sizeof( *s_corpora ); ++i )
+	{
+		free( s_corpora[ i ].data );
+	}
+
+	return 0;
+}
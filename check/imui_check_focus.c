@@ -0,0 +1,223 @@
+#include "imui/imui.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sends random focus directions from random focus widgets and compares the next focus widget with a linear scan that
+// scores every widget. Rows of widgets with random sizes are large enough for the candidate grid in the first rounds and
+// small enough for the linear path in the last rounds.
+
+#define IMUI_CHECK_FRAME_COUNT		400u
+#define IMUI_CHECK_MAX_WIDGETS		2000u
+#define IMUI_CHECK_WIDTH			800.0f
+#define IMUI_CHECK_HEIGHT			600.0f
+
+typedef struct ImuiCheckRound
+{
+	uint32_t					widgetCount;
+	uint32_t					columnCount;
+	float						angleThreshold;
+} ImuiCheckRound;
+
+static const ImuiCheckRound s_rounds[] =
+{
+	{ 2000u, 40u, 0.5f },
+	{ 2000u, 40u, 1.2f },		// the cone is wider than half a circle
+	{ 30u, 7u, 0.5f },
+	{ 30u, 7u, 1.2f }
+};
+
+static uint32_t s_randomState = 1337u;
+
+static uint32_t imuiCheckRandom( uint32_t max )
+{
+	s_randomState = (s_randomState * 1103515245u) + 12345u;
+	return ((s_randomState >> 16u) & 0x7fffu) % max;
+}
+
+static ImuiPos imuiCheckGetCenter( const ImuiWidget* widget )
+{
+	const ImuiRect rect = imuiWidgetGetRect( widget );
+	return imuiPosCreate( rect.pos.x + (rect.size.width * 0.5f), rect.pos.y + (rect.size.height * 0.5f) );
+}
+
+// same factor as the window uses: the squared angle factor plus the squared distance factor
+static bool imuiCheckGetFocusFactor( ImuiPos center, ImuiPos origin, ImuiPos focusDirection, float angleThreshold, float* outFocusFactor )
+{
+	const float diagonalLength	= sqrtf( (IMUI_CHECK_WIDTH * IMUI_CHECK_WIDTH) + (IMUI_CHECK_HEIGHT * IMUI_CHECK_HEIGHT) );
+	const float distanceX		= center.x - origin.x;
+	const float distanceY		= center.y - origin.y;
+	const float distanceLength	= sqrtf( (distanceX * distanceX) + (distanceY * distanceY) );
+
+	const float angleFactor		= ((distanceX / distanceLength) * focusDirection.x) + ((distanceY / distanceLength) * focusDirection.y);
+	const float distanceFactor	= 1.0f - (distanceLength / diagonalLength);
+	*outFocusFactor				= (angleFactor * angleFactor) + (distanceFactor * distanceFactor);
+
+	return angleFactor > 1.0f - angleThreshold;
+}
+
+int main()
+{
+	ImuiParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+
+	ImuiContext* imui = imuiCreate( &parameters );
+	ImuiWidget** widgets = (ImuiWidget**)malloc( sizeof( *widgets ) * IMUI_CHECK_MAX_WIDGETS );
+	ImuiSize* sizes = (ImuiSize*)malloc( sizeof( *sizes ) * IMUI_CHECK_MAX_WIDGETS );
+	if( !imui || !widgets || !sizes )
+	{
+		fprintf( stderr, "Failed to create context.\n" );
+		return 1;
+	}
+
+	size_t foundCount = 0u;
+
+	bool result = true;
+	const ImuiInputState* lastInput = NULL;
+	for( uint32_t roundIndex = 0u; roundIndex < sizeof( s_rounds ) / sizeof( s_rounds[ 0u ] ) && result; ++roundIndex )
+	{
+		const ImuiCheckRound* round = &s_rounds[ roundIndex ];
+		for( uint32_t i = 0u; i < round->widgetCount; ++i )
+		{
+			sizes[ i ] = imuiSizeCreate( (float)(4u + imuiCheckRandom( 16u )), (float)(4u + imuiCheckRandom( 12u )) );
+		}
+
+		int32_t focusIndex = -1;
+		for( uint32_t frameIndex = 0u; frameIndex < IMUI_CHECK_FRAME_COUNT && result; ++frameIndex )
+		{
+			const uint32_t focusChoice = imuiCheckRandom( 8u );
+			if( focusChoice == 0u )
+			{
+				focusIndex = -1;
+			}
+			else if( focusChoice < 4u )
+			{
+				focusIndex = (int32_t)imuiCheckRandom( round->widgetCount );
+			}
+
+			// mostly the eight directions of a game pad, some are slightly off
+			const float angle = (imuiCheckRandom( 8u ) * 0.785398163f) + (imuiCheckRandom( 4u ) == 0u ? (imuiCheckRandom( 100u ) - 50u) * 0.005f : 0.0f);
+			const ImuiPos direction = imuiPosCreate( cosf( angle ), sinf( angle ) );
+
+			ImuiInput* input = imuiInputBegin( imui, lastInput );
+			imuiInputPushDirection( input, direction.x, direction.y );
+			lastInput = imuiInputEnd( imui );
+
+			ImuiFrame* frame = imuiBegin( imui, frameIndex / 60.0 );
+			ImuiSurface* surface = imuiSurfaceBegin( frame, "surface", imuiSizeCreate( IMUI_CHECK_WIDTH, IMUI_CHECK_HEIGHT ), lastInput, 1.0f );
+			ImuiWindow* window = imuiWindowBegin( surface, "window", imuiRectCreate( 0.0f, 0.0f, IMUI_CHECK_WIDTH, IMUI_CHECK_HEIGHT ), 0u );
+			imuiWindowSetFocus( window, round->angleThreshold, false );
+
+			ImuiWidget* rows = imuiWidgetBegin( window );
+			imuiWidgetSetLayoutVertical( rows );
+
+			ImuiWidget* row = NULL;
+			for( uint32_t i = 0u; i < round->widgetCount; ++i )
+			{
+				if( i % round->columnCount == 0u )
+				{
+					if( row )
+					{
+						imuiWidgetEnd( row );
+					}
+
+					row = imuiWidgetBegin( window );
+					imuiWidgetSetLayoutHorizontal( row );
+				}
+
+				ImuiWidget* widget = imuiWidgetBegin( window );
+				imuiWidgetSetFixedSize( widget, sizes[ i ] );
+				imuiWidgetSetCanHaveFocus( widget );
+				imuiWidgetEnd( widget );
+
+				widgets[ i ] = widget;
+			}
+			imuiWidgetEnd( row );
+			imuiWidgetEnd( rows );
+
+			// after all widgets, otherwise the widget focused in the last frame takes the focus back
+			if( focusIndex >= 0 )
+			{
+				imuiWidgetSetFocus( widgets[ focusIndex ] );
+			}
+			else
+			{
+				imuiWindowClearWidgetFocus( window );
+			}
+
+			imuiWindowEnd( window );
+
+			// the focus point is taken before the layout, so the first frames of a round see the old layout
+			const ImuiWidget* nextWidget = imuiWindowPeekFocusWidget( window );
+			if( frameIndex >= 2u )
+			{
+				const ImuiPos origin = focusIndex >= 0 ? imuiCheckGetCenter( widgets[ focusIndex ] ) : imuiPosCreate( 0.0f, 0.0f );
+
+				int32_t bestIndex	= -1;
+				float bestFactor	= 0.0f;
+				int32_t nextIndex	= -1;
+				float nextFactor	= 0.0f;
+				for( uint32_t i = 0u; i < round->widgetCount; ++i )
+				{
+					float focusFactor;
+					const bool inCone = imuiCheckGetFocusFactor( imuiCheckGetCenter( widgets[ i ] ), origin, direction, round->angleThreshold, &focusFactor );
+					if( inCone && focusFactor > bestFactor )
+					{
+						bestIndex	= (int32_t)i;
+						bestFactor	= focusFactor;
+					}
+
+					if( widgets[ i ] == nextWidget )
+					{
+						nextIndex	= inCone ? (int32_t)i : -2;
+						nextFactor	= focusFactor;
+					}
+				}
+
+				// the window may compute the factors with slightly different rounding, ties can go either way then
+				if( nextIndex != bestIndex &&
+					(nextIndex < 0 || bestIndex < 0 || fabsf( nextFactor - bestFactor ) > 0.00001f) )
+				{
+					fprintf( stderr, "round %u frame %u: focus from %d moves to %d but should move to %d\n", roundIndex, frameIndex, focusIndex, nextIndex, bestIndex );
+					result = false;
+				}
+
+				foundCount += bestIndex >= 0;
+			}
+
+			if( nextWidget && imuiCheckRandom( 2u ) == 0u )
+			{
+				for( uint32_t i = 0u; i < round->widgetCount; ++i )
+				{
+					if( widgets[ i ] == nextWidget )
+					{
+						focusIndex = (int32_t)i;
+					}
+				}
+			}
+
+			imuiSurfaceEnd( surface );
+			imuiEnd( frame );
+		}
+	}
+
+	imuiDestroy( imui );
+	free( widgets );
+	free( sizes );
+
+	// most directions should have a candidate
+	if( result && foundCount < IMUI_CHECK_FRAME_COUNT )
+	{
+		fprintf( stderr, "only %zu focus moves found a widget\n", foundCount );
+		result = false;
+	}
+
+	if( result )
+	{
+		printf( "imui_check_focus: passed\n" );
+	}
+
+	return result ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include "imui/imui.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Moves random overlapping windows around and clicks at random positions. Every window has one widget filling it, its
+// hover, press and release state is compared with a scan over all windows for the topmost window at each position.
+
+#define IMUI_CHECK_FRAME_COUNT		2000u
+#define IMUI_CHECK_WINDOW_COUNT		24u
+#define IMUI_CHECK_CLICK_COUNT		3u
+#define IMUI_CHECK_WIDTH			320u
+#define IMUI_CHECK_HEIGHT			240u
+
+typedef struct ImuiCheckWindow
+{
+	ImuiRect					rect;
+	uint32_t					zOrder;
+} ImuiCheckWindow;
+
+typedef struct ImuiCheckClick
+{
+	ImuiPos						downPos;
+	ImuiPos						upPos;
+} ImuiCheckClick;
+
+static uint32_t s_randomState = 4711u;
+
+static uint32_t imuiCheckRandom( uint32_t max )
+{
+	s_randomState = (s_randomState * 1103515245u) + 12345u;
+	return ((s_randomState >> 16u) & 0x7fffu) % max;
+}
+
+static ImuiPos imuiCheckRandomPos()
+{
+	// integer positions hit the window borders quite often
+	return imuiPosCreate( (float)imuiCheckRandom( IMUI_CHECK_WIDTH + 1u ), (float)imuiCheckRandom( IMUI_CHECK_HEIGHT + 1u ) );
+}
+
+static void imuiCheckRandomWindow( ImuiCheckWindow* window )
+{
+	window->rect	= imuiRectCreate( (float)imuiCheckRandom( IMUI_CHECK_WIDTH - 40u ), (float)imuiCheckRandom( IMUI_CHECK_HEIGHT - 40u ), (float)(20u + imuiCheckRandom( 120u )), (float)(20u + imuiCheckRandom( 100u )) );
+	window->zOrder	= imuiCheckRandom( 4u );
+}
+
+static bool imuiCheckRectIncludesPos( ImuiRect rect, ImuiPos pos )
+{
+	return pos.x >= rect.pos.x && pos.y >= rect.pos.y && pos.x <= rect.pos.x + rect.size.width && pos.y <= rect.pos.y + rect.size.height;
+}
+
+// a window gets the input if no other window at the position has the same or a higher z-order
+static bool imuiCheckIsTopmostAt( const ImuiCheckWindow* windows, uint32_t windowIndex, ImuiPos pos )
+{
+	if( !imuiCheckRectIncludesPos( windows[ windowIndex ].rect, pos ) )
+	{
+		return false;
+	}
+
+	for( uint32_t i = 0u; i < IMUI_CHECK_WINDOW_COUNT; ++i )
+	{
+		if( i != windowIndex &&
+			windows[ i ].zOrder >= windows[ windowIndex ].zOrder &&
+			imuiCheckRectIncludesPos( windows[ i ].rect, pos ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main()
+{
+	ImuiParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+	parameters.inputEventCapacity = 64u;
+
+	ImuiContext* imui = imuiCreate( &parameters );
+	if( !imui )
+	{
+		fprintf( stderr, "Failed to create context.\n" );
+		return 1;
+	}
+
+	ImuiCheckWindow windows[ IMUI_CHECK_WINDOW_COUNT ];
+	for( uint32_t i = 0u; i < IMUI_CHECK_WINDOW_COUNT; ++i )
+	{
+		imuiCheckRandomWindow( &windows[ i ] );
+	}
+
+	size_t hoverCount = 0u;
+	size_t pressCount = 0u;
+
+	bool result = true;
+	const ImuiInputState* lastInput = NULL;
+	for( uint32_t frameIndex = 0u; frameIndex < IMUI_CHECK_FRAME_COUNT && result; ++frameIndex )
+	{
+		// widgets are placed by the layout of the last frame, so windows only move in every second frame
+		const bool isCheckFrame = frameIndex % 2u == 1u;
+		if( !isCheckFrame )
+		{
+			const uint32_t moveCount = 1u + imuiCheckRandom( 4u );
+			for( uint32_t i = 0u; i < moveCount; ++i )
+			{
+				imuiCheckRandomWindow( &windows[ imuiCheckRandom( IMUI_CHECK_WINDOW_COUNT ) ] );
+			}
+		}
+
+		ImuiCheckClick clicks[ IMUI_CHECK_CLICK_COUNT ];
+		const uint32_t clickCount = isCheckFrame ? imuiCheckRandom( IMUI_CHECK_CLICK_COUNT + 1u ) : 0u;
+		const ImuiPos mousePos = imuiCheckRandomPos();
+
+		ImuiInput* input = imuiInputBegin( imui, lastInput );
+		for( uint32_t i = 0u; i < clickCount; ++i )
+		{
+			clicks[ i ].downPos	= imuiCheckRandomPos();
+			clicks[ i ].upPos	= imuiCheckRandom( 2u ) == 0u ? clicks[ i ].downPos : imuiCheckRandomPos();
+
+			imuiInputPushMouseMove( input, clicks[ i ].downPos.x, clicks[ i ].downPos.y );
+			imuiInputPushMouseDown( input, ImuiInputMouseButton_Left );
+			imuiInputPushMouseMove( input, clicks[ i ].upPos.x, clicks[ i ].upPos.y );
+			imuiInputPushMouseUp( input, ImuiInputMouseButton_Left );
+		}
+		imuiInputPushMouseMove( input, mousePos.x, mousePos.y );
+		lastInput = imuiInputEnd( imui );
+
+		ImuiFrame* frame = imuiBegin( imui, frameIndex / 60.0 );
+		ImuiSurface* surface = imuiSurfaceBegin( frame, "surface", imuiSizeCreate( IMUI_CHECK_WIDTH, IMUI_CHECK_HEIGHT ), lastInput, 1.0f );
+		for( uint32_t i = 0u; i < IMUI_CHECK_WINDOW_COUNT && result; ++i )
+		{
+			char windowName[ 16u ];
+			snprintf( windowName, sizeof( windowName ), "window%u", i );
+
+			ImuiWindow* window = imuiWindowBegin( surface, windowName, windows[ i ].rect, windows[ i ].zOrder );
+
+			ImuiWidget* widget = imuiWidgetBegin( window );
+			imuiWidgetSetStretch( widget, 1.0f, 1.0f );
+
+			ImuiWidgetInputState inputState;
+			imuiWidgetGetInputState( widget, &inputState );
+			imuiWidgetEnd( widget );
+
+			imuiWindowEnd( window );
+
+			if( !isCheckFrame )
+			{
+				continue;
+			}
+
+			bool isMouseOver = imuiCheckIsTopmostAt( windows, i, mousePos );
+			bool hasPressed = false;
+			bool hasReleased = false;
+			for( uint32_t j = 0u; j < clickCount; ++j )
+			{
+				hasPressed	|= imuiCheckIsTopmostAt( windows, i, clicks[ j ].downPos );
+				hasReleased	|= imuiCheckIsTopmostAt( windows, i, clicks[ j ].upPos );
+			}
+
+			if( inputState.isMouseOver != isMouseOver ||
+				inputState.hasMousePressed != hasPressed ||
+				inputState.hasMouseReleased != hasReleased )
+			{
+				fprintf( stderr, "frame %u window %u: over %d pressed %d released %d but should be %d %d %d\n", frameIndex, i, inputState.isMouseOver, inputState.hasMousePressed, inputState.hasMouseReleased, isMouseOver, hasPressed, hasReleased );
+				result = false;
+			}
+
+			hoverCount += isMouseOver;
+			pressCount += hasPressed;
+		}
+		imuiSurfaceEnd( surface );
+		imuiEnd( frame );
+	}
+
+	imuiDestroy( imui );
+
+	// make sure the scene isn't degenerated
+	if( result && (hoverCount < IMUI_CHECK_FRAME_COUNT / 8u || pressCount < IMUI_CHECK_FRAME_COUNT / 8u) )
+	{
+		fprintf( stderr, "only %zu hovered and %zu pressed widgets\n", hoverCount, pressCount );
+		result = false;
+	}
+
+	if( result )
+	{
+		printf( "imui_check_hit_test: passed\n" );
+	}
+
+	return result ? 0 : 1;
+}
@@ -0,0 +1,491 @@
+#include "imui/imui.h"
+#include "imui/imui_raster.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Renders a small scene of rects, images, skins, lines and text with the software rasterizer and compares every pixel
+// with a reference computed here. The scene is rendered with and without indices. The last frame changes the scene
+// and is only redrawn inside the damage rects.
+
+#define IMUI_CHECK_WIDTH		96u
+#define IMUI_CHECK_HEIGHT		64u
+#define IMUI_CHECK_GLYPH_WIDTH	6.0f
+#define IMUI_CHECK_GLYPH_HEIGHT	10.0f
+
+typedef enum ImuiCheckItemType
+{
+	ImuiCheckItemType_Color,
+	ImuiCheckItemType_Image,
+	ImuiCheckItemType_Skin,
+	ImuiCheckItemType_Line,		// axis aligned from pos to pos + size
+	ImuiCheckItemType_Text		// "XXX" at pos
+} ImuiCheckItemType;
+
+typedef struct ImuiCheckItem
+{
+	ImuiCheckItemType			type;
+	ImuiRect					rect;
+	ImuiColor					color;
+	const ImuiRasterTexture*	texture;
+} ImuiCheckItem;
+
+typedef struct ImuiCheckRenderer
+{
+	const char*					name;
+	ImuiContext*				imui;
+	ImuiFont*					font;
+	bool						isIndexed;
+
+	void*						vertexData;
+	void*						indexData;
+
+	ImuiRasterTarget			target;			// fully drawn every frame
+	ImuiRasterTarget			redrawTarget;	// only damage rects are drawn after the first frame
+} ImuiCheckRenderer;
+
+static const uint8_t s_quadrantTexels[] =
+{
+	255u,   0u,   0u, 255u,		  0u, 255u,   0u, 255u,
+	  0u,   0u, 255u, 255u,		255u, 255u, 255u, 128u,
+};
+
+static const uint8_t s_coverageTexels[] =
+{
+	255u,   0u,
+	 64u, 192u,
+};
+
+static const uint8_t s_solidTexels[] = { 255u };
+
+static const ImuiRasterTexture s_quadrantTexture	= { s_quadrantTexels, 2u, 2u, ImuiRasterTextureFormat_RGBA8 };
+static const ImuiRasterTexture s_coverageTexture	= { s_coverageTexels, 2u, 2u, ImuiRasterTextureFormat_R8 };
+static const ImuiRasterTexture s_solidTexture		= { s_solidTexels, 1u, 1u, ImuiRasterTextureFormat_R8 };	// skins and glyphs
+
+static const ImuiColor s_clearColor = { 26u, 51u, 77u, 255u };
+
+static bool imuiCheckRendererCreate( ImuiCheckRenderer* renderer, const char* name, bool isIndexed )
+{
+	memset( renderer, 0, sizeof( *renderer ) );
+	renderer->name		= name;
+	renderer->isIndexed	= isIndexed;
+
+	ImuiParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+	parameters.vertexType	= isIndexed ? ImuiVertexType_IndexedVertexList : ImuiVertexType_VertexList;
+	parameters.trackChanges	= true;
+
+	renderer->imui = imuiCreate( &parameters );
+	if( !renderer->imui )
+	{
+		return false;
+	}
+
+	// one solid glyph, so text is a row of boxes
+	ImuiFontCodepoint codepoint;
+	memset( &codepoint, 0, sizeof( codepoint ) );
+	codepoint.codepoint	= 'X';
+	codepoint.width		= IMUI_CHECK_GLYPH_WIDTH;
+	codepoint.height	= IMUI_CHECK_GLYPH_HEIGHT;
+	codepoint.advance	= IMUI_CHECK_GLYPH_WIDTH + 2.0f;
+	codepoint.uv.u1		= 1.0f;
+	codepoint.uv.v1		= 1.0f;
+
+	ImuiFontParameters fontParameters;
+	memset( &fontParameters, 0, sizeof( fontParameters ) );
+	fontParameters.image.textureHandle	= (uint64_t)(uintptr_t)&s_solidTexture;
+	fontParameters.image.width			= s_solidTexture.width;
+	fontParameters.image.height			= s_solidTexture.height;
+	fontParameters.codepoints			= &codepoint;
+	fontParameters.codepointCount		= 1u;
+	fontParameters.fontSize				= IMUI_CHECK_GLYPH_HEIGHT;
+
+	renderer->font = imuiFontCreate( renderer->imui, &fontParameters );
+
+	const size_t pixelsSize = IMUI_CHECK_WIDTH * IMUI_CHECK_HEIGHT * 4u;
+	renderer->target.pixels	= (uint8_t*)malloc( pixelsSize );
+	renderer->target.width	= IMUI_CHECK_WIDTH;
+	renderer->target.height	= IMUI_CHECK_HEIGHT;
+	renderer->target.stride	= IMUI_CHECK_WIDTH * 4u;
+
+	renderer->redrawTarget			= renderer->target;
+	renderer->redrawTarget.pixels	= (uint8_t*)malloc( pixelsSize );
+
+	return renderer->font && renderer->target.pixels && renderer->redrawTarget.pixels;
+}
+
+static void imuiCheckRendererDestroy( ImuiCheckRenderer* renderer )
+{
+	free( renderer->vertexData );
+	free( renderer->indexData );
+	free( renderer->target.pixels );
+	free( renderer->redrawTarget.pixels );
+
+	if( renderer->imui )
+	{
+		if( renderer->font )
+		{
+			imuiFontDestroy( renderer->imui, renderer->font );
+		}
+
+		imuiDestroy( renderer->imui );
+	}
+}
+
+static void imuiCheckDrawScene( ImuiWindow* window, ImuiFont* font, const ImuiCheckItem* items, size_t itemCount )
+{
+	ImuiWidget* widget = imuiWidgetBegin( window );
+	imuiWidgetSetFixedSizeFloat( widget, (float)IMUI_CHECK_WIDTH, (float)IMUI_CHECK_HEIGHT );
+
+	for( size_t i = 0u; i < itemCount; ++i )
+	{
+		const ImuiCheckItem* item = &items[ i ];
+		switch( item->type )
+		{
+		case ImuiCheckItemType_Color:
+			imuiWidgetDrawPartialColor( widget, item->rect, item->color );
+			break;
+
+		case ImuiCheckItemType_Image:
+			{
+				ImuiImage image;
+				memset( &image, 0, sizeof( image ) );
+				image.textureHandle	= (uint64_t)(uintptr_t)item->texture;
+				image.width			= item->texture->width;
+				image.height		= item->texture->height;
+				image.uv.u1			= 1.0f;
+				image.uv.v1			= 1.0f;
+
+				imuiWidgetDrawPartialImageColor( widget, item->rect, &image, item->color );
+			}
+			break;
+
+		case ImuiCheckItemType_Skin:
+			{
+				// nine slices of a solid texture must cover the rect without gaps and overlaps
+				ImuiSkin skin;
+				memset( &skin, 0, sizeof( skin ) );
+				skin.textureHandle	= (uint64_t)(uintptr_t)&s_solidTexture;
+				skin.width			= 8u;
+				skin.height			= 8u;
+				skin.uv.u1			= 1.0f;
+				skin.uv.v1			= 1.0f;
+				skin.border			= imuiBorderCreateAll( 3.0f );
+
+				imuiWidgetDrawPartialSkin( widget, item->rect, &skin, item->color );
+			}
+			break;
+
+		case ImuiCheckItemType_Line:
+			imuiWidgetDrawLine( widget, item->rect.pos, imuiPosAdd( item->rect.pos, item->rect.size.width, item->rect.size.height ), item->color );
+			break;
+
+		case ImuiCheckItemType_Text:
+			imuiWidgetDrawPositionText( widget, item->rect.pos, imuiTextLayoutCreate( imuiWindowGetContext( window ), font, "XXX" ), item->color );
+			break;
+		}
+	}
+
+	imuiWidgetEnd( widget );
+}
+
+static uint8_t imuiCheckToByte( float value )
+{
+	return (uint8_t)floorf( (value * 255.0f) + 0.5f );
+}
+
+static void imuiCheckBlend( float* pixel, const float color[ 4u ] )
+{
+	const float alpha = color[ 3u ];
+	pixel[ 0u ] = (color[ 0u ] * alpha) + (pixel[ 0u ] * (1.0f - alpha));
+	pixel[ 1u ] = (color[ 1u ] * alpha) + (pixel[ 1u ] * (1.0f - alpha));
+	pixel[ 2u ] = (color[ 2u ] * alpha) + (pixel[ 2u ] * (1.0f - alpha));
+	pixel[ 3u ] = alpha + (pixel[ 3u ] * (1.0f - alpha));
+}
+
+static bool imuiCheckRectContains( ImuiRect rect, float x, float y )
+{
+	return x >= rect.pos.x && x < rect.pos.x + rect.size.width &&
+		y >= rect.pos.y && y < rect.pos.y + rect.size.height;
+}
+
+static bool imuiCheckItemContains( const ImuiCheckItem* item, float x, float y, ImuiRect* outRect )
+{
+	switch( item->type )
+	{
+	case ImuiCheckItemType_Color:
+	case ImuiCheckItemType_Image:
+	case ImuiCheckItemType_Skin:
+		*outRect = item->rect;
+		return imuiCheckRectContains( item->rect, x, y );
+
+	case ImuiCheckItemType_Line:
+		{
+			// one pixel wide, the last pixel is left out
+			ImuiRect rect = item->rect;
+			rect.size.width		= rect.size.width == 0.0f ? 1.0f : rect.size.width;
+			rect.size.height	= rect.size.height == 0.0f ? 1.0f : rect.size.height;
+			*outRect = rect;
+			return imuiCheckRectContains( rect, x, y );
+		}
+
+	case ImuiCheckItemType_Text:
+		for( size_t i = 0u; i < 3u; ++i )
+		{
+			const ImuiRect rect = imuiRectCreate( item->rect.pos.x + ((IMUI_CHECK_GLYPH_WIDTH + 2.0f) * (float)i), item->rect.pos.y, IMUI_CHECK_GLYPH_WIDTH, IMUI_CHECK_GLYPH_HEIGHT );
+			if( imuiCheckRectContains( rect, x, y ) )
+			{
+				*outRect = rect;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	return false;
+}
+
+static void imuiCheckRenderReference( uint8_t* pixels, const ImuiCheckItem* items, size_t itemCount )
+{
+	for( uint32_t y = 0u; y < IMUI_CHECK_HEIGHT; ++y )
+	{
+		for( uint32_t x = 0u; x < IMUI_CHECK_WIDTH; ++x )
+		{
+			float pixel[ 4u ] =
+			{
+				s_clearColor.red / 255.0f,
+				s_clearColor.green / 255.0f,
+				s_clearColor.blue / 255.0f,
+				s_clearColor.alpha / 255.0f
+			};
+
+			// pixels are covered if their center is inside, textures are point sampled
+			const float centerX = (float)x + 0.5f;
+			const float centerY = (float)y + 0.5f;
+			for( size_t i = 0u; i < itemCount; ++i )
+			{
+				const ImuiCheckItem* item = &items[ i ];
+
+				ImuiRect rect;
+				if( !imuiCheckItemContains( item, centerX, centerY, &rect ) )
+				{
+					continue;
+				}
+
+				float color[ 4u ] = { item->color.red / 255.0f, item->color.green / 255.0f, item->color.blue / 255.0f, item->color.alpha / 255.0f };
+				if( item->type == ImuiCheckItemType_Image )
+				{
+					const uint32_t texelX = (uint32_t)((centerX - rect.pos.x) / rect.size.width * (float)item->texture->width);
+					const uint32_t texelY = (uint32_t)((centerY - rect.pos.y) / rect.size.height * (float)item->texture->height);
+					const uint32_t texelIndex = (texelY * item->texture->width) + texelX;
+					if( item->texture->format == ImuiRasterTextureFormat_R8 )
+					{
+						color[ 3u ] *= item->texture->data[ texelIndex ] / 255.0f;
+					}
+					else
+					{
+						for( size_t j = 0u; j < 4u; ++j )
+						{
+							color[ j ] *= item->texture->data[ (texelIndex * 4u) + j ] / 255.0f;
+						}
+					}
+				}
+
+				imuiCheckBlend( pixel, color );
+			}
+
+			uint8_t* target = pixels + (((y * IMUI_CHECK_WIDTH) + x) * 4u);
+			for( size_t j = 0u; j < 4u; ++j )
+			{
+				target[ j ] = imuiCheckToByte( pixel[ j ] );
+			}
+		}
+	}
+}
+
+static bool imuiCheckCompare( const char* name, size_t frameIndex, const char* what, const uint8_t* pixels, const uint8_t* expected, int tolerance )
+{
+	for( uint32_t y = 0u; y < IMUI_CHECK_HEIGHT; ++y )
+	{
+		for( uint32_t x = 0u; x < IMUI_CHECK_WIDTH; ++x )
+		{
+			const size_t index = ((y * IMUI_CHECK_WIDTH) + x) * 4u;
+			for( size_t j = 0u; j < 4u; ++j )
+			{
+				if( abs( (int)pixels[ index + j ] - (int)expected[ index + j ] ) <= tolerance )
+				{
+					continue;
+				}
+
+				const uint8_t* pixel = &pixels[ index ];
+				const uint8_t* expectedPixel = &expected[ index ];
+				fprintf( stderr, "%s frame %zu %s: pixel %u,%u is %u,%u,%u,%u but should be %u,%u,%u,%u\n", name, frameIndex, what, x, y, pixel[ 0u ], pixel[ 1u ], pixel[ 2u ], pixel[ 3u ], expectedPixel[ 0u ], expectedPixel[ 1u ], expectedPixel[ 2u ], expectedPixel[ 3u ] );
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void imuiCheckClearRect( const ImuiRasterTarget* target, ImuiRect rect )
+{
+	for( uint32_t y = 0u; y < target->height; ++y )
+	{
+		for( uint32_t x = 0u; x < target->width; ++x )
+		{
+			if( imuiCheckRectContains( rect, (float)x + 0.5f, (float)y + 0.5f ) )
+			{
+				uint8_t* pixel = target->pixels + (y * target->stride) + (x * 4u);
+				pixel[ 0u ] = s_clearColor.red;
+				pixel[ 1u ] = s_clearColor.green;
+				pixel[ 2u ] = s_clearColor.blue;
+				pixel[ 3u ] = s_clearColor.alpha;
+			}
+		}
+	}
+}
+
+static bool imuiCheckRenderFrame( ImuiCheckRenderer* renderer, size_t frameIndex, const ImuiCheckItem* items, size_t itemCount, bool isChanged )
+{
+	imuiInputBegin( renderer->imui, NULL );
+	const ImuiInputState* input = imuiInputEnd( renderer->imui );
+
+	ImuiFrame* frame = imuiBegin( renderer->imui, (double)frameIndex / 60.0 );
+	ImuiSurface* surface = imuiSurfaceBegin( frame, "check", imuiSizeCreate( (float)IMUI_CHECK_WIDTH, (float)IMUI_CHECK_HEIGHT ), input, 1.0f );
+	ImuiWindow* window = imuiWindowBegin( surface, "check", imuiRectCreate( 0.0f, 0.0f, (float)IMUI_CHECK_WIDTH, (float)IMUI_CHECK_HEIGHT ), 0u );
+	imuiCheckDrawScene( window, renderer->font, items, itemCount );
+	imuiWindowEnd( window );
+	imuiSurfaceEnd( surface );
+
+	const bool isDirty = imuiSurfaceIsDirty( surface );
+
+	size_t vertexDataSize;
+	size_t indexDataSize;
+	imuiSurfaceGetMaxBufferSizes( surface, &vertexDataSize, &indexDataSize );
+	free( renderer->vertexData );
+	free( renderer->indexData );
+	renderer->vertexData	= malloc( vertexDataSize + 1u );
+	renderer->indexData		= malloc( indexDataSize + 1u );
+
+	const ImuiDrawData* drawData = imuiSurfaceGenerateDrawData( surface, renderer->vertexData, &vertexDataSize, renderer->indexData, &indexDataSize );
+	const uint32_t* indexData = renderer->isIndexed ? (const uint32_t*)renderer->indexData : NULL;
+
+	imuiRasterClear( &renderer->target, s_clearColor );
+	imuiRasterDraw( &renderer->target, drawData, renderer->vertexData, indexData, NULL );
+
+	bool result = true;
+	if( frameIndex == 0u )
+	{
+		imuiRasterClear( &renderer->redrawTarget, s_clearColor );
+		imuiRasterDraw( &renderer->redrawTarget, drawData, renderer->vertexData, indexData, NULL );
+	}
+	else
+	{
+		// a renderer which keeps its last image only clears and redraws the damaged areas
+		float damageArea = 0.0f;
+		for( size_t i = 0u; i < drawData->damageRectCount; ++i )
+		{
+			const ImuiRect* damageRect = &drawData->damageRects[ i ];
+			damageArea += damageRect->size.width * damageRect->size.height;
+
+			imuiCheckClearRect( &renderer->redrawTarget, *damageRect );
+			imuiRasterDraw( &renderer->redrawTarget, drawData, renderer->vertexData, indexData, damageRect );
+		}
+
+		if( !isChanged && (isDirty || drawData->damageRectCount != 0u) )
+		{
+			fprintf( stderr, "%s frame %zu: the unchanged scene is dirty\n", renderer->name, frameIndex );
+			result = false;
+		}
+		else if( isChanged && (!isDirty || damageArea <= 0.0f || damageArea >= (float)(IMUI_CHECK_WIDTH * IMUI_CHECK_HEIGHT)) )
+		{
+			fprintf( stderr, "%s frame %zu: the damage rects don't cover only the changed part\n", renderer->name, frameIndex );
+			result = false;
+		}
+	}
+
+	imuiEnd( frame );
+	return result;
+}
+
+int main()
+{
+	// opaque and translucent overlapping rects, an RGBA8 and an R8 texture, a skin, lines, text and an edge outside of the surface
+	static const ImuiCheckItem s_firstScene[] =
+	{
+		{ ImuiCheckItemType_Color,	{ {  4.0f,  4.0f }, { 20.0f, 16.0f } }, { 255u, 0u, 0u, 255u },		NULL },
+		{ ImuiCheckItemType_Color,	{ { 14.0f, 10.0f }, { 16.0f, 20.0f } }, { 0u, 0u, 255u, 128u },		NULL },
+		{ ImuiCheckItemType_Image,	{ { 36.0f,  4.0f }, {  8.0f,  8.0f } }, { 255u, 255u, 255u, 255u },	&s_quadrantTexture },
+		{ ImuiCheckItemType_Image,	{ { 36.0f, 20.0f }, { 12.0f, 12.0f } }, { 255u, 255u, 0u, 255u },	&s_coverageTexture },
+		{ ImuiCheckItemType_Color,	{ { 88.0f, 56.0f }, { 16.0f, 16.0f } }, { 0u, 255u, 0u, 191u },		NULL },
+		{ ImuiCheckItemType_Skin,	{ { 52.0f,  4.0f }, { 20.0f, 12.0f } }, { 255u, 128u, 0u, 160u },	NULL },
+		{ ImuiCheckItemType_Text,	{ { 52.0f, 24.0f }, {  0.0f,  0.0f } }, { 255u, 0u, 255u, 255u },	NULL },
+		{ ImuiCheckItemType_Line,	{ {  4.0f, 50.0f }, { 36.0f,  0.0f } }, { 255u, 255u, 255u, 255u },	NULL },
+		{ ImuiCheckItemType_Line,	{ { 80.0f,  4.0f }, {  0.0f, 26.0f } }, { 0u, 255u, 255u, 200u },	NULL },
+	};
+
+	// colors change and some items move, the damage rects must cover all of them
+	static const ImuiCheckItem s_secondScene[] =
+	{
+		{ ImuiCheckItemType_Color,	{ {  4.0f,  4.0f }, { 20.0f, 16.0f } }, { 255u, 0u, 0u, 255u },		NULL },
+		{ ImuiCheckItemType_Color,	{ { 14.0f, 10.0f }, { 16.0f, 20.0f } }, { 0u, 255u, 255u, 64u },	NULL },
+		{ ImuiCheckItemType_Image,	{ { 36.0f,  4.0f }, {  8.0f,  8.0f } }, { 255u, 255u, 255u, 255u },	&s_quadrantTexture },
+		{ ImuiCheckItemType_Image,	{ { 36.0f, 20.0f }, { 12.0f, 12.0f } }, { 255u, 255u, 0u, 255u },	&s_coverageTexture },
+		{ ImuiCheckItemType_Color,	{ {  2.0f, 36.0f }, { 16.0f,  8.0f } }, { 0u, 255u, 0u, 191u },		NULL },
+		{ ImuiCheckItemType_Skin,	{ { 52.0f,  4.0f }, { 20.0f, 12.0f } }, { 255u, 128u, 0u, 160u },	NULL },
+		{ ImuiCheckItemType_Text,	{ { 52.0f, 24.0f }, {  0.0f,  0.0f } }, { 0u, 255u, 0u, 255u },		NULL },
+		{ ImuiCheckItemType_Line,	{ {  4.0f, 56.0f }, { 36.0f,  0.0f } }, { 255u, 255u, 255u, 255u },	NULL },
+		{ ImuiCheckItemType_Line,	{ { 80.0f,  4.0f }, {  0.0f, 26.0f } }, { 0u, 255u, 255u, 200u },	NULL },
+	};
+
+	// the unchanged frame must not be dirty, the last frame gets damage rects for the changes only
+	static const ImuiCheckItem* s_scenes[] = { s_firstScene, s_firstScene, s_secondScene };
+	const size_t itemCount = sizeof( s_firstScene ) / sizeof( *s_firstScene );
+
+	ImuiCheckRenderer renderers[ 2u ];
+	const bool created = imuiCheckRendererCreate( &renderers[ 0u ], "vertex list", false );
+	if( !imuiCheckRendererCreate( &renderers[ 1u ], "indexed vertex list", true ) || !created )
+	{
+		fprintf( stderr, "Failed to create renderers.\n" );
+		imuiCheckRendererDestroy( &renderers[ 0u ] );
+		imuiCheckRendererDestroy( &renderers[ 1u ] );
+		return 1;
+	}
+
+	uint8_t* expected = (uint8_t*)malloc( IMUI_CHECK_WIDTH * IMUI_CHECK_HEIGHT * 4u );
+
+	bool result = expected != NULL;
+	for( size_t frameIndex = 0u; frameIndex < sizeof( s_scenes ) / sizeof( *s_scenes ) && result; ++frameIndex )
+	{
+		const ImuiCheckItem* items = s_scenes[ frameIndex ];
+		const bool isChanged = frameIndex > 0u && items != s_scenes[ frameIndex - 1u ];
+		imuiCheckRenderReference( expected, items, itemCount );
+
+		for( size_t i = 0u; i < sizeof( renderers ) / sizeof( *renderers ) && result; ++i )
+		{
+			ImuiCheckRenderer* renderer = &renderers[ i ];
+			result = imuiCheckRenderFrame( renderer, frameIndex, items, itemCount, isChanged );
+
+			// rounding of the rasterizer and the reference can differ by one
+			result = result && imuiCheckCompare( renderer->name, frameIndex, "full", renderer->target.pixels, expected, 1 );
+			result = result && imuiCheckCompare( renderer->name, frameIndex, "damage redraw", renderer->redrawTarget.pixels, renderer->target.pixels, 0 );
+		}
+
+		// both vertex types must produce the same image
+		result = result && imuiCheckCompare( renderers[ 1u ].name, frameIndex, "indexed", renderers[ 1u ].target.pixels, renderers[ 0u ].target.pixels, 0 );
+	}
+
+	free( expected );
+	imuiCheckRendererDestroy( &renderers[ 0u ] );
+	imuiCheckRendererDestroy( &renderers[ 1u ] );
+
+	if( result )
+	{
+		printf( "imui_check_raster: passed\n" );
+	}
+
+	return result ? 0 : 1;
+}
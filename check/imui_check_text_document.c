@@ -0,0 +1,256 @@
+#include "imui/imui.h"
+#include "imui/imui_toolbox.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Applies random inserts, removes, undos and redos to a text document and to a plain string model and compares text,
+// sub ranges and line offsets after every step. The model merges typing like the document does, so undo steps match.
+
+#define IMUI_CHECK_STEP_COUNT		20000u
+#define IMUI_CHECK_RESET_INTERVAL	2000u
+#define IMUI_CHECK_MAX_LENGTH		512u
+
+typedef struct ImuiCheckText
+{
+	char					data[ IMUI_CHECK_MAX_LENGTH + 8u ];
+	size_t					length;
+} ImuiCheckText;
+
+typedef struct ImuiCheckModel
+{
+	ImuiCheckText			text;
+
+	ImuiCheckText*			undoTexts;		// text before every undo step
+	size_t					undoCount;
+	ImuiCheckText*			redoTexts;
+	size_t					redoCount;
+
+	bool					canMerge;
+	bool					lastIsInsert;
+	size_t					lastOffset;
+	size_t					lastLength;
+} ImuiCheckModel;
+
+static uint32_t s_randomState = 12345u;
+
+static uint32_t imuiCheckRandom( uint32_t max )
+{
+	s_randomState = (s_randomState * 1103515245u) + 12345u;
+	return ((s_randomState >> 16u) & 0x7fffu) % max;
+}
+
+static void imuiCheckModelPushUndo( ImuiCheckModel* model, bool isInsert, size_t offset, const char* text, size_t length )
+{
+	// same rule as the document: single characters typed or deleted next to the last edit join it
+	const bool canMerge = model->canMerge && model->lastIsInsert == isInsert && length <= 4u && !memchr( text, '\n', length );
+	if( canMerge && isInsert && model->lastOffset + model->lastLength == offset )
+	{
+		model->lastLength += length;
+	}
+	else if( canMerge && !isInsert && model->lastOffset == offset )
+	{
+		model->lastLength += length;
+	}
+	else if( canMerge && !isInsert && offset + length == model->lastOffset )
+	{
+		model->lastOffset = offset;
+		model->lastLength += length;
+	}
+	else
+	{
+		model->undoTexts[ model->undoCount++ ] = model->text;
+		model->lastIsInsert	= isInsert;
+		model->lastOffset	= offset;
+		model->lastLength	= length;
+	}
+
+	model->redoCount	= 0u;
+	model->canMerge		= true;
+}
+
+static bool imuiCheckCompare( ImuiToolboxTextDocument* document, const ImuiCheckModel* model, size_t step, const char* operation )
+{
+	const ImuiCheckText* text = &model->text;
+	const size_t length = imuiToolboxTextDocumentGetLength( document );
+	if( length != text->length )
+	{
+		fprintf( stderr, "step %zu %s: length is %zu but should be %zu\n", step, operation, length, text->length );
+		return false;
+	}
+
+	if( length > 0u && memcmp( imuiToolboxTextDocumentGetText( document, 0u, length ), text->data, length ) != 0 )
+	{
+		fprintf( stderr, "step %zu %s: text differs\n", step, operation );
+		return false;
+	}
+
+	if( length > 0u )
+	{
+		const size_t offset = imuiCheckRandom( (uint32_t)length );
+		const size_t rangeLength = 1u + imuiCheckRandom( (uint32_t)(length - offset) );
+		if( memcmp( imuiToolboxTextDocumentGetText( document, offset, rangeLength ), text->data + offset, rangeLength ) != 0 )
+		{
+			fprintf( stderr, "step %zu %s: text of %zu..%zu differs\n", step, operation, offset, offset + rangeLength );
+			return false;
+		}
+	}
+
+	size_t lineCount = 1u;
+	for( size_t i = 0u; i < text->length; ++i )
+	{
+		if( text->data[ i ] != '\n' )
+		{
+			continue;
+		}
+
+		const size_t lineOffset = imuiToolboxTextDocumentGetLineOffset( document, lineCount );
+		if( lineOffset != i + 1u )
+		{
+			fprintf( stderr, "step %zu %s: line %zu starts at %zu but should start at %zu\n", step, operation, lineCount, lineOffset, i + 1u );
+			return false;
+		}
+
+		lineCount++;
+	}
+
+	if( imuiToolboxTextDocumentGetLineCount( document ) != lineCount )
+	{
+		fprintf( stderr, "step %zu %s: %zu lines but should be %zu\n", step, operation, imuiToolboxTextDocumentGetLineCount( document ), lineCount );
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	ImuiParameters parameters;
+	memset( &parameters, 0, sizeof( parameters ) );
+
+	ImuiContext* imui = imuiCreate( &parameters );
+	if( !imui )
+	{
+		fprintf( stderr, "Failed to create context.\n" );
+		return 1;
+	}
+
+	ImuiCheckModel model;
+	memset( &model, 0, sizeof( model ) );
+	model.undoTexts = (ImuiCheckText*)malloc( sizeof( ImuiCheckText ) * IMUI_CHECK_RESET_INTERVAL );
+	model.redoTexts = (ImuiCheckText*)malloc( sizeof( ImuiCheckText ) * IMUI_CHECK_RESET_INTERVAL );
+
+	ImuiToolboxTextDocument* document = imuiToolboxTextDocumentCreate( imui );
+	bool result = document && model.undoTexts && model.redoTexts;
+	for( size_t step = 0u; step < IMUI_CHECK_STEP_COUNT && result; ++step )
+	{
+		ImuiCheckText* text = &model.text;
+		const char* operation;
+
+		const uint32_t choice = imuiCheckRandom( 100u );
+		if( step % IMUI_CHECK_RESET_INTERVAL == 0u )
+		{
+			// also clears the history, which keeps the model small
+			operation = "set";
+			text->length = imuiCheckRandom( 64u );
+			for( size_t i = 0u; i < text->length; ++i )
+			{
+				text->data[ i ] = imuiCheckRandom( 6u ) == 0u ? '\n' : (char)('a' + imuiCheckRandom( 26u ));
+			}
+
+			imuiToolboxTextDocumentSet( document, text->data, text->length );
+			model.undoCount	= 0u;
+			model.redoCount	= 0u;
+			model.canMerge	= false;
+		}
+		else if( choice < 45u && text->length < IMUI_CHECK_MAX_LENGTH )
+		{
+			// mostly single characters next to the last edit, so typing gets merged
+			operation = "insert";
+			char insertText[ 8u ];
+			const size_t insertLength = imuiCheckRandom( 3u ) == 0u ? 1u + imuiCheckRandom( 8u ) : 1u;
+			for( size_t i = 0u; i < insertLength; ++i )
+			{
+				insertText[ i ] = imuiCheckRandom( 8u ) == 0u ? '\n' : (char)('a' + imuiCheckRandom( 26u ));
+			}
+
+			size_t offset = imuiCheckRandom( (uint32_t)text->length + 1u );
+			if( model.canMerge && model.lastIsInsert && imuiCheckRandom( 2u ) == 0u )
+			{
+				offset = model.lastOffset + model.lastLength;
+			}
+
+			imuiToolboxTextDocumentInsert( document, offset, insertText, insertLength );
+			imuiCheckModelPushUndo( &model, true, offset, insertText, insertLength );
+
+			memmove( text->data + offset + insertLength, text->data + offset, text->length - offset );
+			memcpy( text->data + offset, insertText, insertLength );
+			text->length += insertLength;
+		}
+		else if( choice < 75u && text->length > 0u )
+		{
+			operation = "remove";
+			size_t offset = imuiCheckRandom( (uint32_t)text->length );
+			if( model.canMerge && !model.lastIsInsert && model.lastOffset > 0u && imuiCheckRandom( 2u ) == 0u )
+			{
+				offset = model.lastOffset - 1u;	// backspace
+			}
+
+			size_t removeLength = imuiCheckRandom( 3u ) == 0u ? 1u + imuiCheckRandom( 8u ) : 1u;
+			removeLength = removeLength < text->length - offset ? removeLength : text->length - offset;
+
+			imuiToolboxTextDocumentRemove( document, offset, removeLength );
+			imuiCheckModelPushUndo( &model, false, offset, text->data + offset, removeLength );
+
+			memmove( text->data + offset, text->data + offset + removeLength, text->length - offset - removeLength );
+			text->length -= removeLength;
+		}
+		else if( choice < 90u )
+		{
+			operation = "undo";
+			const bool undone = imuiToolboxTextDocumentUndo( document );
+			if( undone != (model.undoCount > 0u) )
+			{
+				fprintf( stderr, "step %zu: undo returned %d with %zu undo steps\n", step, undone, model.undoCount );
+				result = false;
+			}
+			else if( undone )
+			{
+				model.redoTexts[ model.redoCount++ ] = *text;
+				*text = model.undoTexts[ --model.undoCount ];
+				model.canMerge = false;
+			}
+		}
+		else
+		{
+			operation = "redo";
+			const bool redone = imuiToolboxTextDocumentRedo( document );
+			if( redone != (model.redoCount > 0u) )
+			{
+				fprintf( stderr, "step %zu: redo returned %d with %zu redo steps\n", step, redone, model.redoCount );
+				result = false;
+			}
+			else if( redone )
+			{
+				model.undoTexts[ model.undoCount++ ] = *text;
+				*text = model.redoTexts[ --model.redoCount ];
+				model.canMerge = false;	// an undo or redo without effect keeps merging
+			}
+		}
+
+		result = result && imuiCheckCompare( document, &model, step, operation );
+	}
+
+	imuiToolboxTextDocumentFree( document );
+	free( model.undoTexts );
+	free( model.redoTexts );
+	imuiDestroy( imui );
+
+	if( result )
+	{
+		printf( "imui_check_text_document: passed\n" );
+	}
+
+	return result ? 0 : 1;
+}
@@ -41,6 +41,9 @@ typedef struct ImuiAllocator
 } ImuiAllocator;
 
 typedef void(*ImuiStateDestructFunc)(void* state);
+typedef double(*ImuiClockFunc)(void* userData);		// high resolution time in seconds
+typedef void(*ImuiZoneBeginFunc)(const char* name, const char* detail, size_t detailLength, void* userData);	// name is a static string, detail can be NULL
+typedef void(*ImuiZoneEndFunc)(void* userData);
 
 // needed?
 //typedef bool(*ImuiWindowEvalFocusFunc)(imuiWindow* window, imuiWidget* widget, void* userData);
@@ -94,6 +97,30 @@ typedef enum ImuiVertexType
 	ImuiVertexType_IndexedVertexList
 } ImuiVertexType;
 
+typedef enum ImuiMemoryTag
+{
+	ImuiMemoryTag_General,				// context, surfaces, windows and toolbox data
+	ImuiMemoryTag_Widgets,
+	ImuiMemoryTag_States,
+	ImuiMemoryTag_TextLayouts,
+	ImuiMemoryTag_Draw,					// draw elements, commands and damage tracking
+	ImuiMemoryTag_Fonts,
+	ImuiMemoryTag_Input,
+	ImuiMemoryTag_Strings,				// string pool and frame strings
+
+	ImuiMemoryTag_MAX
+} ImuiMemoryTag;
+
+typedef struct ImuiMemoryTagStats		// all zero when compiled with IMUI_NO_STATS
+{
+	size_t							allocationCount;		// live allocations
+	size_t							size;					// live bytes
+	size_t							peakSize;
+	size_t							budget;
+} ImuiMemoryTagStats;
+
+typedef void(*ImuiMemoryReportFunc)(ImuiMemoryTag tag, const ImuiMemoryTagStats* stats, void* userData);
+
 typedef struct ImuiParameters					// Fill with zero for default parameters
 {
 	ImuiAllocator					allocator;			// Override memory Allocator. Default use malloc/free
@@ -101,8 +128,48 @@ typedef struct ImuiParameters					// Fill with zero for default parameters
 	size_t							shortcutCount;
 	ImuiVertexFormat				vertexFormat;		// Override vertex format. Default: float2 pos screen-space, float2 uv, float4 color
 	ImuiVertexType					vertexType;			// Override vertex type, Default: ImuiVertexType_VertexList
+	bool							trackChanges;		// Compare surfaces with the last frame for imuiIsIdle, imuiSurfaceIsDirty and imuiSurfaceGetDamageRects. Default: false (every surface is dirty)
+	size_t							textLayoutCacheBudget;	// Memory budget for cached text layouts in bytes, memory of evicted layouts is given back. Default: 1 MiB
+	uint32_t						textLayoutCacheMaxAge;	// Frames until an unused text layout gets evicted. Default: 600
+	size_t							inputEventCapacity;		// Input events kept per input state in push order. Default: 0 (only snapshots)
+	ImuiClockFunc					clockFunc;				// Clock for phase timings in ImuiFrameStats. Default: NULL (no timings)
+	void*							clockUserData;
+	ImuiZoneBeginFunc				zoneBeginFunc;			// Profiler zones around layout, draw data generation, text layout creation and font baking. Default: NULL
+	ImuiZoneEndFunc					zoneEndFunc;
+	void*							zoneUserData;
+	size_t							memoryBudgets[ ImuiMemoryTag_MAX ];	// Live bytes per tag before memoryBudgetFunc gets called. Default: 0 (no budget)
+	ImuiMemoryReportFunc			memoryBudgetFunc;		// Called when a tag grows over its budget
+	ImuiMemoryReportFunc			memoryLeakFunc;			// Called by imuiDestroy for every tag with memory left, e.g. fonts which were not destroyed
+	void*							memoryUserData;
 } ImuiParameters;
 
+typedef enum ImuiFramePhase
+{
+	ImuiFramePhase_Frame,				// imuiBegin to imuiEnd
+	ImuiFramePhase_Layout,				// imuiWindowEnd
+	ImuiFramePhase_TextLayout,			// creation of new text layouts, overlaps the other phases
+	ImuiFramePhase_DrawData,			// imuiSurfaceGenerateDrawData
+
+	ImuiFramePhase_MAX
+} ImuiFramePhase;
+
+typedef struct ImuiFrameStats			// all zero when compiled with IMUI_NO_STATS
+{
+	size_t							widgetCount;
+	size_t							stateAllocationCount;
+	size_t							stateReuseCount;		// states taken over from the last frame
+	size_t							textLayoutCreateCount;
+	size_t							textLayoutReuseCount;
+	size_t							drawElementCount;
+	size_t							drawCommandCount;
+	size_t							vertexCount;
+	size_t							indexCount;
+	size_t							allocationCount;		// calls to the allocator including realloc
+	size_t							allocationSize;			// in bytes
+	size_t							freeCount;
+	double							phaseTimes[ ImuiFramePhase_MAX ];	// in seconds, only with ImuiParameters::clockFunc
+} ImuiFrameStats;
+
 ImuiContext*				imuiCreate( const ImuiParameters* parameters );
 void						imuiDestroy( ImuiContext* imui );
 
@@ -111,6 +178,24 @@ void						imuiEnd( ImuiFrame* frame );
 
 ImuiContext*				imuiFrameGetContext( const ImuiFrame* frame );
 
+// earliest time requested by animating widgets in the last frame. returns false if nothing animates and the host can sleep until the next input.
+bool						imuiGetNextUpdateTime( const ImuiContext* imui, double* outTimeInSeconds );
+// true if the last frame changed no surface, consumed no new input and no update is due at the given time. the host can skip the next frame until new input arrives.
+// always false without ImuiParameters::trackChanges because surfaces are not compared.
+bool						imuiIsIdle( const ImuiContext* imui, double timeInSeconds );
+// counters of the last finished frame. everything after the previous imuiEnd counts towards the frame, including draw data generation.
+void						imuiGetFrameStats( const ImuiContext* imui, ImuiFrameStats* stats );
+
+// records zones without callbacks and writes them in the Chrome trace event format(chrome://tracing, Perfetto). uses
+// ImuiParameters::clockFunc or the system clock. zones over maxEventCount are dropped. not available with IMUI_NO_STATS.
+bool						imuiTraceBegin( ImuiContext* imui, size_t maxEventCount );
+void						imuiTraceEnd( ImuiContext* imui );
+// returns the length of the json without terminator like snprintf. call with a NULL buffer to get the required size.
+size_t						imuiTraceWrite( const ImuiContext* imui, char* buffer, size_t bufferSize );
+
+void						imuiGetMemoryStats( const ImuiContext* imui, ImuiMemoryTag tag, ImuiMemoryTagStats* stats );
+const char*					imuiMemoryTagGetName( ImuiMemoryTag tag );
+
 //////////////////////////////////////////////////////////////////////////
 // Types
 
@@ -175,6 +260,14 @@ typedef struct ImuiSkin
 	ImuiBorder				border;
 } ImuiSkin;
 
+typedef struct ImuiSkinDescriptor
+{
+	uint64_t				textureHandle;
+	ImuiBorder				border;
+	ImuiTexCoord			uv;
+	ImuiTexCoord			centerUv;	// inner corners of the nine slices
+} ImuiSkinDescriptor;
+
 typedef enum ImuiLayout
 {
 	ImuiLayout_Stack,
@@ -205,6 +298,8 @@ typedef struct ImuiDrawData
 {
 	const ImuiDrawCommand*	commands;
 	size_t					commandCount;
+	const ImuiRect*			damageRects;		// areas which changed since the last frame
+	size_t					damageRectCount;
 } ImuiDrawData;
 
 //////////////////////////////////////////////////////////////////////////
@@ -223,6 +318,8 @@ const ImuiInputState*		imuiSurfaceGetInput( const ImuiSurface* surface );
 float						imuiSurfaceGetDpiScale( const ImuiSurface* surface );
 
 // call after surface end but before end frame
+bool						imuiSurfaceIsDirty( const ImuiSurface* surface );	// false if the draw data would be the same as in the last frame, needs ImuiParameters::trackChanges
+const ImuiRect*				imuiSurfaceGetDamageRects( const ImuiSurface* surface, size_t* outCount );	// areas which changed since the last frame, empty if not dirty
 void						imuiSurfaceGetMaxBufferSizes( ImuiSurface* surface, size_t* outVertexDataSize, size_t* outIndexDataSize );
 const ImuiDrawData*			imuiSurfaceGenerateDrawData( ImuiSurface* surface, void* outVertexData, size_t* inOutVertexDataSize, void* outIndexData, size_t* inOutIndexDataSize );
 
@@ -239,6 +336,7 @@ ImuiSurface*				imuiWindowGetSurface( const ImuiWindow* window );
 const ImuiInputState*		imuiWindowGetInput( const ImuiWindow* window );
 
 double						imuiWindowGetTime( const ImuiWindow* window );
+void						imuiWindowRequestUpdate( ImuiWindow* window, double timeInSeconds );	// request a new frame not later than the given time
 float						imuiWindowGetDpiScale( const ImuiWindow* window );
 ImuiRect					imuiWindowGetRect( const ImuiWindow* window );
 
@@ -291,6 +389,7 @@ ImuiWidget*					imuiWidgetGetPrevSibling( const ImuiWidget* widget );
 ImuiWidget*					imuiWidgetGetNextSibling( const ImuiWidget* widget );
 
 double						imuiWidgetGetTime( const ImuiWidget* widget );
+void						imuiWidgetRequestUpdate( ImuiWidget* widget, double timeInSeconds );	// request a new frame not later than the given time
 float						imuiWidgetGetDpiScale( const ImuiWidget* widget );
 
 void*						imuiWidgetAllocState( ImuiWidget* widget, size_t size, ImuiId stateId );
@@ -368,6 +467,8 @@ void						imuiWidgetDrawPartialColor( ImuiWidget* widget, ImuiRect relativRect,
 void						imuiWidgetDrawPartialImage( ImuiWidget* widget, ImuiRect relativRect, const ImuiImage* image );
 void						imuiWidgetDrawPartialImageColor( ImuiWidget* widget, ImuiRect relativRect, const ImuiImage* image, ImuiColor color );
 void						imuiWidgetDrawPartialSkin( ImuiWidget* widget, ImuiRect relativRect, const ImuiSkin* skin, ImuiColor color );
+void						imuiWidgetDrawSkinDescriptor( ImuiWidget* widget, const ImuiSkinDescriptor* skin, ImuiColor color );
+void						imuiWidgetDrawPartialSkinDescriptor( ImuiWidget* widget, ImuiRect relativRect, const ImuiSkinDescriptor* skin, ImuiColor color );
 void						imuiWidgetDrawPositionText( ImuiWidget* widget, ImuiPos offset, ImuiTextLayout* layout, ImuiColor color );
 void						imuiWidgetDrawPositionTextSize( ImuiWidget* widget, ImuiPos offset, ImuiTextLayout* layout, ImuiColor color, float size );
 void						imuiWidgetDrawLine( ImuiWidget* widget, ImuiPos p0, ImuiPos p1, ImuiColor color );
@@ -574,6 +675,31 @@ struct ImuiInputShortcutConfig
 	ImuiInputKey				key;
 };
 
+typedef enum ImuiInputEventType
+{
+	ImuiInputEventType_KeyDown,
+	ImuiInputEventType_KeyUp,
+	ImuiInputEventType_KeyRepeat,
+	ImuiInputEventType_Text,
+	ImuiInputEventType_MouseDown,
+	ImuiInputEventType_MouseUp,
+	ImuiInputEventType_MouseDoubleClick,
+	ImuiInputEventType_MouseMove,
+	ImuiInputEventType_MouseScroll
+} ImuiInputEventType;
+
+typedef struct ImuiInputEvent
+{
+	double						time;		// set with imuiInputPushTime
+	ImuiInputEventType			type;
+	uint32_t					code;		// ImuiInputKey, ImuiInputMouseButton or byte offset into imuiInputGetText for text events
+	union ImuiInputEventData
+	{
+		ImuiPos					pos;		// mouse position, scroll delta for scroll events
+		size_t					textLength;
+	}							data;
+} ImuiInputEvent;
+
 // Get/Set
 
 ImuiInputMouseCursor			imuiInputGetMouseCursor( const ImuiContext* imui );
@@ -611,6 +737,8 @@ void							imuiInputPushMouseScrollDelta( ImuiInput* input, float horizontalDelt
 void							imuiInputPushDirection( ImuiInput* input, float x, float y );
 void							imuiInputPushFocusExecute( ImuiInput* input );
 
+void							imuiInputPushTime( ImuiInput* input, double timeInSeconds );	// timestamp of the following events
+
 // Read
 
 uint32_t						imuiInputGetKeyModifiers( const ImuiInputState* input );	// returns imuiInputModifier
@@ -634,6 +762,11 @@ ImuiPos							imuiInputGetMouseScrollDelta( const ImuiInputState* input );
 ImuiPos							imuiInputGetDirection( const ImuiInputState* input );
 bool							imuiInputGetFocusExecute( const ImuiInputState* input );
 
+// Events are only recorded if ImuiParameters::inputEventCapacity is set. In this mode a press and release within one frame also counts as pressed and released.
+size_t							imuiInputGetEventCount( const ImuiInputState* input );
+const ImuiInputEvent*			imuiInputGetEvent( const ImuiInputState* input, size_t index );	// in push order
+bool							imuiInputHasLostEvents( const ImuiInputState* input );				// the oldest events got dropped because of the capacity
+
 //////////////////////////////////////////////////////////////////////////
 // Font
 // see imui_font.c
@@ -690,10 +823,29 @@ ImuiTextLayout*					imuiTextLayoutCreate( ImuiContext* imui, ImuiFont* font, con
 ImuiTextLayout*					imuiTextLayoutCreateLength( ImuiContext* imui, ImuiFont* font, const char* text, size_t length );
 ImuiTextLayout*					imuiTextLayoutCreateWidget( ImuiWidget* widget, ImuiFont* font, const char* text );
 ImuiTextLayout*					imuiTextLayoutCreateWidgetLength( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length );
+ImuiTextLayout*					imuiTextLayoutCreateWrapped( ImuiContext* imui, ImuiFont* font, const char* text, float wrapWidth, float hAlign ); // wrapWidth is unscaled and rounded down to IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP
+ImuiTextLayout*					imuiTextLayoutCreateWrappedLength( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, float wrapWidth, float hAlign );
+ImuiTextLayout*					imuiTextLayoutCreateWidgetWrapped( ImuiWidget* widget, ImuiFont* font, const char* text, float wrapWidth, float hAlign );
+ImuiTextLayout*					imuiTextLayoutCreateWidgetWrappedLength( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, float wrapWidth, float hAlign );
+ImuiTextLayout*					imuiTextLayoutCreateStatic( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, uint64_t textVersion ); // text is not copied and identified by pointer, length and version. change version when the content changes.
+ImuiTextLayout*					imuiTextLayoutCreateStaticWrapped( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, uint64_t textVersion, float wrapWidth, float hAlign );
+ImuiTextLayout*					imuiTextLayoutCreateWidgetStatic( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, uint64_t textVersion );
+ImuiTextLayout*					imuiTextLayoutCreateWidgetStaticWrapped( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, uint64_t textVersion, float wrapWidth, float hAlign );
 
 size_t							imuiTextLayoutCalculateGlyphCount( const char* text, size_t length );
 ImuiSize						imuiTextLayoutCalculateSize( ImuiContext* imui, ImuiFont* font, const char* text, size_t length );
 
+typedef struct ImuiTextLayoutCacheStats
+{
+	size_t							layoutCount;
+	size_t							memorySize;
+	size_t							hitCount;
+	size_t							missCount;
+	size_t							evictionCount;
+} ImuiTextLayoutCacheStats;
+
+void							imuiTextLayoutCacheGetStats( ImuiContext* imui, ImuiTextLayoutCacheStats* stats );
+
 size_t							imuiTextLayoutGetGlyphCount( const ImuiTextLayout* layout );
 size_t							imuiTextLayoutFindGlyphIndex( const ImuiTextLayout* layout, ImuiPos pos, float scale );
 size_t							imuiTextLayoutGetGlyphCharIndex( const ImuiTextLayout* layout, size_t glyphIndex );
@@ -759,6 +911,7 @@ ImuiRect						imuiRectCreateCenterPosSize( ImuiPos pos, ImuiSize size );
 ImuiRect						imuiRectCreateZero();
 ImuiRect						imuiRectShrinkBorder( ImuiRect rect, ImuiBorder border );
 ImuiRect						imuiRectIntersection( ImuiRect rect1, ImuiRect rect2 );
+ImuiRect						imuiRectUnion( ImuiRect rect1, ImuiRect rect2 );
 bool							imuiRectIncludesPos( ImuiRect rect, ImuiPos pos );
 bool							imuiRectIntersectsRect( ImuiRect rect1, ImuiRect rect2 );
 ImuiPos							imuiRectGetTopLeft( ImuiRect rect );
@@ -779,6 +932,8 @@ ImuiColor						imuiColorCreateGray( uint8_t gray );
 ImuiColor						imuiColorCreateGrayA( uint8_t gray, uint8_t alpha );
 ImuiColor						imuiColorCreateTransparentBlack();
 
+ImuiSkinDescriptor				imuiSkinDescriptorCreate( const ImuiSkin* skin );
+
 #ifdef __cplusplus
 }
 #endif
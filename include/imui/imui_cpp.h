@@ -161,6 +161,16 @@ namespace imui
 
 		void			setMouseCursor( ImuiInputMouseCursor cursor );
 
+		bool			getNextUpdateTime( double& timeInSeconds ) const;
+		bool			isIdle( double timeInSeconds ) const;
+		ImuiFrameStats	getFrameStats() const;
+
+		bool			beginTrace( size_t maxEventCount );
+		void			endTrace();
+		size_t			writeTrace( char* buffer, size_t bufferSize ) const;
+
+		ImuiMemoryTagStats	getMemoryStats( ImuiMemoryTag tag ) const;
+
 	private:
 
 		bool			m_owner;
@@ -189,6 +199,10 @@ namespace imui
 		bool					hasMouseButtonReleased( ImuiInputMouseButton button ) const;
 		UiPos					getMouseScrollDelta() const;
 
+		size_t					getEventCount() const;
+		const ImuiInputEvent&	getEvent( size_t index ) const;
+		bool					hasLostEvents() const;
+
 	private:
 
 		const ImuiInputState*	m_state;
@@ -239,6 +253,9 @@ namespace imui
 		UiSize			getSize() const;
 		float			getDpiScale() const;
 
+		bool			isDirty() const;	// call after endSurface
+		const ImuiRect*	getDamageRects( size_t& count ) const;
+
 	private:
 
 		bool			m_owner;
@@ -266,6 +283,7 @@ namespace imui
 		UiInputState	getInput() const;
 
 		double			getTime() const;
+		void			requestUpdate( double timeInSeconds );
 
 		void*			allocState( size_t size, ImuiId stateId );
 		void*			allocState( size_t size, ImuiId stateId, bool& isNew );
@@ -308,6 +326,7 @@ namespace imui
 		UiInputState	getInput() const;
 
 		double			getTime();
+		void			requestUpdate( double timeInSeconds );
 
 		void*			allocState( size_t size, ImuiId stateId );
 		void*			allocState( size_t size, ImuiId stateId, bool& isNew );
@@ -421,7 +440,7 @@ namespace imui
 			static const ImuiSkin&		getSkin( ImuiToolboxSkin skin );
 			static const ImuiImage&		getIcon( ImuiToolboxIcon icon );
 
-			static ImuiToolboxTheme&	getTheme();
+			static ImuiToolboxTheme&	getTheme();		// call imuiToolboxThemeSet( &getTheme() ) after changing skins through it
 		};
 
 		class UiToolboxConfigFloatScope : public UiNonCopyable
@@ -433,8 +452,7 @@ namespace imui
 
 		private:
 
-			float&				m_value;
-			float				m_oldValue;
+			bool				m_active;
 		};
 
 		class UiToolboxConfigColorScope : public UiNonCopyable
@@ -446,8 +464,7 @@ namespace imui
 
 		private:
 
-			ImuiToolboxColor	m_color;
-			ImuiColor			m_oldValue;
+			bool				m_active;
 		};
 
 		class UiToolboxConfigSkinScope : public UiNonCopyable
@@ -459,8 +476,7 @@ namespace imui
 
 		private:
 
-			ImuiToolboxSkin		m_skin;
-			ImuiSkin			m_oldValue;
+			bool				m_active;
 		};
 
 		class UiToolboxConfigIconScope : public UiNonCopyable
@@ -472,8 +488,7 @@ namespace imui
 
 		private:
 
-			ImuiToolboxIcon		m_icon;
-			ImuiImage			m_oldValue;
+			bool				m_active;
 		};
 
 		class UiToolboxConfigBorderScope : public UiNonCopyable
@@ -485,8 +500,7 @@ namespace imui
 
 		private:
 
-			ImuiBorder&			m_value;
-			UiBorder			m_oldValue;
+			bool				m_active;
 		};
 
 		class UiToolboxWindow : public UiWindow
@@ -513,6 +527,9 @@ namespace imui
 			void			label( const char* text );
 			void			label( const char* text, size_t length );
 			void			labelFormat( const char* format, ... );
+			void			labelInt( int64_t value );
+			void			labelUInt( uint64_t value );
+			void			labelFloat( double value, uint32_t decimals = 2u );
 			void			image( const ImuiImage& img );
 			void			image( const ImuiImage& img, const ImuiSize& size );
 
@@ -791,6 +808,11 @@ namespace imui
 				m_progress = 1.0f - m_progress;
 			}
 
+			if( currentTime - m_state->startTime < timeSpan )
+			{
+				widget.requestUpdate( currentTime );
+			}
+
 			m_value = minValue + ((maxValue - minValue) * m_progress);
 		}
 
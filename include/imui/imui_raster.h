@@ -0,0 +1,57 @@
+#pragma once
+
+#include "imui.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// Raster - Reference software renderer for headless rendering and screenshots
+// see imui_raster.c
+//
+// Draw data must be generated with the default vertex format (ImuiParameters::vertexFormat left empty). Texture
+// handles must point to an ImuiRasterTexture, handle 0 is drawn as white. Results don't depend on the SIMD path.
+
+typedef enum ImuiRasterTextureFormat
+{
+	ImuiRasterTextureFormat_RGBA8,
+	ImuiRasterTextureFormat_R8			// coverage only, e.g. bitmap font textures
+} ImuiRasterTextureFormat;
+
+typedef struct ImuiRasterTexture
+{
+	const uint8_t*				data;
+	uint32_t					width;
+	uint32_t					height;
+	ImuiRasterTextureFormat		format;
+} ImuiRasterTexture;
+
+typedef struct ImuiRasterTarget			// RGBA8 with straight alpha
+{
+	uint8_t*					pixels;
+	uint32_t					width;
+	uint32_t					height;
+	size_t						stride;		// in bytes
+} ImuiRasterTarget;
+
+typedef struct ImuiRasterVertex			// layout of the default vertex format
+{
+	float						x;
+	float						y;
+	float						u;
+	float						v;
+	float						red;
+	float						green;
+	float						blue;
+	float						alpha;
+} ImuiRasterVertex;
+
+void							imuiRasterClear( const ImuiRasterTarget* target, ImuiColor color );
+// indexData must be NULL for ImuiVertexType_VertexList, otherwise it is used by all commands including lines. limitRect can be NULL or a damage rect to redraw only a part.
+void							imuiRasterDraw( const ImuiRasterTarget* target, const ImuiDrawData* data, const void* vertexData, const uint32_t* indexData, const ImuiRect* limitRect );
+
+#ifdef __cplusplus
+}
+#endif
@@ -136,6 +136,7 @@ typedef struct ImuiToolboxThemeProgressBar
 {
 	float			height;
 	ImuiBorder		padding;
+	double			animationInterval;	// seconds between redraws requested by an indeterminate progress bar
 } ImuiToolboxThemeProgressBar;
 
 typedef struct ImuiToolboxThemeScrollArea
@@ -162,6 +163,8 @@ typedef struct ImuiToolboxThemeDropDown
 	ImuiBorder		itemPadding;
 	float			itemSize;
 	float			itemSpacing;
+
+	double			searchTime;
 } ImuiToolboxThemeDropDown;
 
 typedef struct ImuiToolboxThemePopup
@@ -183,6 +186,12 @@ typedef struct ImuiToolboxThemeTabView
 
 } ImuiToolboxThemeTabView;
 
+typedef struct ImuiToolboxThemeTreeView
+{
+	float			indent;
+	float			expanderSpacing;
+} ImuiToolboxThemeTreeView;
+
 typedef struct ImuiToolboxTheme
 {
 	ImuiColor						colors[ ImuiToolboxColor_MAX ];
@@ -201,6 +210,7 @@ typedef struct ImuiToolboxTheme
 	ImuiToolboxThemeDropDown		dropDown;
 	ImuiToolboxThemePopup			popup;
 	ImuiToolboxThemeTabView			tabView;
+	ImuiToolboxThemeTreeView		treeView;
 } ImuiToolboxTheme;
 
 typedef enum ImuiToolboxThemeReflectionType
@@ -230,6 +240,7 @@ typedef struct ImuiToolboxThemeReflection
 } ImuiToolboxThemeReflection;
 
 typedef struct ImuiToolboxTextBuffer ImuiToolboxTextBuffer;
+typedef struct ImuiToolboxTextDocument ImuiToolboxTextDocument;
 
 typedef struct ImuiToolboxScrollAreaState ImuiToolboxScrollAreaState;
 
@@ -266,13 +277,44 @@ typedef struct ImuiToolboxListContext
 	bool							changed;
 } ImuiToolboxListContext;
 
+typedef struct ImuiToolboxFilterListState ImuiToolboxFilterListState;
+
+typedef struct ImuiToolboxFilterListContext
+{
+	ImuiToolboxListContext			list;
+
+	ImuiToolboxFilterListState*		state;
+} ImuiToolboxFilterListContext;
+
+typedef size_t(*ImuiToolboxTreeViewChildCountFunc)(void* userData, uint64_t nodeId);
+typedef uint64_t(*ImuiToolboxTreeViewChildFunc)(void* userData, uint64_t nodeId, size_t childIndex);
+
+typedef struct ImuiToolboxTreeViewSource
+{
+	ImuiToolboxTreeViewChildCountFunc	getChildCount;
+	ImuiToolboxTreeViewChildFunc		getChild;
+	void*								userData;
+
+	uint64_t							rootId;		// root is not shown, its children are the top level rows
+	uint64_t							version;	// change when nodes get added or removed
+} ImuiToolboxTreeViewSource;
+
+typedef struct ImuiToolboxTreeViewState ImuiToolboxTreeViewState;
+
+typedef struct ImuiToolboxTreeViewContext
+{
+	ImuiToolboxListContext				list;
+
+	ImuiToolboxTreeViewState*			state;
+	const ImuiToolboxTreeViewSource*	source;
+} ImuiToolboxTreeViewContext;
+
 typedef struct ImuiToolboxTextViewState ImuiToolboxTextViewState;
 
 typedef struct ImuiToolboxTextViewContext
 {
 	ImuiToolboxListContext			list;
 
-	bool							ownsBuffer;
 	const ImuiToolboxTextBuffer*	textBuffer;
 } ImuiToolboxTextViewContext;
 
@@ -303,11 +345,17 @@ typedef struct ImuiToolboxTabViewContext
 
 ImuiToolboxThemeReflection	imuiToolboxThemeReflectionGet();
 
-ImuiToolboxTheme*		imuiToolboxThemeGet();
+ImuiToolboxTheme*		imuiToolboxThemeGet();		// call imuiToolboxThemeSet( imuiToolboxThemeGet() ) after changing skins through it
 void					imuiToolboxThemeFillDefault( ImuiToolboxTheme* config, ImuiFont* font );
 void					imuiToolboxThemeSet( const ImuiToolboxTheme* config );
 
-// TODO: add theme config scopes
+// Overrides are pushed as deltas onto a fixed stack and restored in reverse order by imuiToolboxThemePop.
+void					imuiToolboxThemePushColor( ImuiToolboxColor color, ImuiColor value );
+void					imuiToolboxThemePushSkin( ImuiToolboxSkin skin, const ImuiSkin* value );
+void					imuiToolboxThemePushIcon( ImuiToolboxIcon icon, const ImuiImage* value );
+void					imuiToolboxThemePushFloat( float* themeValue, float value );			// themeValue must point into imuiToolboxThemeGet()
+void					imuiToolboxThemePushBorder( ImuiBorder* themeValue, ImuiBorder value );	// themeValue must point into imuiToolboxThemeGet()
+void					imuiToolboxThemePop( size_t count );
 
 void					imuiToolboxSpacer( ImuiWindow* window, float width, float height );
 void					imuiToolboxStrecher( ImuiWindow* window, float horizontal, float vertical );
@@ -315,6 +363,7 @@ void					imuiToolboxStrecher( ImuiWindow* window, float horizontal, float vertic
 ImuiWidget*				imuiToolboxButtonBegin( ImuiWindow* window );
 bool					imuiToolboxButtonEnd( ImuiWidget* button );
 ImuiWidget*				imuiToolboxButtonLabelBegin( ImuiWindow* window, const char* text );
+ImuiWidget*				imuiToolboxButtonLabelBeginLength( ImuiWindow* window, const char* text, size_t length );
 ImuiWidget*				imuiToolboxButtonLabelBeginFormat( ImuiWindow* window, const char* format, ... );
 ImuiWidget*				imuiToolboxButtonLabelBeginFormatArgs( ImuiWindow* window, const char* format, va_list args );
 bool					imuiToolboxButtonLabel( ImuiWindow* window, const char* text );
@@ -336,12 +385,18 @@ ImuiWidget*				imuiToolboxLabelBeginLength( ImuiWindow* window, const char* text
 ImuiWidget*				imuiToolboxLabelBeginLengthColor( ImuiWindow* window, const char* text, size_t length, ImuiColor color );
 ImuiWidget*				imuiToolboxLabelBeginFormat( ImuiWindow* window, const char* format, ... );
 ImuiWidget*				imuiToolboxLabelBeginFormatArgs( ImuiWindow* window, const char* format, va_list args );
+ImuiWidget*				imuiToolboxLabelBeginInt( ImuiWindow* window, int64_t value );
+ImuiWidget*				imuiToolboxLabelBeginUInt( ImuiWindow* window, uint64_t value );
+ImuiWidget*				imuiToolboxLabelBeginFloat( ImuiWindow* window, double value, uint32_t decimals );	// same result as "%.*f" but without printf for up to 6 decimals, except -0 is printed as 0
 void					imuiToolboxLabelEnd( ImuiWidget* label );
 void					imuiToolboxLabel( ImuiWindow* window, const char* text );
 void					imuiToolboxLabelLength( ImuiWindow* window, const char* text, size_t length );
 void					imuiToolboxLabelColor( ImuiWindow* window, const char* text, ImuiColor color );
 void					imuiToolboxLabelFormat( ImuiWindow* window, const char* format, ... );
 void					imuiToolboxLabelFormatArgs( ImuiWindow* window, const char* format, va_list args );
+void					imuiToolboxLabelInt( ImuiWindow* window, int64_t value );
+void					imuiToolboxLabelUInt( ImuiWindow* window, uint64_t value );
+void					imuiToolboxLabelFloat( ImuiWindow* window, double value, uint32_t decimals );
 
 ImuiWidget*				imuiToolboxImageBegin( ImuiWindow* window, ImuiSize imgSize );
 void					imuiToolboxImageEnd( ImuiWidget* imgWidget, const ImuiImage* img );
@@ -359,12 +414,28 @@ float					imuiToolboxSliderStateMinMaxDefault( ImuiWindow* window, float min, fl
 
 ImuiToolboxTextBuffer*	imuiToolboxTextBufferCreate( ImuiContext* imui );
 ImuiToolboxTextBuffer*	imuiToolboxTextBufferCreateText( ImuiContext* imui, const char* text );
+ImuiToolboxTextBuffer*	imuiToolboxTextBufferCreateRing( ImuiContext* imui, size_t maxLength, size_t maxLineCount );	// limits of 0 are unbounded. oldest lines get removed when a limit is reached
 void					imuiToolboxTextBufferFree( ImuiToolboxTextBuffer* textBuffer );
 void					imuiToolboxTextBufferSet( ImuiToolboxTextBuffer* textBuffer, const char* text );
 void					imuiToolboxTextBufferAppend( ImuiToolboxTextBuffer* textBuffer, const char* text );
 void					imuiToolboxTextBufferAppendLength( ImuiToolboxTextBuffer* textBuffer, const char* text, size_t textLength );
 const char*				imuiToolboxTextBufferGetData( const ImuiToolboxTextBuffer* textBuffer );
 size_t					imuiToolboxTextBufferGetLength( const ImuiToolboxTextBuffer* textBuffer );
+size_t					imuiToolboxTextBufferGetLineCount( const ImuiToolboxTextBuffer* textBuffer );
+
+ImuiToolboxTextDocument*	imuiToolboxTextDocumentCreate( ImuiContext* imui );
+ImuiToolboxTextDocument*	imuiToolboxTextDocumentCreateText( ImuiContext* imui, const char* text, size_t textLength );
+void					imuiToolboxTextDocumentFree( ImuiToolboxTextDocument* document );
+void					imuiToolboxTextDocumentSet( ImuiToolboxTextDocument* document, const char* text, size_t textLength );	// also clears undo history
+void					imuiToolboxTextDocumentInsert( ImuiToolboxTextDocument* document, size_t offset, const char* text, size_t textLength );
+void					imuiToolboxTextDocumentRemove( ImuiToolboxTextDocument* document, size_t offset, size_t length );
+bool					imuiToolboxTextDocumentUndo( ImuiToolboxTextDocument* document );
+bool					imuiToolboxTextDocumentRedo( ImuiToolboxTextDocument* document );
+const char*				imuiToolboxTextDocumentGetText( ImuiToolboxTextDocument* document, size_t offset, size_t length );	// returned text is contiguous and valid until the next change
+size_t					imuiToolboxTextDocumentGetLength( const ImuiToolboxTextDocument* document );
+size_t					imuiToolboxTextDocumentGetLineCount( const ImuiToolboxTextDocument* document );
+size_t					imuiToolboxTextDocumentGetLineOffset( const ImuiToolboxTextDocument* document, size_t lineIndex );
+uint64_t				imuiToolboxTextDocumentGetVersion( const ImuiToolboxTextDocument* document );
 
 ImuiWidget*				imuiToolboxTextEditBegin( ImuiWindow* window );
 bool					imuiToolboxTextEditEnd( ImuiWidget* textEdit, char* buffer, size_t bufferSize, size_t* textLength );
@@ -372,12 +443,15 @@ bool					imuiToolboxTextEdit( ImuiWindow* window, char* buffer, size_t bufferSiz
 const char*				imuiToolboxTextEditStateBuffer( ImuiWindow* window, size_t bufferSize );
 const char*				imuiToolboxTextEditStateBufferDefault( ImuiWindow* window, size_t bufferSize, const char* defaultValue );
 
-ImuiWidget*				imuiToolboxTextViewBegin( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text );
+ImuiWidget*				imuiToolboxTextViewBegin( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text );	// line index is cached by pointer. text changed in place needs imuiToolboxTextViewBeginStatic with a new version
+ImuiWidget*				imuiToolboxTextViewBeginStatic( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text, size_t textLength, uint64_t textVersion );	// text is not copied. line index is rebuilt when pointer, length or version changes
 ImuiWidget*				imuiToolboxTextViewBeginBuffer( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const ImuiToolboxTextBuffer* textBuffer );
 void					imuiToolboxTextViewEnd( ImuiToolboxTextViewContext* textView );
-void					imuiToolboxTextView( ImuiWindow* window, const char* text );
+void					imuiToolboxTextView( ImuiWindow* window, const char* text );	// same caching as imuiToolboxTextViewBegin
 void					imuiToolboxTextViewBuffer( ImuiWindow* window, const ImuiToolboxTextBuffer* textBuffer );
 
+bool					imuiToolboxTextEditor( ImuiWindow* window, ImuiToolboxTextDocument* document );	// multi-line editor, only visible lines get a layout
+
 void					imuiToolboxProgressBar( ImuiWindow* window, float value ); // value range 0 to 1
 void					imuiToolboxProgressBarMinMax( ImuiWindow* window, float value, float min, float max );
 
@@ -397,7 +471,25 @@ ImuiWidget*				imuiToolboxListNextItem( ImuiToolboxListContext* list );
 ImuiWidget*				imuiToolboxListNextItemId( ImuiToolboxListContext* list, ImuiId id );
 bool					imuiToolboxListEnd( ImuiToolboxListContext* list );
 
+ImuiWidget*				imuiToolboxFilterListBegin( ImuiToolboxFilterListContext* filterList, ImuiWindow* window, float itemSize, const char** items, size_t itemCount, size_t itemStride, uint64_t itemsVersion, const char* filter, bool selection );	// case insensitive substring filter. matches are cached per filter character, change itemsVersion when the item texts change in place
+size_t					imuiToolboxFilterListGetMatchCount( const ImuiToolboxFilterListContext* filterList );
+size_t					imuiToolboxFilterListGetItemIndex( const ImuiToolboxFilterListContext* filterList, size_t matchIndex );	// matches are visited with imuiToolboxListGetBeginIndex/EndIndex and NextItem on filterList->list
+size_t					imuiToolboxFilterListGetSelectedIndex( const ImuiToolboxFilterListContext* filterList );				// item index, not match index
+void					imuiToolboxFilterListSetSelectedIndex( ImuiToolboxFilterListContext* filterList, size_t itemIndex );
+bool					imuiToolboxFilterListEnd( ImuiToolboxFilterListContext* filterList );
+
+ImuiWidget*				imuiToolboxTreeViewBegin( ImuiToolboxTreeViewContext* treeView, ImuiWindow* window, float itemSize, const ImuiToolboxTreeViewSource* source, bool selection );	// children are only requested for expanded nodes
+size_t					imuiToolboxTreeViewGetRowCount( const ImuiToolboxTreeViewContext* treeView );
+uint64_t				imuiToolboxTreeViewGetNodeId( const ImuiToolboxTreeViewContext* treeView, size_t rowIndex );	// rows are visited with imuiToolboxListGetBeginIndex/EndIndex on treeView->list
+ImuiWidget*				imuiToolboxTreeViewNextItem( ImuiToolboxTreeViewContext* treeView );							// indented row with expander, content gets added by the caller
+bool					imuiToolboxTreeViewIsExpanded( const ImuiToolboxTreeViewContext* treeView, uint64_t nodeId );
+void					imuiToolboxTreeViewSetExpanded( ImuiToolboxTreeViewContext* treeView, uint64_t nodeId, bool expanded );	// rows change in imuiToolboxTreeViewEnd
+bool					imuiToolboxTreeViewGetSelectedNodeId( const ImuiToolboxTreeViewContext* treeView, uint64_t* nodeId );
+void					imuiToolboxTreeViewSetSelectedNodeId( ImuiToolboxTreeViewContext* treeView, uint64_t nodeId );
+bool					imuiToolboxTreeViewEnd( ImuiToolboxTreeViewContext* treeView );
+
 ImuiWidget*				imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, ImuiWindow* window, const char** items, size_t itemCount, size_t itemStride );
+ImuiWidget*				imuiToolboxDropDownBeginVersion( ImuiToolboxDropDownContext* dropDown, ImuiWindow* window, const char** items, size_t itemCount, size_t itemStride, uint64_t itemsVersion );	// change itemsVersion when the item texts change in place
 size_t					imuiToolboxDropDownGetSelectedIndex( const ImuiToolboxDropDownContext* dropDown );
 void					imuiToolboxDropDownSetSelectedIndex( const ImuiToolboxDropDownContext* dropDown, size_t index );
 bool					imuiToolboxDropDownEnd( ImuiToolboxDropDownContext* dropDown );
@@ -6,9 +6,11 @@
 #include "imui_memory.h"
 
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 
 static void			imuiWindowLayout( ImuiWindow* window );
+static void			imuiWindowUpdateFocusCandidates( ImuiWindow* window, ImuiPos direction, ImuiInputShortcut shortcut );
 
 static ImuiWidget*	imuiWidgetAlloc( ImuiContext* imui );
 static void			imuiWidgetUpdateLayoutContext( ImuiWidget* widget, uintsize widgetIndex, float dpiScale, bool update );
@@ -72,11 +74,13 @@ ImuiContext* imuiCreate( const ImuiParameters* parameters )
 	}
 
 	imuiMemoryAllocatorFinalize( &imui->allocator, &allocator );
+	imuiStatsConstruct( &imui->stats, &imui->allocator, parameters );
+	imuiStringArenaConstruct( &imui->frameStrings, imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Strings ) );
 
-	if( !imuiInputConstruct( &imui->input, &imui->allocator, parameters->shortcuts, parameters->shortcutCount ) ||
-		!imuiDrawConstruct( &imui->draw, &imui->allocator, &parameters->vertexFormat, parameters->vertexType ) ||
-		!imuiStringPoolConstruct( &imui->strings, &imui->allocator ) ||
-		!imuiTextLayoutCacheConstruct( &imui->layoutCache, &imui->allocator ) )
+	if( !imuiInputConstruct( &imui->input, imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Input ), parameters->shortcuts, parameters->shortcutCount, parameters->inputEventCapacity ) ||
+		!imuiDrawConstruct( &imui->draw, imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Draw ), &imui->stats, &parameters->vertexFormat, parameters->vertexType, parameters->trackChanges ) ||
+		!imuiStringPoolConstruct( &imui->strings, imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Strings ) ) ||
+		!imuiTextLayoutCacheConstruct( &imui->layoutCache, imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_TextLayouts ), &imui->stats, parameters->textLayoutCacheBudget, parameters->textLayoutCacheMaxAge ) )
 	{
 		imuiDestroy( imui );
 		return NULL;
@@ -91,6 +95,7 @@ void imuiDestroy( ImuiContext* imui )
 	{
 		ImuiSurface* surface = &imui->surfaces[ i ];
 		imuiMemoryFree( &imui->allocator, surface->windows );
+		imuiMemoryFree( &imui->allocator, surface->hitTests );
 	}
 	imuiMemoryFree( &imui->allocator, imui->surfaces );
 
@@ -124,8 +129,18 @@ void imuiDestroy( ImuiContext* imui )
 	imuiInputDestruct( &imui->input );
 	imuiDrawDestruct( &imui->draw );
 	imuiStringPoolDestruct( &imui->strings );
+	imuiStringArenaDestruct( &imui->frameStrings );
 	imuiTextLayoutCacheDestruct( &imui->layoutCache );
 
+	ImuiFocusCandidates* focusCandidates = &imui->focusCandidates;
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->widgets, focusCandidates->widgetCapacity );
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->centers, focusCandidates->centerCapacity );
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->cellStarts, focusCandidates->cellStartCapacity );
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->cellWidgets, focusCandidates->cellWidgetCapacity );
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->cells, focusCandidates->cellCapacity );
+	IMUI_MEMORY_ARRAY_FREE( &imui->allocator, focusCandidates->gridCenters, focusCandidates->gridCenterCapacity );
+
+	imuiStatsDestruct( &imui->stats, &imui->allocator );
 	imuiMemoryFree( &imui->allocator, imui );
 }
 
@@ -134,6 +149,11 @@ ImuiFrame* imuiBegin( ImuiContext* imui, double timeInSeconds )
 	imui->frame.context			= imui;
 	imui->frame.index++;
 	imui->frame.timeInSeconds	= timeInSeconds;
+	imui->frame.nextUpdateTime	= DBL_MAX;
+	imui->frame.hasChanges		= false;
+
+	imuiStringArenaClear( &imui->frameStrings );
+	imuiStatsBeginFrame( &imui->stats );
 
 	return &imui->frame;
 }
@@ -142,6 +162,9 @@ void imuiEnd( ImuiFrame* frame )
 {
 	ImuiContext* imui = frame->context;
 
+	imui->nextUpdateTime		= frame->nextUpdateTime;
+	imui->lastFrameHasChanges	= frame->hasChanges;
+
 	imuiDrawEndFrame( &imui->draw );
 	imuiInputEndFrame( &imui->input );
 
@@ -152,6 +175,7 @@ void imuiEnd( ImuiFrame* frame )
 		if( !surface->inUse )
 		{
 			imuiMemoryFree( &imui->allocator, surface->windows );
+			imuiMemoryFree( &imui->allocator, surface->hitTests );
 
 			IMUI_MEMORY_ARRAY_REMOVE_UNSORTED_ZERO( imui->surfaces, imui->surfaceCount, surfaceIndex );
 
@@ -208,6 +232,8 @@ void imuiEnd( ImuiFrame* frame )
 	imui->firstGridContext			= NULL;
 
 	imuiTextLayoutCacheEndFrame( &imui->layoutCache );
+
+	imuiStatsEndFrame( &imui->stats );
 }
 
 ImuiInput* imuiInputBegin( ImuiContext* imui, const ImuiInputState* previousState )
@@ -235,6 +261,51 @@ ImuiContext* imuiFrameGetContext( const ImuiFrame* frame )
 	return frame->context;
 }
 
+bool imuiGetNextUpdateTime( const ImuiContext* imui, double* outTimeInSeconds )
+{
+	if( imui->nextUpdateTime == DBL_MAX )
+	{
+		return false;
+	}
+
+	*outTimeInSeconds = imui->nextUpdateTime;
+	return true;
+}
+
+bool imuiIsIdle( const ImuiContext* imui, double timeInSeconds )
+{
+	// a changed frame needs a follow-up because layout results are used one frame later
+	return imui->frame.index > 0u &&
+		!imui->lastFrameHasChanges &&
+		timeInSeconds < imui->nextUpdateTime;
+}
+
+void imuiGetFrameStats( const ImuiContext* imui, ImuiFrameStats* stats )
+{
+	*stats = imui->stats.last;
+}
+
+bool imuiTraceBegin( ImuiContext* imui, size_t maxEventCount )
+{
+	return imuiStatsTraceBegin( &imui->stats, maxEventCount );
+}
+
+void imuiTraceEnd( ImuiContext* imui )
+{
+	imuiStatsTraceEnd( &imui->stats );
+}
+
+size_t imuiTraceWrite( const ImuiContext* imui, char* buffer, size_t bufferSize )
+{
+	return imuiStatsTraceWrite( &imui->stats, buffer, bufferSize );
+}
+
+void imuiGetMemoryStats( const ImuiContext* imui, ImuiMemoryTag tag, ImuiMemoryTagStats* stats )
+{
+	IMUI_ASSERT( tag < ImuiMemoryTag_MAX );
+	*stats = imui->stats.tags[ tag ].data;
+}
+
 ImuiSurface* imuiSurfaceBegin( ImuiFrame* frame, const char* name, ImuiSize size, const ImuiInputState* input, float dpiScale )
 {
 	return imuiSurfaceBeginId( frame, name, (ImuiId)imuiHashCreate( name, strlen( name ) ), size, input, dpiScale );
@@ -280,6 +351,8 @@ ImuiSurface* imuiSurfaceBeginId( ImuiFrame* frame, const char* name, ImuiId id,
 	surface->size		= size;
 	surface->input		= input;
 	surface->dpiScale	= dpiScale;
+
+	surface->hitTestValid	= false;
 	surface->drawIndex	= imuiDrawRegisterSurface( &imui->draw, surface->name, size );
 
 	return surface;
@@ -287,7 +360,24 @@ ImuiSurface* imuiSurfaceBeginId( ImuiFrame* frame, const char* name, ImuiId id,
 
 void imuiSurfaceEnd( ImuiSurface* surface )
 {
-	imuiDrawSurfaceEnd( &surface->context->draw, surface->drawIndex );
+	ImuiContext* imui = surface->context;
+	imuiDrawSurfaceEnd( &imui->draw, surface->drawIndex );
+
+	if( imuiDrawIsSurfaceDirty( &imui->draw, surface->drawIndex ) ||
+		imuiInputHasChanges( surface->input ) )
+	{
+		imui->frame.hasChanges = true;
+	}
+}
+
+bool imuiSurfaceIsDirty( const ImuiSurface* surface )
+{
+	return imuiDrawIsSurfaceDirty( &surface->context->draw, surface->drawIndex );
+}
+
+const ImuiRect* imuiSurfaceGetDamageRects( const ImuiSurface* surface, size_t* outCount )
+{
+	return imuiDrawGetSurfaceDamageRects( &surface->context->draw, surface->drawIndex, outCount );
 }
 
 void imuiSurfaceGetMaxBufferSizes( ImuiSurface* surface, size_t* outVertexDataSize, size_t* outIndexDataSize )
@@ -297,7 +387,11 @@ void imuiSurfaceGetMaxBufferSizes( ImuiSurface* surface, size_t* outVertexDataSi
 
 const ImuiDrawData* imuiSurfaceGenerateDrawData( ImuiSurface* surface, void* outVertexData, size_t* inOutVertexDataSize, void* outIndexData, size_t* inOutIndexDataSize )
 {
-	return imuiDrawGenerateSurfaceData( &surface->context->draw, surface->drawIndex, outVertexData, inOutVertexDataSize, outIndexData, inOutIndexDataSize );
+	IMUI_STATS_ZONE_BEGIN( &surface->context->stats, "imuiSurfaceGenerateDrawData", surface->name.data, surface->name.length );
+	const ImuiDrawData* data = imuiDrawGenerateSurfaceData( &surface->context->draw, surface->drawIndex, outVertexData, inOutVertexDataSize, outIndexData, inOutIndexDataSize );
+	IMUI_STATS_ZONE_END( &surface->context->stats );
+
+	return data;
 }
 
 ImuiContext* imuiSurfaceGetContext( const ImuiSurface* surface )
@@ -366,6 +460,13 @@ ImuiWindow* imuiWindowBeginId( ImuiSurface* surface, const char* name, ImuiId id
 		surface->windowCount++;
 
 		memset( window, 0, sizeof( *window ) );
+
+		surface->hitTestValid = false;
+	}
+	else if( window->zOrder != zOrder ||
+		memcmp( &window->rect, &rect, sizeof( rect ) ) != 0 )
+	{
+		surface->hitTestValid = false;
 	}
 
 	window->inUse						= true;
@@ -405,8 +506,12 @@ ImuiWindow* imuiWindowBeginId( ImuiSurface* surface, const char* name, ImuiId id
 
 void imuiWindowEnd( ImuiWindow* window )
 {
+	IMUI_STATS_ZONE_BEGIN( &window->context->stats, "imuiWindowEnd", window->name.data, window->name.length );
+	IMUI_STATS_PHASE_BEGIN( &window->context->stats, layoutStartTime );
 	imuiWidgetEnd( window->rootWidget );
 	imuiWindowLayout( window );
+	IMUI_STATS_PHASE_END( &window->context->stats, layoutStartTime, ImuiFramePhase_Layout );
+	IMUI_STATS_ZONE_END( &window->context->stats );
 }
 
 ImuiContext* imuiWindowGetContext( const ImuiWindow* window )
@@ -429,6 +534,12 @@ double imuiWindowGetTime( const ImuiWindow* window )
 	return window->context->frame.timeInSeconds;
 }
 
+void imuiWindowRequestUpdate( ImuiWindow* window, double timeInSeconds )
+{
+	ImuiFrame* frame = &window->context->frame;
+	frame->nextUpdateTime = IMUI_MIN( frame->nextUpdateTime, timeInSeconds );
+}
+
 float imuiWindowGetDpiScale( const ImuiWindow* window )
 {
 	return window->surface->dpiScale;
@@ -512,6 +623,13 @@ static void imuiWindowLayout( ImuiWindow* window )
 
 	window->hasFocus &= !window->focusLocked;
 
+	// focus candidates are only collected and scored if there is something to navigate to
+	const ImuiPos direction				= imuiInputGetDirection( window->surface->input );
+	const ImuiInputShortcut shortcut	= imuiInputGetShortcut( window->surface->input );
+	const bool hasDirection				= direction.x != 0.0f || direction.y != 0.0f;
+	window->hasFocusQuery				= window->hasFocus && (hasDirection || shortcut == ImuiInputShortcut_FocusNext || shortcut == ImuiInputShortcut_FocusPrevious);
+	window->context->focusCandidates.widgetCount = 0u;
+
 	if( window->hasFocus )
 	{
 		window->diagonalLength				= sqrtf( (window->rect.size.width * window->rect.size.width) + (window->rect.size.height * window->rect.size.height) );
@@ -533,12 +651,11 @@ static void imuiWindowLayout( ImuiWindow* window )
 			window->focusPoint = window->rect.pos;
 		}
 
-		const ImuiPos direction = imuiInputGetDirection( window->surface->input );
-		if( window->focusWidget && window->focusWrap && (direction.x != 0.0f || direction.y != 0.0f) )
+		if( window->focusWidget && window->focusWrap && hasDirection )
 		{
 			const ImuiPos dirStart = window->focusPoint;
 
-			ImuiPos dirEnd = imuiInputGetDirection( window->surface->input );
+			ImuiPos dirEnd = direction;
 			dirEnd.x *= -1.0f * window->diagonalLength;
 			dirEnd.y *= -1.0f * window->diagonalLength;
 
@@ -585,7 +702,11 @@ static void imuiWindowLayout( ImuiWindow* window )
 		childIndex++;
 	}
 
-	const ImuiInputShortcut shortcut = imuiInputGetShortcut( window->surface->input );
+	if( window->hasFocusQuery )
+	{
+		imuiWindowUpdateFocusCandidates( window, direction, shortcut );
+	}
+
 	if( window->surface->input->current.focusExecute )
 	{
 		if( window->closesFocusWidget )
@@ -605,6 +726,311 @@ static void imuiWindowLayout( ImuiWindow* window )
 	}
 }
 
+static bool imuiWindowGetFocusFactor( const ImuiWindow* window, ImuiPos center, ImuiPos origin, ImuiPos focusDirection, float* outFocusFactor )
+{
+	const ImuiPos distance			= imuiPosSubPos( center, origin );
+	const float distanceLength		= sqrtf( (distance.x * distance.x) + (distance.y * distance.y) );
+	const ImuiPos direction			= imuiPosScale( distance, 1.0f / distanceLength );
+
+	const float angleFactor			= (direction.x * focusDirection.x) + (direction.y * focusDirection.y);
+	const float distanceFactor		= 1.0f - (distanceLength / window->diagonalLength);
+	*outFocusFactor					= (angleFactor * angleFactor) + (distanceFactor * distanceFactor);
+
+	return angleFactor > window->focusAngleThreshold;
+}
+
+static bool imuiFocusCandidatesBuildGrid( ImuiFocusCandidates* candidates, ImuiAllocator* allocator )
+{
+	// the layout is usually the same while navigating, keep the grid of the last frame in that case
+	if( candidates->gridSide > 0u &&
+		candidates->gridCenterCount == candidates->widgetCount &&
+		memcmp( candidates->gridCenters, candidates->centers, sizeof( *candidates->centers ) * candidates->widgetCount ) == 0 )
+	{
+		return true;
+	}
+
+	candidates->gridSide		= 0u;
+	candidates->gridCenterCount	= 0u;
+
+	const uint32 side			= (uint32)sqrtf( (float)candidates->widgetCount / IMUI_DEFAULT_FOCUS_GRID_CELL_WIDGET_COUNT );
+	const uintsize cellCount	= (uintsize)side * side;
+	if( side < 2u ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( allocator, candidates->cellStarts, candidates->cellStartCapacity, cellCount + 1u ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( allocator, candidates->cellWidgets, candidates->cellWidgetCapacity, candidates->widgetCount ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( allocator, candidates->cells, candidates->cellCapacity, cellCount ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( allocator, candidates->gridCenters, candidates->gridCenterCapacity, candidates->widgetCount ) )
+	{
+		return false;
+	}
+
+	ImuiPos minPos = candidates->centers[ 0u ];
+	ImuiPos maxPos = minPos;
+	for( uintsize i = 1u; i < candidates->widgetCount; ++i )
+	{
+		const ImuiPos center = candidates->centers[ i ];
+		minPos.x = IMUI_MIN( minPos.x, center.x );
+		minPos.y = IMUI_MIN( minPos.y, center.y );
+		maxPos.x = IMUI_MAX( maxPos.x, center.x );
+		maxPos.y = IMUI_MAX( maxPos.y, center.y );
+	}
+
+	candidates->gridPos			= minPos;
+	candidates->gridCellSize	= imuiSizeCreate( IMUI_MAX( (maxPos.x - minPos.x) / side, 1.0f ), IMUI_MAX( (maxPos.y - minPos.y) / side, 1.0f ) );
+	candidates->gridSide		= side;
+
+	const float invCellWidth	= 1.0f / candidates->gridCellSize.width;
+	const float invCellHeight	= 1.0f / candidates->gridCellSize.height;
+
+	// counting sort of the widget indices by cell
+	memset( candidates->cellStarts, 0, sizeof( *candidates->cellStarts ) * (cellCount + 1u) );
+	for( uintsize i = 0u; i < candidates->widgetCount; ++i )
+	{
+		const ImuiPos center = candidates->centers[ i ];
+		const uint32 x = IMUI_MIN( (uint32)((center.x - minPos.x) * invCellWidth), side - 1u );
+		const uint32 y = IMUI_MIN( (uint32)((center.y - minPos.y) * invCellHeight), side - 1u );
+		candidates->cellStarts[ (y * side) + x + 1u ]++;
+	}
+
+	for( uintsize i = 0u; i < cellCount; ++i )
+	{
+		candidates->cellStarts[ i + 1u ] += candidates->cellStarts[ i ];
+	}
+
+	for( uintsize i = 0u; i < candidates->widgetCount; ++i )
+	{
+		const ImuiPos center = candidates->centers[ i ];
+		const uint32 x = IMUI_MIN( (uint32)((center.x - minPos.x) * invCellWidth), side - 1u );
+		const uint32 y = IMUI_MIN( (uint32)((center.y - minPos.y) * invCellHeight), side - 1u );
+		candidates->cellWidgets[ candidates->cellStarts[ (y * side) + x ]++ ] = (uint32)i;
+	}
+
+	// filling shifted the starts by one cell
+	for( uintsize i = cellCount; i > 0u; --i )
+	{
+		candidates->cellStarts[ i ] = candidates->cellStarts[ i - 1u ];
+	}
+	candidates->cellStarts[ 0u ] = 0u;
+
+	memcpy( candidates->gridCenters, candidates->centers, sizeof( *candidates->centers ) * candidates->widgetCount );
+	candidates->gridCenterCount = candidates->widgetCount;
+
+	return true;
+}
+
+static float imuiFocusCellGetMaxFactor( const ImuiWindow* window, ImuiPos cellMin, ImuiPos cellMax, ImuiPos origin, ImuiPos focusDirection, bool* outInCone )
+{
+	const ImuiPos corners[] =
+	{
+		imuiPosCreate( cellMin.x, cellMin.y ),
+		imuiPosCreate( cellMax.x, cellMin.y ),
+		imuiPosCreate( cellMin.x, cellMax.y ),
+		imuiPosCreate( cellMax.x, cellMax.y )
+	};
+
+	// the angle to the cell is the best possible if the focus ray hits it, otherwise one of the corners is the closest to the ray
+	float tMin = 0.0f;
+	float tMax = IMUI_FLOAT_INF;
+	bool rayHit = true;
+	for( uintsize axis = 0u; axis < 2u && rayHit; ++axis )
+	{
+		const float originValue		= axis == 0u ? origin.x : origin.y;
+		const float directionValue	= axis == 0u ? focusDirection.x : focusDirection.y;
+		const float minValue		= axis == 0u ? cellMin.x : cellMin.y;
+		const float maxValue		= axis == 0u ? cellMax.x : cellMax.y;
+		if( directionValue == 0.0f )
+		{
+			rayHit = originValue >= minValue && originValue <= maxValue;
+			continue;
+		}
+
+		const float t1 = (minValue - originValue) / directionValue;
+		const float t2 = (maxValue - originValue) / directionValue;
+		tMin = IMUI_MAX( tMin, IMUI_MIN( t1, t2 ) );
+		tMax = IMUI_MIN( tMax, IMUI_MAX( t1, t2 ) );
+		rayHit = tMin <= tMax;
+	}
+
+	float maxAngleFactor	= rayHit ? 1.0f : -1.0f;
+	float maxDistance		= 0.0f;
+	for( uintsize i = 0u; i < IMUI_ARRAY_COUNT( corners ); ++i )
+	{
+		const ImuiPos distance		= imuiPosSubPos( corners[ i ], origin );
+		const float distanceLength	= sqrtf( (distance.x * distance.x) + (distance.y * distance.y) );
+		maxDistance = IMUI_MAX( maxDistance, distanceLength );
+
+		if( !rayHit && distanceLength > 0.0f )
+		{
+			maxAngleFactor = IMUI_MAX( maxAngleFactor, ((distance.x * focusDirection.x) + (distance.y * focusDirection.y)) / distanceLength );
+		}
+	}
+
+	const ImuiPos nearest			= imuiPosMax( cellMin, imuiPosMin( cellMax, origin ) );
+	const ImuiPos nearestDistance	= imuiPosSubPos( nearest, origin );
+	const float minDistance			= sqrtf( (nearestDistance.x * nearestDistance.x) + (nearestDistance.y * nearestDistance.y) );
+
+	const float minDistanceFactor	= 1.0f - (minDistance / window->diagonalLength);
+	const float maxDistanceFactor	= 1.0f - (maxDistance / window->diagonalLength);
+	const float maxAngleFactor2		= window->focusAngleThreshold >= 0.0f ? maxAngleFactor * maxAngleFactor : 1.0f;
+
+	*outInCone = maxAngleFactor + 0.0001f > window->focusAngleThreshold;
+	return maxAngleFactor2 + IMUI_MAX( minDistanceFactor * minDistanceFactor, maxDistanceFactor * maxDistanceFactor );
+}
+
+static int imuiFocusCellCompare( const void* lhs, const void* rhs )
+{
+	const ImuiFocusCell* lhsCell = (const ImuiFocusCell*)lhs;
+	const ImuiFocusCell* rhsCell = (const ImuiFocusCell*)rhs;
+	return (lhsCell->maxFactor < rhsCell->maxFactor) - (lhsCell->maxFactor > rhsCell->maxFactor);
+}
+
+// returns the widget with the highest focus factor inside of the angle threshold. on equal factors the first widget in layout order wins.
+static ImuiWidget* imuiWindowFindFocusWidget( ImuiWindow* window, bool hasGrid, ImuiPos origin, ImuiPos focusDirection, float* outFocusFactor )
+{
+	const ImuiFocusCandidates* candidates = &window->context->focusCandidates;
+
+	uintsize bestIndex	= IMUI_SIZE_MAX;
+	float bestFactor	= 0.0f;
+	if( !hasGrid )
+	{
+		for( uintsize i = 0u; i < candidates->widgetCount; ++i )
+		{
+			float focusFactor;
+			if( imuiWindowGetFocusFactor( window, candidates->centers[ i ], origin, focusDirection, &focusFactor ) &&
+				focusFactor > bestFactor )
+			{
+				bestFactor	= focusFactor;
+				bestIndex	= i;
+			}
+		}
+	}
+	else
+	{
+		const uint32 side = candidates->gridSide;
+
+		uintsize cellCount = 0u;
+		for( uint32 y = 0u; y < side; ++y )
+		{
+			for( uint32 x = 0u; x < side; ++x )
+			{
+				const uint32 cellIndex = (y * side) + x;
+				if( candidates->cellStarts[ cellIndex ] == candidates->cellStarts[ cellIndex + 1u ] )
+				{
+					continue;
+				}
+
+				// one pixel margin for centers rounded into a neighbor cell
+				const ImuiPos cellMin = imuiPosCreate( candidates->gridPos.x + (x * candidates->gridCellSize.width) - 1.0f, candidates->gridPos.y + (y * candidates->gridCellSize.height) - 1.0f );
+				const ImuiPos cellMax = imuiPosCreate( cellMin.x + candidates->gridCellSize.width + 2.0f, cellMin.y + candidates->gridCellSize.height + 2.0f );
+
+				bool inCone;
+				const float maxFactor = imuiFocusCellGetMaxFactor( window, cellMin, cellMax, origin, focusDirection, &inCone );
+				if( !inCone )
+				{
+					continue;
+				}
+
+				ImuiFocusCell* cell = &candidates->cells[ cellCount++ ];
+				cell->maxFactor	= maxFactor;
+				cell->index		= cellIndex;
+			}
+		}
+
+		qsort( candidates->cells, cellCount, sizeof( *candidates->cells ), imuiFocusCellCompare );
+
+		for( uintsize i = 0u; i < cellCount; ++i )
+		{
+			const ImuiFocusCell* cell = &candidates->cells[ i ];
+			if( cell->maxFactor + 0.001f < bestFactor )
+			{
+				break;
+			}
+
+			for( uint32 j = candidates->cellStarts[ cell->index ]; j < candidates->cellStarts[ cell->index + 1u ]; ++j )
+			{
+				const uint32 widgetIndex = candidates->cellWidgets[ j ];
+
+				float focusFactor;
+				if( !imuiWindowGetFocusFactor( window, candidates->centers[ widgetIndex ], origin, focusDirection, &focusFactor ) )
+				{
+					continue;
+				}
+
+				if( focusFactor > bestFactor ||
+					(focusFactor == bestFactor && widgetIndex < bestIndex) )
+				{
+					bestFactor	= focusFactor;
+					bestIndex	= widgetIndex;
+				}
+			}
+		}
+	}
+
+	*outFocusFactor = bestFactor;
+	return bestIndex != IMUI_SIZE_MAX ? candidates->widgets[ bestIndex ] : NULL;
+}
+
+static void imuiWindowUpdateFocusCandidates( ImuiWindow* window, ImuiPos direction, ImuiInputShortcut shortcut )
+{
+	ImuiFocusCandidates* candidates = &window->context->focusCandidates;
+	if( candidates->widgetCount == 0u )
+	{
+		return;
+	}
+
+	if( direction.x != 0.0f || direction.y != 0.0f )
+	{
+		const bool hasGrid = candidates->widgetCount >= IMUI_DEFAULT_FOCUS_GRID_CELL_WIDGET_COUNT * 4u &&
+			imuiFocusCandidatesBuildGrid( candidates, &window->context->allocator );
+
+		window->closesFocusWidget = imuiWindowFindFocusWidget( window, hasGrid, window->focusPoint, direction, &window->closesFocusWidgetFactor );
+
+		// wrapping is only used if there is no candidate in the direction
+		if( !window->closesFocusWidget && window->focusWrap )
+		{
+			window->wrapFocusWidget = imuiWindowFindFocusWidget( window, hasGrid, window->focusWrapPoint, direction, &window->wrapFocusWidgetFactor );
+		}
+	}
+
+	if( shortcut == ImuiInputShortcut_FocusNext )
+	{
+		const uint32 currentFocusIndex = window->focusWidget ? window->focusWidget->focusIndex : 0;
+		for( uintsize i = 0u; i < candidates->widgetCount; ++i )
+		{
+			ImuiWidget* widget = candidates->widgets[ i ];
+			const uint32 closesFocusIndex = window->closesFocusIndexWidget ? window->closesFocusIndexWidget->focusIndex : 0xffffffffu;
+
+			if( widget->focusIndex > currentFocusIndex && widget->focusIndex < closesFocusIndex )
+			{
+				window->closesFocusIndexWidget = widget;
+			}
+
+			if( !window->wrapFocusIndexWidget || widget->focusIndex < window->wrapFocusIndexWidget->focusIndex )
+			{
+				window->wrapFocusIndexWidget = widget;
+			}
+		}
+	}
+	else if( shortcut == ImuiInputShortcut_FocusPrevious )
+	{
+		const uint32 currentFocusIndex = window->focusWidget ? window->focusWidget->focusIndex : 0;
+		for( uintsize i = 0u; i < candidates->widgetCount; ++i )
+		{
+			ImuiWidget* widget = candidates->widgets[ i ];
+			const uint32 closesFocusIndex = window->closesFocusIndexWidget ? window->closesFocusIndexWidget->focusIndex : 0;
+
+			if( widget->focusIndex < currentFocusIndex && widget->focusIndex > closesFocusIndex )
+			{
+				window->closesFocusIndexWidget = widget;
+			}
+
+			if( !window->wrapFocusIndexWidget || widget->focusIndex > window->wrapFocusIndexWidget->focusIndex )
+			{
+				window->wrapFocusIndexWidget = widget;
+			}
+		}
+	}
+}
+
 static ImuiWidget* imuiWidgetAlloc( ImuiContext* imui )
 {
 	if( imui->firstChunk == NULL ||
@@ -622,7 +1048,7 @@ static ImuiWidget* imuiWidgetAlloc( ImuiContext* imui )
 		}
 		else
 		{
-			ImuiWidgetChunk* newChunk = IMUI_MEMORY_NEW( &imui->allocator, ImuiWidgetChunk );
+			ImuiWidgetChunk* newChunk = IMUI_MEMORY_NEW( imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Widgets ), ImuiWidgetChunk );
 			if( newChunk == NULL )
 			{
 				return NULL;
@@ -640,6 +1066,8 @@ static ImuiWidget* imuiWidgetAlloc( ImuiContext* imui )
 
 	*widget = IMUI_DEFAULT_WIDGET;
 
+	IMUI_STATS_ADD( &imui->stats, widgetCount, 1u );
+
 	return widget;
 }
 
@@ -887,71 +1315,15 @@ static void imuiWidgetLayout( ImuiWidget* widget, const ImuiRect* parentInnerRec
 	}
 
 	ImuiWindow* window = widget->window;
-	if( widget->canHaveFocus && window->hasFocus && widget != window->focusWidget )
+	if( widget->canHaveFocus && window->hasFocusQuery && widget != window->focusWidget )
 	{
-		const ImuiPos focusDirection	= imuiInputGetDirection( window->surface->input );
-		const ImuiPos center			= imuiRectGetCenter( widget->rect );
-
-		const ImuiPos distance			= imuiPosSubPos( center, window->focusPoint );
-		const float distanceLength		= sqrtf( (distance.x * distance.x) + (distance.y * distance.y) );
-		const ImuiPos direction			= imuiPosScale( distance, 1.0f / distanceLength );
-
-		const float angleFactor			= (direction.x * focusDirection.x) + (direction.y * focusDirection.y);
-		const float distanceFactor		= 1.0f - (distanceLength / window->diagonalLength);
-		const float focusFactor			= (angleFactor * angleFactor) + (distanceFactor * distanceFactor);
-
-		if( angleFactor > window->focusAngleThreshold && focusFactor > window->closesFocusWidgetFactor )
+		ImuiFocusCandidates* candidates = &window->context->focusCandidates;
+		if( IMUI_MEMORY_ARRAY_CHECK_CAPACITY( &window->context->allocator, candidates->widgets, candidates->widgetCapacity, candidates->widgetCount + 1u ) &&
+			IMUI_MEMORY_ARRAY_CHECK_CAPACITY( &window->context->allocator, candidates->centers, candidates->centerCapacity, candidates->widgetCount + 1u ) )
 		{
-			window->closesFocusWidgetFactor		= focusFactor;
-			window->closesFocusWidget			= widget;
-		}
-		else
-		{
-			const ImuiPos wrapDistance		= imuiPosSubPos( center, window->focusWrapPoint );
-			const float wrapDistanceLength	= sqrtf( (wrapDistance.x * wrapDistance.x) + (wrapDistance.y * wrapDistance.y) );
-			const ImuiPos wrapDirection		= imuiPosScale( wrapDistance, 1.0f / wrapDistanceLength );
-
-			const float wrapAngleFactor		= (wrapDirection.x * focusDirection.x) + (wrapDirection.y * focusDirection.y);
-			const float wrapDistanceFactor	= 1.0f - (wrapDistanceLength / window->diagonalLength);
-			const float wrapFocusFactor		= (wrapAngleFactor * wrapAngleFactor) + (wrapDistanceFactor * wrapDistanceFactor);
-
-			if( wrapAngleFactor > window->focusAngleThreshold && wrapFocusFactor > window->wrapFocusWidgetFactor )
-			{
-				window->wrapFocusWidgetFactor	= wrapFocusFactor;
-				window->wrapFocusWidget			= widget;
-			}
-		}
-
-		const ImuiInputShortcut shortcut = imuiInputGetShortcut( window->surface->input );
-		if( shortcut == ImuiInputShortcut_FocusNext )
-		{
-			const uint32 currentFocusIndex = window->focusWidget ? window->focusWidget->focusIndex : 0;
-			const uint32 closesFocusIndex = window->closesFocusIndexWidget ? window->closesFocusIndexWidget->focusIndex : 0xffffffffu;
-
-			if( widget->focusIndex > currentFocusIndex && widget->focusIndex < closesFocusIndex )
-			{
-				window->closesFocusIndexWidget = widget;
-			}
-
-			if( !window->wrapFocusIndexWidget || widget->focusIndex < window->wrapFocusIndexWidget->focusIndex )
-			{
-				window->wrapFocusIndexWidget = widget;
-			}
-		}
-		else if( shortcut == ImuiInputShortcut_FocusPrevious )
-		{
-			const uint32 currentFocusIndex = window->focusWidget ? window->focusWidget->focusIndex : 0;
-			const uint32 closesFocusIndex = window->closesFocusIndexWidget ? window->closesFocusIndexWidget->focusIndex : 0;
-
-			if( widget->focusIndex < currentFocusIndex && widget->focusIndex > closesFocusIndex )
-			{
-				window->closesFocusIndexWidget = widget;
-			}
-
-			if( !window->wrapFocusIndexWidget || widget->focusIndex > window->wrapFocusIndexWidget->focusIndex )
-			{
-				window->wrapFocusIndexWidget = widget;
-			}
+			candidates->widgets[ candidates->widgetCount ]	= widget;
+			candidates->centers[ candidates->widgetCount ]	= imuiRectGetCenter( widget->rect );
+			candidates->widgetCount++;
 		}
 	}
 }
@@ -1385,6 +1757,11 @@ double imuiWidgetGetTime( const ImuiWidget* widget )
 	return widget->window->context->frame.timeInSeconds;
 }
 
+void imuiWidgetRequestUpdate( ImuiWidget* widget, double timeInSeconds )
+{
+	imuiWindowRequestUpdate( widget->window, timeInSeconds );
+}
+
 float imuiWidgetGetDpiScale( const ImuiWidget* widget )
 {
 	return widget->window->surface->dpiScale;
@@ -1492,11 +1869,13 @@ void* imuiWidgetAllocStateNewDestruct( ImuiWidget* widget, size_t size, ImuiId s
 				*isNew = false;
 			}
 
+			IMUI_STATS_ADD( &imui->stats, stateReuseCount, 1u );
+
 			return lastFrameState->data;
 		}
 	}
 
-	ImuiWidgetState* newState = (ImuiWidgetState*)imuiMemoryAllocZero( &widget->window->context->allocator, IMUI_OFFSETOF( ImuiWidgetState, data ) + size );
+	ImuiWidgetState* newState = (ImuiWidgetState*)imuiMemoryAllocZero( imuiStatsGetAllocator( &widget->window->context->stats, ImuiMemoryTag_States ), IMUI_OFFSETOF( ImuiWidgetState, data ) + size );
 	if( !newState )
 	{
 		return NULL;
@@ -1506,6 +1885,8 @@ void* imuiWidgetAllocStateNewDestruct( ImuiWidget* widget, size_t size, ImuiId s
 	newState->size				= size;
 	newState->destructFunc		= destructFunc;
 
+	IMUI_STATS_ADD( &imui->stats, stateAllocationCount, 1u );
+
 	// usage list
 	{
 		newState->nextUsageState = imui->firstState;
@@ -1835,41 +2216,144 @@ ImuiRect imuiWidgetGetInnerRect( const ImuiWidget* widget )
 	return imuiRectShrinkBorder( widget->rect, widget->padding );
 }
 
-void imuiWidgetGetInputState( ImuiWidget* widget, ImuiWidgetInputState* target )
+static void imuiSurfaceUpdateHitTest( const ImuiSurface* surface, ImuiPos pos, ImuiSurfaceHitTest* hitTest )
 {
-	ImuiWindow* window = widget->window;
-	ImuiSurface* surface = window->surface;
-	ImuiContext* imui = window->context;
-	const ImuiInputState* input = surface->input;
+	hitTest->valid	= true;
+	hitTest->window	= NULL;
+	hitTest->zOrder	= 0u;
+	hitTest->count	= 0u;
 
-	bool hasOverlappingWindow = false;
-	if( surface->windowCount > 1u )
+	for( uintsize i = 0; i < surface->windowCount; ++i )
 	{
-		for( uintsize i = 0; i < surface->windowCount && !hasOverlappingWindow; ++i )
+		const ImuiWindow* window = &surface->windows[ i ];
+		if( !imuiRectIncludesPos( window->rect, pos ) )
 		{
-			const ImuiWindow* testWindow = &surface->windows[ i ];
-			if( testWindow == window ||
-				testWindow->zOrder < window->zOrder )
-			{
-				continue;
-			}
+			continue;
+		}
+
+		if( !hitTest->window ||
+			window->zOrder > hitTest->zOrder )
+		{
+			hitTest->window	= window;
+			hitTest->zOrder	= window->zOrder;
+			hitTest->count	= 1u;
+		}
+		else if( window->zOrder == hitTest->zOrder )
+		{
+			hitTest->count++;
+		}
+	}
+}
+
+// index 0 is the mouse position and index i + 1 the position of input event i
+static const ImuiSurfaceHitTest* imuiSurfaceGetHitTest( ImuiSurface* surface, uintsize index, ImuiPos pos, ImuiSurfaceHitTest* fallback )
+{
+	if( !surface->hitTestValid )
+	{
+		const uintsize count = surface->input->eventCount + 1u;
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( &surface->context->allocator, surface->hitTests, surface->hitTestCapacity, count ) )
+		{
+			imuiSurfaceUpdateHitTest( surface, pos, fallback );
+			return fallback;
+		}
+
+		for( uintsize i = 0u; i < count; ++i )
+		{
+			surface->hitTests[ i ].valid = false;
+		}
+		surface->hitTestValid = true;
+	}
+
+	ImuiSurfaceHitTest* hitTest = &surface->hitTests[ index ];
+	if( !hitTest->valid )
+	{
+		imuiSurfaceUpdateHitTest( surface, pos, hitTest );
+	}
+
+	return hitTest;
+}
+
+static bool imuiWindowIsCoveredAt( const ImuiWindow* window, uintsize hitTestIndex, ImuiPos pos )
+{
+	ImuiSurfaceHitTest fallback;
+	const ImuiSurfaceHitTest* hitTest = imuiSurfaceGetHitTest( window->surface, hitTestIndex, pos, &fallback );
+
+	// covered by any other window at the position with the same or a higher z-order
+	if( !hitTest->window ||
+		hitTest->zOrder < window->zOrder )
+	{
+		return false;
+	}
+	else if( hitTest->zOrder > window->zOrder )
+	{
+		return true;
+	}
+
+	return hitTest->count > 1u || hitTest->window != window;
+}
+
+static void imuiWidgetGetInputEventState( const ImuiWidget* widget, const ImuiInputState* input, bool* hasPressed, bool* hasReleased )
+{
+	// replay left button events at the position they happened so a press and release within one frame isn't lost
+	bool isDown = input->last.mouseButtons[ ImuiInputMouseButton_Left ];
+	for( uintsize i = 0u; i < input->eventCount; ++i )
+	{
+		const ImuiInputEvent* event = imuiInputGetEvent( input, i );
+		if( (event->type != ImuiInputEventType_MouseDown && event->type != ImuiInputEventType_MouseUp) ||
+			event->code != ImuiInputMouseButton_Left )
+		{
+			continue;
+		}
+
+		const bool eventIsDown = event->type == ImuiInputEventType_MouseDown;
+		if( eventIsDown == isDown )
+		{
+			continue;
+		}
+		isDown = eventIsDown;
 
-			hasOverlappingWindow |= imuiRectIncludesPos( testWindow->rect, input->current.mousePos );
+		if( !imuiRectIncludesPos( widget->clipRect, event->data.pos ) ||
+			imuiWindowIsCoveredAt( widget->window, i + 1u, event->data.pos ) )
+		{
+			continue;
 		}
+
+		*hasPressed		|= eventIsDown;
+		*hasReleased	|= !eventIsDown;
 	}
+}
+
+void imuiWidgetGetInputState( ImuiWidget* widget, ImuiWidgetInputState* target )
+{
+	ImuiWindow* window = widget->window;
+	ImuiSurface* surface = window->surface;
+	ImuiContext* imui = window->context;
+	const ImuiInputState* input = surface->input;
+
+	const bool hasOverlappingWindow = imuiWindowIsCoveredAt( window, 0u, input->current.mousePos );
 
 	target->relativeMousePos	= imuiPosSubPos( input->current.mousePos, widget->rect.pos );
 
 	target->hasFocus			= window->focusWidget == widget;
 	target->isMouseOver			= !hasOverlappingWindow && imuiRectIncludesPos( widget->clipRect, input->current.mousePos );
 	target->isMouseDown			= target->isMouseOver && input->current.mouseButtons[ ImuiInputMouseButton_Left ];
-	target->hasMousePressed		= target->isMouseOver && imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left );
-	target->hasMouseReleased	= target->isMouseOver && imuiInputHasMouseButtonReleased( input, ImuiInputMouseButton_Left );
 
-	if( (input->current.mouseButtons[ ImuiInputMouseButton_Left ] || input->last.mouseButtons[ ImuiInputMouseButton_Left ]) &&
+	if( input->mouseButtonTransitions[ ImuiInputMouseButton_Left ] && !input->eventsLost )
+	{
+		target->hasMousePressed		= false;
+		target->hasMouseReleased	= false;
+		imuiWidgetGetInputEventState( widget, input, &target->hasMousePressed, &target->hasMouseReleased );
+	}
+	else
+	{
+		target->hasMousePressed		= target->isMouseOver && imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left );
+		target->hasMouseReleased	= target->isMouseOver && imuiInputHasMouseButtonReleased( input, ImuiInputMouseButton_Left );
+	}
+
+	if( (input->current.mouseButtons[ ImuiInputMouseButton_Left ] || input->last.mouseButtons[ ImuiInputMouseButton_Left ] || input->mouseButtonTransitions[ ImuiInputMouseButton_Left ]) &&
 		widget->inputContext.lastFrameIndex >= imui->frame.index - 1u )
 	{
-		widget->inputContext.wasPressed	|= target->isMouseOver && imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left );
+		widget->inputContext.wasPressed		|= target->hasMousePressed;
 		widget->inputContext.wasMouseOver	|= target->isMouseOver;
 	}
 	else
@@ -1916,11 +2400,19 @@ void imuiWidgetDrawSkin( ImuiWidget* widget, const ImuiSkin* skin, ImuiColor col
 {
 	IMUI_ASSERT( skin );
 
+	const ImuiSkinDescriptor descriptor = imuiSkinDescriptorCreate( skin );
+	imuiWidgetDrawSkinDescriptor( widget, &descriptor, color );
+}
+
+void imuiWidgetDrawSkinDescriptor( ImuiWidget* widget, const ImuiSkinDescriptor* skin, ImuiColor color )
+{
+	IMUI_ASSERT( skin );
+
 	ImuiDrawElement* element = imuiDrawPushElement( widget, ImuiDrawElementType_Skin, skin->textureHandle );
 	struct ImuiDrawElementDataSkin* skinData = &element->data.skin;
 	skinData->border	= skin->border;
 	skinData->uv		= skin->uv;
-	skinData->texSize	= imuiSizeCreateSkin( skin );
+	skinData->centerUv	= skin->centerUv;
 	skinData->color		= color;
 }
 
@@ -1973,12 +2465,20 @@ void imuiWidgetDrawPartialSkin( ImuiWidget* widget, ImuiRect relativRect, const
 {
 	IMUI_ASSERT( skin );
 
+	const ImuiSkinDescriptor descriptor = imuiSkinDescriptorCreate( skin );
+	imuiWidgetDrawPartialSkinDescriptor( widget, relativRect, &descriptor, color );
+}
+
+void imuiWidgetDrawPartialSkinDescriptor( ImuiWidget* widget, ImuiRect relativRect, const ImuiSkinDescriptor* skin, ImuiColor color )
+{
+	IMUI_ASSERT( skin );
+
 	ImuiDrawElement* element = imuiDrawPushElement( widget, ImuiDrawElementType_SkinPartial, skin->textureHandle );
 	struct ImuiDrawElementDataSkin* skinData = &element->data.skin;
 	skinData->relativRect	= relativRect;
 	skinData->border		= skin->border;
 	skinData->uv			= skin->uv;
-	skinData->texSize		= imuiSizeCreateSkin( skin );
+	skinData->centerUv		= skin->centerUv;
 	skinData->color			= color;
 }
 
@@ -2026,7 +2526,7 @@ static void imuiWidgetStateFreeList( ImuiAllocator* allocator, ImuiWidgetState*
 
 		if( state->destructFunc )
 		{
-			state->destructFunc( state );
+			state->destructFunc( state->data );
 		}
 		imuiMemoryFree( allocator, state );
 		state = nextState;
@@ -478,6 +478,45 @@ namespace imui
 		imuiInputSetMouseCursor( m_context, cursor );
 	}
 
+	bool UiContext::getNextUpdateTime( double& timeInSeconds ) const
+	{
+		return imuiGetNextUpdateTime( m_context, &timeInSeconds );
+	}
+
+	bool UiContext::isIdle( double timeInSeconds ) const
+	{
+		return imuiIsIdle( m_context, timeInSeconds );
+	}
+
+	ImuiFrameStats UiContext::getFrameStats() const
+	{
+		ImuiFrameStats stats;
+		imuiGetFrameStats( m_context, &stats );
+		return stats;
+	}
+
+	bool UiContext::beginTrace( size_t maxEventCount )
+	{
+		return imuiTraceBegin( m_context, maxEventCount );
+	}
+
+	void UiContext::endTrace()
+	{
+		imuiTraceEnd( m_context );
+	}
+
+	size_t UiContext::writeTrace( char* buffer, size_t bufferSize ) const
+	{
+		return imuiTraceWrite( m_context, buffer, bufferSize );
+	}
+
+	ImuiMemoryTagStats UiContext::getMemoryStats( ImuiMemoryTag tag ) const
+	{
+		ImuiMemoryTagStats stats;
+		imuiGetMemoryStats( m_context, tag, &stats );
+		return stats;
+	}
+
 	UiFrame::UiFrame()
 		: m_owner( false )
 		, m_frame( nullptr )
@@ -561,6 +600,21 @@ namespace imui
 		return imuiInputGetMouseScrollDelta( m_state );
 	}
 
+	size_t UiInputState::getEventCount() const
+	{
+		return imuiInputGetEventCount( m_state );
+	}
+
+	const ImuiInputEvent& UiInputState::getEvent( size_t index ) const
+	{
+		return *imuiInputGetEvent( m_state, index );
+	}
+
+	bool UiInputState::hasLostEvents() const
+	{
+		return imuiInputHasLostEvents( m_state );
+	}
+
 	UiFrame::UiFrame( ImuiFrame* frame )
 		: m_owner( false )
 		, m_frame( frame )
@@ -686,6 +740,16 @@ namespace imui
 		return m_surface->dpiScale;
 	}
 
+	bool UiSurface::isDirty() const
+	{
+		return imuiSurfaceIsDirty( m_surface );
+	}
+
+	const ImuiRect* UiSurface::getDamageRects( size_t& count ) const
+	{
+		return imuiSurfaceGetDamageRects( m_surface, &count );
+	}
+
 	UiWindow::UiWindow()
 		: m_owner( false )
 		, m_window( nullptr )
@@ -765,6 +829,11 @@ namespace imui
 		return imuiWindowGetTime( m_window );
 	}
 
+	void UiWindow::requestUpdate( double timeInSeconds )
+	{
+		imuiWindowRequestUpdate( m_window, timeInSeconds );
+	}
+
 	void* UiWindow::allocState( size_t size, ImuiId stateId )
 	{
 		return imuiWindowAllocState( m_window, size, stateId );
@@ -927,6 +996,11 @@ namespace imui
 		return imuiWidgetGetTime( m_widget );
 	}
 
+	void UiWidget::requestUpdate( double timeInSeconds )
+	{
+		imuiWidgetRequestUpdate( m_widget, timeInSeconds );
+	}
+
 	UiBorder UiWidget::getMargin() const
 	{
 		return (const UiBorder&)m_widget->margin;
@@ -1231,70 +1305,88 @@ namespace imui
 	}
 
 	toolbox::UiToolboxConfigFloatScope::UiToolboxConfigFloatScope( float& value, float newValue, bool active /* = true */ )
-		: m_value( value )
+		: m_active( active )
 	{
-		IMUI_ASSERT( (void*)&value >= imuiToolboxThemeGet() && (void*)&value < imuiToolboxThemeGet() + 1u );
-
-		m_oldValue = m_value;
-		m_value = active ? newValue : m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePushFloat( &value, newValue );
+		}
 	}
 
 	toolbox::UiToolboxConfigFloatScope::~UiToolboxConfigFloatScope()
 	{
-		m_value = m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePop( 1u );
+		}
 	}
 
 	toolbox::UiToolboxConfigColorScope::UiToolboxConfigColorScope( ImuiToolboxColor color, const ImuiColor& newValue, bool active /* = true */ )
-		: m_color( color )
+		: m_active( active )
 	{
-		ImuiColor& valueRef = imuiToolboxThemeGet()->colors[ m_color ];
-		m_oldValue = valueRef;
-		valueRef = active ? newValue : m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePushColor( color, newValue );
+		}
 	}
 
 	toolbox::UiToolboxConfigColorScope::~UiToolboxConfigColorScope()
 	{
-		imuiToolboxThemeGet()->colors[ m_color ] = m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePop( 1u );
+		}
 	}
 
 	toolbox::UiToolboxConfigSkinScope::UiToolboxConfigSkinScope( ImuiToolboxSkin skin, const ImuiSkin& newValue, bool active /* = true */ )
-		: m_skin( skin )
+		: m_active( active )
 	{
-		ImuiSkin& valueRef = imuiToolboxThemeGet()->skins[ m_skin ];
-		m_oldValue = valueRef;
-		valueRef = active ? newValue : m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePushSkin( skin, &newValue );
+		}
 	}
 
 	toolbox::UiToolboxConfigSkinScope::~UiToolboxConfigSkinScope()
 	{
-		imuiToolboxThemeGet()->skins[ m_skin ] = m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePop( 1u );
+		}
 	}
 
 	toolbox::UiToolboxConfigIconScope::UiToolboxConfigIconScope( ImuiToolboxIcon icon, const ImuiImage& newValue, bool active /* = true */ )
-		: m_icon( icon )
+		: m_active( active )
 	{
-		ImuiImage& valueRef = imuiToolboxThemeGet()->icons[ m_icon ];
-		m_oldValue = valueRef;
-		valueRef = active ? newValue : m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePushIcon( icon, &newValue );
+		}
 	}
 
 	toolbox::UiToolboxConfigIconScope::~UiToolboxConfigIconScope()
 	{
-		imuiToolboxThemeGet()->icons[ m_icon ] = m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePop( 1u );
+		}
 	}
 
 	toolbox::UiToolboxConfigBorderScope::UiToolboxConfigBorderScope( ImuiBorder& value, UiBorder newValue, bool active /* = true */ )
-		: m_value( value )
+		: m_active( active )
 	{
-		IMUI_ASSERT( (void*)&value >= imuiToolboxThemeGet() && (void*)&value < imuiToolboxThemeGet() + 1u );
-
-		m_oldValue = m_value;
-		m_value = active ? newValue : m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePushBorder( &value, newValue );
+		}
 	}
 
 	toolbox::UiToolboxConfigBorderScope::~UiToolboxConfigBorderScope()
 	{
-		m_value = m_oldValue;
+		if( m_active )
+		{
+			imuiToolboxThemePop( 1u );
+		}
 	}
 
 	toolbox::UiToolboxWindow::UiToolboxWindow()
@@ -1385,6 +1477,21 @@ namespace imui
 		va_end( args );
 	}
 
+	void toolbox::UiToolboxWindow::labelInt( int64_t value )
+	{
+		imuiToolboxLabelInt( m_window, value );
+	}
+
+	void toolbox::UiToolboxWindow::labelUInt( uint64_t value )
+	{
+		imuiToolboxLabelUInt( m_window, value );
+	}
+
+	void toolbox::UiToolboxWindow::labelFloat( double value, uint32_t decimals )
+	{
+		imuiToolboxLabelFloat( m_window, value, decimals );
+	}
+
 	void toolbox::UiToolboxWindow::image( const ImuiImage& img )
 	{
 		image( img, UiSize( img ) );
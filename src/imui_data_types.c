@@ -70,7 +70,7 @@ ImuiHash imuiHashCreateSeed( const void* data, size_t dataSize, ImuiHash seed )
 	const uint8* bytes = (const uint8*)data;
 	for( uintsize i = dataSize >> 2; i; --i )
 	{
-		dataPart = *(uint32*)bytes;
+		memcpy( &dataPart, bytes, sizeof( dataPart ) );
 		bytes += sizeof( uint32 );
 
 		uint32 scramble = dataPart * 0xcc9e2d51;
@@ -522,6 +522,18 @@ ImuiRect imuiRectIntersection( ImuiRect rect1, ImuiRect rect2 )
 	return imuiRectCreateZero();
 }
 
+ImuiRect imuiRectUnion( ImuiRect rect1, ImuiRect rect2 )
+{
+	const ImuiPos rect1br	= imuiRectGetBottomRight( rect1 );
+	const ImuiPos rect2br	= imuiRectGetBottomRight( rect2 );
+	return imuiRectCreateMinMax(
+		IMUI_MIN( rect1.pos.x, rect2.pos.x ),
+		IMUI_MIN( rect1.pos.y, rect2.pos.y ),
+		IMUI_MAX( rect1br.x, rect2br.x ),
+		IMUI_MAX( rect1br.y, rect2br.y )
+	);
+}
+
 bool imuiRectIncludesPos( ImuiRect rect, ImuiPos pos )
 {
 	return pos.x >= rect.pos.x &&
@@ -627,3 +639,21 @@ ImuiColor imuiColorCreateTransparentBlack()
 {
 	return imuiColorCreate( 0u, 0u, 0u, 0u );
 }
+
+ImuiSkinDescriptor imuiSkinDescriptorCreate( const ImuiSkin* skin )
+{
+	IMUI_ASSERT( skin );
+
+	const float uScale = skin->width ? (skin->uv.u1 - skin->uv.u0) / skin->width : 0.0f;
+	const float vScale = skin->height ? (skin->uv.v1 - skin->uv.v0) / skin->height : 0.0f;
+
+	ImuiSkinDescriptor result;
+	result.textureHandle	= skin->textureHandle;
+	result.border			= skin->border;
+	result.uv				= skin->uv;
+	result.centerUv.u0		= skin->uv.u0 + (skin->border.left * uScale);
+	result.centerUv.v0		= skin->uv.v0 + (skin->border.top * vScale);
+	result.centerUv.u1		= skin->uv.u1 - (skin->border.right * uScale);
+	result.centerUv.v1		= skin->uv.v1 - (skin->border.bottom * vScale);
+	return result;
+}
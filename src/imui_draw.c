@@ -4,8 +4,16 @@
 #include "imui_internal.h"
 #include "imui_memory.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+typedef struct ImuiDrawDamageElement
+{
+	ImuiHash				key;		// element hash mixed with the window z order
+	uintsize				order;		// draw order in the surface
+	ImuiRect				bounds;
+} ImuiDrawDamageElement;
+
 typedef struct ImuiDrawSurfaceBuffers
 {
 	uint32*					indices;
@@ -37,6 +45,24 @@ struct ImuiDrawSurfaceData
 	ImuiDrawData			data;
 
 	ImuiDrawSurfaceBuffers*	buffers;
+
+	ImuiHash				signature;		// of all elements in the last finished surface
+	bool					hasSignature;
+	bool					isDirty;
+
+	ImuiDrawDamageElement*	damageElements;	// sorted by key and order, of the last dirty frame
+	uintsize				damageElementCapacity;
+	uintsize				damageElementCount;
+	ImuiDrawDamageElement*	nextDamageElements;
+	uintsize				nextDamageElementCapacity;
+	uintsize				nextDamageElementCount;
+	uintsize*				damageOrders;	// matching, longest ordered run and its links, three per element
+	uintsize				damageOrderCapacity;
+	ImuiSize				damageSize;
+	bool					hasDamageElements;
+
+	ImuiRect				damageRects[ IMUI_DEFAULT_DAMAGE_RECT_COUNT ];
+	uintsize				damageRectCount;
 };
 
 struct ImuiDrawWindowData
@@ -52,6 +78,17 @@ struct ImuiDrawWindowData
 	uintsize				elementCount;
 };
 
+// element with resolved widget rects, hashed to find out if anything changed
+typedef struct ImuiDrawElementSignature
+{
+	ImuiRect				rect;
+	ImuiRect				clipRect;
+	uint64_t				textureHandle;
+	uint32					type;
+	ImuiHash				textHash;
+	ImuiDrawElementData		data;
+} ImuiDrawElementSignature;
+
 typedef enum ImuiDrawSkinPointX
 {
 	ImuiDrawSkinPointX_Left,
@@ -75,11 +112,18 @@ typedef enum ImuiDrawSkinPointY
 static void					imuiDrawFreeWindow( ImuiDraw* draw, ImuiDrawWindowData* window );
 static void					imuiDrawFreeSurface( ImuiDraw* draw, ImuiDrawSurfaceData* surface );
 static ImuiDrawWindowData*	imuiDrawGetWindow( ImuiDraw* draw, ImuiWidget* widget );
+static ImuiHash				imuiDrawElementGetHash( const ImuiDrawElement* element );
+static ImuiRect				imuiDrawElementGetBounds( const ImuiDrawElement* element );
+static void					imuiDrawSurfaceUpdateDamage( ImuiDraw* draw, ImuiDrawSurfaceData* surface, bool hasElementKeys );
+static void					imuiDrawSurfaceAddDamage( ImuiDrawSurfaceData* surface, ImuiRect rect );
+static void					imuiDrawSurfaceDamageMovedElements( ImuiDrawSurfaceData* surface, uintsize* matches );
+static int					imuiDrawDamageElementCompare( const void* lhs, const void* rhs );
 static void					imuiDrawSurfaceGenerateElementData( ImuiDraw* draw, ImuiDrawSurfaceData* surface, const ImuiDrawElement* element );
 static ImuiRect				imuiDrawSurfaceGenerateWidgetRect( ImuiWidget* widget );
 static uint32				imuiDrawSurfacePushVertex( ImuiDraw* draw, ImuiDrawSurfaceData* surface, float x, float y, float u, float v, ImuiColor color );
 static void					imuiDrawSurfacePushIndices( ImuiDrawSurfaceBuffers* buffers, const uint32* indices, uintsize count );
 static uintsize				imuiDrawSurfacePushRect( ImuiDraw* draw, ImuiDrawSurfaceData* surface, ImuiPos posTl, ImuiPos posBr, ImuiTexCoord uv, ImuiColor color );
+static uintsize				imuiDrawSurfacePushSkin( ImuiDraw* draw, ImuiDrawSurfaceData* surface, const float* xPositions, const float* yPositions, ImuiTexCoord uv, ImuiTexCoord centerUv, ImuiColor color );
 static uintsize				imuiVertexElementTypeGetSize( ImuiVertexElementType type );
 
 #ifdef _DEBUG
@@ -94,10 +138,12 @@ static const bool s_supportedVertexElementSemanicFormats[][ ImuiVertexElementTyp
 };
 #endif
 
-bool imuiDrawConstruct( ImuiDraw* draw, ImuiAllocator* allocator, const ImuiVertexFormat* vertexFormat, ImuiVertexType vertexType )
+bool imuiDrawConstruct( ImuiDraw* draw, ImuiAllocator* allocator, ImuiStats* stats, const ImuiVertexFormat* vertexFormat, ImuiVertexType vertexType, bool trackChanges )
 {
 	draw->allocator		= allocator;
+	draw->stats			= stats;
 	draw->vertexType	= vertexType;
+	draw->trackChanges	= trackChanges;
 
 	switch( vertexType )
 	{
@@ -261,6 +307,64 @@ void imuiDrawSurfaceEnd( ImuiDraw* draw, uintsize surfaceIndex )
 			i--;
 		}
 	}
+
+	if( !draw->trackChanges )
+	{
+		// changes are not tracked, skip hashing and report the whole surface
+		surface->isDirty			= true;
+		surface->hasSignature		= false;
+		surface->hasDamageElements	= false;
+		surface->damageRectCount	= 0u;
+		imuiDrawSurfaceAddDamage( surface, imuiRectCreateSize( 0.0f, 0.0f, surface->size ) );
+		return;
+	}
+
+	uintsize elementCount = 0u;
+	for( uintsize i = 0u; i < surface->windowCount; ++i )
+	{
+		elementCount += draw->windows[ surface->windows[ i ] ].elementCount;
+	}
+
+	const bool hasElementKeys = IMUI_MEMORY_ARRAY_CHECK_CAPACITY( draw->allocator, surface->nextDamageElements, surface->nextDamageElementCapacity, elementCount );
+	surface->nextDamageElementCount = 0u;
+
+	ImuiHash signature = imuiHashCreate( &surface->size, sizeof( surface->size ) );
+	for( uintsize i = 0u; i < surface->windowCount; ++i )
+	{
+		const ImuiDrawWindowData* window = &draw->windows[ surface->windows[ i ] ];
+
+		const ImuiHash windowHash = imuiHashCreate( &window->zOrder, sizeof( window->zOrder ) );
+		for( uintsize elementIndex = 0u; elementIndex < window->elementCount; ++elementIndex )
+		{
+			const ImuiHash elementHash = imuiDrawElementGetHash( &window->elements[ elementIndex ] );
+			signature = imuiHashCreateSeed( &elementHash, sizeof( elementHash ), signature );
+
+			if( hasElementKeys )
+			{
+				ImuiDrawDamageElement* damageElement = &surface->nextDamageElements[ surface->nextDamageElementCount ];
+				damageElement->key		= imuiHashCreateSeed( &elementHash, sizeof( elementHash ), windowHash );
+				damageElement->order	= surface->nextDamageElementCount++;
+			}
+		}
+	}
+
+	surface->isDirty		= !surface->hasSignature || surface->signature != signature;
+	surface->signature		= signature;
+	surface->hasSignature	= true;
+
+	imuiDrawSurfaceUpdateDamage( draw, surface, hasElementKeys );
+}
+
+bool imuiDrawIsSurfaceDirty( const ImuiDraw* draw, uintsize surfaceIndex )
+{
+	return draw->surfaces[ surfaceIndex ].isDirty;
+}
+
+const ImuiRect* imuiDrawGetSurfaceDamageRects( const ImuiDraw* draw, uintsize surfaceIndex, uintsize* outCount )
+{
+	const ImuiDrawSurfaceData* surface = &draw->surfaces[ surfaceIndex ];
+	*outCount = surface->damageRectCount;
+	return surface->damageRects;
 }
 
 void imuiDrawEndFrame( ImuiDraw* draw )
@@ -330,6 +434,8 @@ ImuiDrawElement* imuiDrawPushElement( ImuiWidget* widget, ImuiDrawElementType ty
 		}
 	}
 
+	IMUI_STATS_ADD( draw->stats, drawElementCount, 1u );
+
 	ImuiDrawElement* element = &window->elements[ window->elementCount++ ];
 	element->type			= type;
 	element->textureHandle	= textureHandle;
@@ -344,7 +450,7 @@ ImuiDrawElement* imuiDrawPushElement( ImuiWidget* widget, ImuiDrawElementType ty
 	case ImuiDrawElementType_Rect:
 	case ImuiDrawElementType_RectPartial:	indexCount = 6u; vertexCount = 4u; break;
 	case ImuiDrawElementType_Skin:
-	case ImuiDrawElementType_SkinPartial:	indexCount = 54u; vertexCount = 36u; break;
+	case ImuiDrawElementType_SkinPartial:	indexCount = 54u; vertexCount = 16u; break;
 	case ImuiDrawElementType_Text:
 	case ImuiDrawElementType_TextOffset:	break;
 	}
@@ -390,6 +496,8 @@ void imuiDrawGetSurfaceMaxBufferSizes( ImuiDraw* draw, uintsize surfaceIndex, si
 
 const ImuiDrawData* imuiDrawGenerateSurfaceData( ImuiDraw* draw, uintsize surfaceIndex, void* outVertexData, size_t* inOutVertexDataSize, void* outIndexData, size_t* inOutIndexDataSize )
 {
+	IMUI_STATS_PHASE_BEGIN( draw->stats, startTime );
+
 	ImuiDrawSurfaceData* surface = &draw->surfaces[ surfaceIndex ];
 
 	IMUI_ASSERT( !inOutIndexDataSize || *inOutIndexDataSize >= surface->approximatedIndexCount * sizeof( uint32 ) );
@@ -472,8 +580,10 @@ const ImuiDrawData* imuiDrawGenerateSurfaceData( ImuiDraw* draw, uintsize surfac
 	surface->buffers = NULL;
 
 	ImuiDrawData* data = &surface->data;
-	data->commands		= surface->commands;
-	data->commandCount	= surface->commandCount;
+	data->commands			= surface->commands;
+	data->commandCount		= surface->commandCount;
+	data->damageRects		= surface->damageRects;
+	data->damageRectCount	= surface->damageRectCount;
 
 	if( inOutIndexDataSize )
 	{
@@ -481,6 +591,11 @@ const ImuiDrawData* imuiDrawGenerateSurfaceData( ImuiDraw* draw, uintsize surfac
 	}
 	*inOutVertexDataSize = buffers.vertexCount * draw->vertexSize;
 
+	IMUI_STATS_ADD( draw->stats, drawCommandCount, surface->commandCount );
+	IMUI_STATS_ADD( draw->stats, vertexCount, buffers.vertexCount );
+	IMUI_STATS_ADD( draw->stats, indexCount, buffers.indexCount );
+	IMUI_STATS_PHASE_END( draw->stats, startTime, ImuiFramePhase_DrawData );
+
 	return data;
 }
 
@@ -493,6 +608,9 @@ static void imuiDrawFreeSurface( ImuiDraw* draw, ImuiDrawSurfaceData* surface )
 {
 	IMUI_MEMORY_ARRAY_FREE( draw->allocator, surface->windows, surface->windowCapacity );
 	IMUI_MEMORY_ARRAY_FREE( draw->allocator, surface->commands, surface->commandCapacity );
+	IMUI_MEMORY_ARRAY_FREE( draw->allocator, surface->damageElements, surface->damageElementCapacity );
+	IMUI_MEMORY_ARRAY_FREE( draw->allocator, surface->nextDamageElements, surface->nextDamageElementCapacity );
+	IMUI_MEMORY_ARRAY_FREE( draw->allocator, surface->damageOrders, surface->damageOrderCapacity );
 }
 
 static ImuiDrawWindowData* imuiDrawGetWindow( ImuiDraw* draw, ImuiWidget* widget )
@@ -500,6 +618,334 @@ static ImuiDrawWindowData* imuiDrawGetWindow( ImuiDraw* draw, ImuiWidget* widget
 	return &draw->windows[ widget->window->drawIndex ];
 }
 
+static ImuiHash imuiDrawElementGetHash( const ImuiDrawElement* element )
+{
+	ImuiDrawElementSignature signature;
+	memset( &signature, 0, sizeof( signature ) );
+	signature.rect			= imuiDrawSurfaceGenerateWidgetRect( element->widget );
+	signature.clipRect		= element->widget->clipRect;
+	signature.textureHandle	= element->textureHandle;
+	signature.type			= (uint32)element->type;
+
+	switch( element->type )
+	{
+	case ImuiDrawElementType_Line:
+	case ImuiDrawElementType_Triangle:
+		signature.data.primitive = element->data.primitive;
+		break;
+
+	case ImuiDrawElementType_Rect:
+	case ImuiDrawElementType_RectPartial:
+		signature.data.rect = element->data.rect;
+		break;
+
+	case ImuiDrawElementType_Skin:
+	case ImuiDrawElementType_SkinPartial:
+		signature.data.skin = element->data.skin;
+		break;
+
+	case ImuiDrawElementType_Text:
+	case ImuiDrawElementType_TextOffset:
+		{
+			// layouts can be evicted and their memory reused, so use the key hash instead of the pointer
+			const ImuiTextLayout* layout = element->data.text.layout;
+			signature.textHash				= layout->hash;
+
+			signature.data.text.relativPos	= element->data.text.relativPos;
+			signature.data.text.color		= element->data.text.color;
+			signature.data.text.size		= element->data.text.size;
+		}
+		break;
+	}
+
+	return imuiHashCreate( &signature, sizeof( signature ) );
+}
+
+static ImuiRect imuiDrawElementGetBounds( const ImuiDrawElement* element )
+{
+	ImuiRect rect = imuiDrawSurfaceGenerateWidgetRect( element->widget );
+	switch( element->type )
+	{
+	case ImuiDrawElementType_Line:
+	case ImuiDrawElementType_Triangle:
+		{
+			const struct ImuiDrawElementDataPrimitive* primitiveData = &element->data.primitive;
+
+			ImuiPos minPos = imuiPosCreate( IMUI_MIN( primitiveData->p0.x, primitiveData->p1.x ), IMUI_MIN( primitiveData->p0.y, primitiveData->p1.y ) );
+			ImuiPos maxPos = imuiPosCreate( IMUI_MAX( primitiveData->p0.x, primitiveData->p1.x ), IMUI_MAX( primitiveData->p0.y, primitiveData->p1.y ) );
+			if( element->type == ImuiDrawElementType_Triangle )
+			{
+				minPos = imuiPosCreate( IMUI_MIN( minPos.x, primitiveData->p2.x ), IMUI_MIN( minPos.y, primitiveData->p2.y ) );
+				maxPos = imuiPosCreate( IMUI_MAX( maxPos.x, primitiveData->p2.x ), IMUI_MAX( maxPos.y, primitiveData->p2.y ) );
+			}
+			else
+			{
+				// lines are rasterized one pixel wide
+				maxPos = imuiPosAdd( maxPos, 1.0f, 1.0f );
+			}
+
+			rect = imuiRectCreateMinMax( rect.pos.x + minPos.x, rect.pos.y + minPos.y, rect.pos.x + maxPos.x, rect.pos.y + maxPos.y );
+		}
+		break;
+
+	case ImuiDrawElementType_RectPartial:
+	case ImuiDrawElementType_SkinPartial:
+		rect.pos.x	+= element->data.rect.relativRect.pos.x;
+		rect.pos.y	+= element->data.rect.relativRect.pos.y;
+		rect.size	= element->data.rect.relativRect.size;
+		break;
+
+	case ImuiDrawElementType_Rect:
+	case ImuiDrawElementType_Skin:
+		break;
+
+	case ImuiDrawElementType_Text:
+	case ImuiDrawElementType_TextOffset:
+		{
+			const struct ImuiDrawElementDataText* textData = &element->data.text;
+			if( element->type == ImuiDrawElementType_TextOffset )
+			{
+				rect.pos.x	+= textData->relativPos.x;
+				rect.pos.y	+= textData->relativPos.y;
+			}
+
+			const float scale = textData->size / textData->layout->font->fontSize;
+			if( textData->layout->glyphCount == 0u )
+			{
+				return imuiRectCreateZero();
+			}
+
+			ImuiPos minPos = imuiPosCreate( IMUI_FLOAT_INF, IMUI_FLOAT_INF );
+			ImuiPos maxPos = imuiPosCreate( -IMUI_FLOAT_INF, -IMUI_FLOAT_INF );
+			for( uintsize i = 0; i < textData->layout->glyphCount; ++i )
+			{
+				const ImuiTextGlyph* glyph = &textData->layout->glyphs[ i ];
+				minPos.x = IMUI_MIN( minPos.x, glyph->pos.x );
+				minPos.y = IMUI_MIN( minPos.y, glyph->pos.y );
+				maxPos.x = IMUI_MAX( maxPos.x, glyph->pos.x + glyph->size.width );
+				maxPos.y = IMUI_MAX( maxPos.y, glyph->pos.y + glyph->size.height );
+			}
+
+			rect = imuiRectCreateMinMax( rect.pos.x + (minPos.x * scale), rect.pos.y + (minPos.y * scale), rect.pos.x + (maxPos.x * scale), rect.pos.y + (maxPos.y * scale) );
+		}
+		break;
+	}
+
+	return imuiRectIntersection( rect, element->widget->clipRect );
+}
+
+static void imuiDrawSurfaceUpdateDamage( ImuiDraw* draw, ImuiDrawSurfaceData* surface, bool hasElementKeys )
+{
+	surface->damageRectCount = 0u;
+	if( !surface->isDirty )
+	{
+		// same elements as last time, keep the old list to diff against
+		return;
+	}
+
+	if( !hasElementKeys ||
+		!surface->hasDamageElements ||
+		surface->damageSize.width != surface->size.width ||
+		surface->damageSize.height != surface->size.height )
+	{
+		imuiDrawSurfaceAddDamage( surface, imuiRectCreateSize( 0.0f, 0.0f, surface->size ) );
+	}
+
+	surface->hasDamageElements	= false;
+	surface->damageSize			= surface->size;
+	if( !hasElementKeys )
+	{
+		return;
+	}
+
+	uintsize elementIndex = 0u;
+	for( uintsize i = 0u; i < surface->windowCount; ++i )
+	{
+		const ImuiDrawWindowData* window = &draw->windows[ surface->windows[ i ] ];
+		for( uintsize windowElementIndex = 0u; windowElementIndex < window->elementCount; ++windowElementIndex )
+		{
+			surface->nextDamageElements[ elementIndex++ ].bounds = imuiDrawElementGetBounds( &window->elements[ windowElementIndex ] );
+		}
+	}
+
+	if( surface->nextDamageElementCount > 1u )
+	{
+		qsort( surface->nextDamageElements, surface->nextDamageElementCount, sizeof( *surface->nextDamageElements ), imuiDrawDamageElementCompare );
+	}
+
+	// matches[ next order ] is the last order of the same element
+	const uintsize elementCount = surface->nextDamageElementCount;
+	uintsize* matches = NULL;
+	if( IMUI_MEMORY_ARRAY_CHECK_CAPACITY( draw->allocator, surface->damageOrders, surface->damageOrderCapacity, elementCount * 3u ) )
+	{
+		matches = surface->damageOrders;
+		for( uintsize i = 0u; i < elementCount; ++i )
+		{
+			matches[ i ] = IMUI_SIZE_MAX;
+		}
+	}
+	else
+	{
+		imuiDrawSurfaceAddDamage( surface, imuiRectCreateSize( 0.0f, 0.0f, surface->size ) );
+	}
+
+	// elements only in one of both frames appeared, disappeared or changed
+	const ImuiDrawDamageElement* lastElements = surface->damageElements;
+	const ImuiDrawDamageElement* nextElements = surface->nextDamageElements;
+	uintsize lastIndex = 0u;
+	uintsize nextIndex = 0u;
+	while( lastIndex < surface->damageElementCount || nextIndex < elementCount )
+	{
+		if( nextIndex == elementCount ||
+			(lastIndex < surface->damageElementCount && lastElements[ lastIndex ].key < nextElements[ nextIndex ].key) )
+		{
+			imuiDrawSurfaceAddDamage( surface, lastElements[ lastIndex++ ].bounds );
+		}
+		else if( lastIndex == surface->damageElementCount ||
+			nextElements[ nextIndex ].key < lastElements[ lastIndex ].key )
+		{
+			imuiDrawSurfaceAddDamage( surface, nextElements[ nextIndex++ ].bounds );
+		}
+		else
+		{
+			if( matches )
+			{
+				matches[ nextElements[ nextIndex ].order ] = lastElements[ lastIndex ].order;
+			}
+
+			lastIndex++;
+			nextIndex++;
+		}
+	}
+
+	if( matches )
+	{
+		imuiDrawSurfaceDamageMovedElements( surface, matches );
+	}
+
+	ImuiDrawDamageElement* tempElements = surface->damageElements;
+	const uintsize tempCapacity = surface->damageElementCapacity;
+	surface->damageElements				= surface->nextDamageElements;
+	surface->damageElementCapacity		= surface->nextDamageElementCapacity;
+	surface->damageElementCount			= surface->nextDamageElementCount;
+	surface->nextDamageElements			= tempElements;
+	surface->nextDamageElementCapacity	= tempCapacity;
+	surface->nextDamageElementCount		= 0u;
+	surface->hasDamageElements			= true;
+}
+
+static void imuiDrawSurfaceAddDamage( ImuiDrawSurfaceData* surface, ImuiRect rect )
+{
+	rect = imuiRectIntersection( rect, imuiRectCreateSize( 0.0f, 0.0f, surface->size ) );
+	if( rect.size.width <= 0.0f || rect.size.height <= 0.0f )
+	{
+		return;
+	}
+
+	// merge with overlapping rects. if all slots are used merge with the one which grows the least.
+	for( ;; )
+	{
+		uintsize mergeIndex = IMUI_SIZE_MAX;
+		float minGrowth = IMUI_FLOAT_INF;
+		for( uintsize i = 0u; i < surface->damageRectCount; ++i )
+		{
+			const ImuiRect damageRect = surface->damageRects[ i ];
+			if( imuiRectIntersectsRect( damageRect, rect ) )
+			{
+				mergeIndex = i;
+				break;
+			}
+
+			const ImuiRect unionRect = imuiRectUnion( damageRect, rect );
+			const float growth = (unionRect.size.width * unionRect.size.height) - (damageRect.size.width * damageRect.size.height);
+			if( surface->damageRectCount == IMUI_ARRAY_COUNT( surface->damageRects ) &&
+				growth < minGrowth )
+			{
+				mergeIndex	= i;
+				minGrowth	= growth;
+			}
+		}
+
+		if( mergeIndex == IMUI_SIZE_MAX )
+		{
+			break;
+		}
+
+		rect = imuiRectUnion( rect, surface->damageRects[ mergeIndex ] );
+		surface->damageRects[ mergeIndex ] = surface->damageRects[ --surface->damageRectCount ];
+	}
+
+	surface->damageRects[ surface->damageRectCount++ ] = rect;
+}
+
+static void imuiDrawSurfaceDamageMovedElements( ImuiDrawSurfaceData* surface, uintsize* matches )
+{
+	// elements outside of the longest run which kept its order changed their stacking. every pair which swapped
+	// has at least one element outside of the run, so the overlap of both gets damaged.
+	const uintsize elementCount = surface->nextDamageElementCount;
+	uintsize* runEnds	= matches + elementCount;			// next order of the smallest end of a run with length index + 1
+	uintsize* links		= matches + (elementCount * 2u);	// previous next order in the run
+	uintsize runLength	= 0u;
+	for( uintsize i = 0u; i < elementCount; ++i )
+	{
+		if( matches[ i ] == IMUI_SIZE_MAX )
+		{
+			continue;
+		}
+
+		uintsize min = 0u;
+		uintsize max = runLength;
+		while( min < max )
+		{
+			const uintsize mid = min + ((max - min) / 2u);
+			if( matches[ runEnds[ mid ] ] < matches[ i ] )
+			{
+				min = mid + 1u;
+			}
+			else
+			{
+				max = mid;
+			}
+		}
+
+		links[ i ]		= min > 0u ? runEnds[ min - 1u ] : IMUI_SIZE_MAX;
+		runEnds[ min ]	= i;
+		runLength		= IMUI_MAX( runLength, min + 1u );
+	}
+
+	if( runLength == 0u )
+	{
+		return;
+	}
+
+	for( uintsize i = runEnds[ runLength - 1u ]; i != IMUI_SIZE_MAX; i = links[ i ] )
+	{
+		matches[ i ] = IMUI_SIZE_MAX;
+	}
+
+	for( uintsize i = 0u; i < elementCount; ++i )
+	{
+		const ImuiDrawDamageElement* element = &surface->nextDamageElements[ i ];
+		if( matches[ element->order ] != IMUI_SIZE_MAX )
+		{
+			imuiDrawSurfaceAddDamage( surface, element->bounds );
+		}
+	}
+}
+
+static int imuiDrawDamageElementCompare( const void* lhs, const void* rhs )
+{
+	// equal elements keep their draw order, so duplicates are matched in order
+	const ImuiDrawDamageElement* lhsElement = (const ImuiDrawDamageElement*)lhs;
+	const ImuiDrawDamageElement* rhsElement = (const ImuiDrawDamageElement*)rhs;
+	if( lhsElement->key != rhsElement->key )
+	{
+		return lhsElement->key > rhsElement->key ? 1 : -1;
+	}
+
+	return (lhsElement->order > rhsElement->order) - (lhsElement->order < rhsElement->order);
+}
+
 static void imuiDrawSurfaceGenerateElementData( ImuiDraw* draw, ImuiDrawSurfaceData* surface, const ImuiDrawElement* element )
 {
 	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY_ZERO( draw->allocator, surface->commands, surface->commandCapacity, surface->commandCount + 1u ) )
@@ -586,81 +1032,23 @@ static void imuiDrawSurfaceGenerateElementData( ImuiDraw* draw, ImuiDrawSurfaceD
 		{
 			const struct ImuiDrawElementDataSkin* skinData = &element->data.skin;
 
-			const float uScale = skinData->texSize.width ? (skinData->uv.u1 - skinData->uv.u0) / skinData->texSize.width : 0.0f;
-			const float vScale = skinData->texSize.height ? (skinData->uv.v1 - skinData->uv.v0) / skinData->texSize.height : 0.0f;
-
-			ImuiBorder uvBorder = skinData->border;
-			uvBorder.top	*= vScale;
-			uvBorder.left	*= uScale;
-			uvBorder.bottom	*= vScale;
-			uvBorder.right	*= uScale;
-
 			const ImuiSize borderSize = imuiBorderGetMinSize( skinData->border );
 			const float xScale = rect.size.width >= borderSize.width ? 1.0f : rect.size.width / borderSize.width;
 			const float yScale = rect.size.height >= borderSize.height ? 1.0f : rect.size.height / borderSize.height;
 
-			const float xLeft			= rect.pos.x;
-			const float xCenterLeft		= xLeft + (skinData->border.left * xScale);
-			const float xRight			= xLeft + rect.size.width;
-			const float xCenterRight	= xRight - (skinData->border.right * xScale);
-			const float yTop			= rect.pos.y;
-			const float yCenterTop		= yTop + (skinData->border.top * yScale);
-			const float yBottom			= yTop + rect.size.height;
-			const float yCenterBottom	= yBottom - (skinData->border.bottom * yScale);
-
-			const float uLeft			= skinData->uv.u0;
-			const float uCenterLeft		= uLeft + uvBorder.left;
-			const float uRight			= skinData->uv.u1;
-			const float uCenterRight	= uRight - uvBorder.right;
-			const float vTop			= skinData->uv.v0;
-			const float vCenterTop		= vTop + uvBorder.top;
-			const float vBottom			= skinData->uv.v1;
-			const float vCenterBottom	= vBottom - uvBorder.bottom;
-
 			float xPositions[ 4u ];
-			xPositions[ 0u ] = xLeft;
-			xPositions[ 1u ] = xCenterLeft;
-			xPositions[ 2u ] = xCenterRight;
-			xPositions[ 3u ] = xRight;
+			xPositions[ 0u ] = rect.pos.x;
+			xPositions[ 1u ] = rect.pos.x + (skinData->border.left * xScale);
+			xPositions[ 3u ] = rect.pos.x + rect.size.width;
+			xPositions[ 2u ] = xPositions[ 3u ] - (skinData->border.right * xScale);
 
 			float yPositions[ 4u ];
-			yPositions[ 0u ] = yTop;
-			yPositions[ 1u ] = yCenterTop;
-			yPositions[ 2u ] = yCenterBottom;
-			yPositions[ 3u ] = yBottom;
-
-			float uPositions[ 4u ];
-			uPositions[ 0u ] = uLeft;
-			uPositions[ 1u ] = uCenterLeft;
-			uPositions[ 2u ] = uCenterRight;
-			uPositions[ 3u ] = uRight;
-
-			float vPositions[ 4u ];
-			vPositions[ 0u ] = vTop;
-			vPositions[ 1u ] = vCenterTop;
-			vPositions[ 2u ] = vCenterBottom;
-			vPositions[ 3u ] = vBottom;
-
-			for( uintsize y = 0; y < ImuiDrawSkinPointY_END; ++y )
-			{
-				const uintsize nextY = y + 1u;
-
-				for( uintsize x = 0; x < ImuiDrawSkinPointX_END; ++x )
-				{
-					const uintsize nextX = x + 1u;
-
-					const ImuiPos posTl = imuiPosCreate( xPositions[ x ], yPositions[ y ] );
-					const ImuiPos posBr = imuiPosCreate( xPositions[ nextX ], yPositions[ nextY ] );
-
-					ImuiTexCoord uv;
-					uv.u0 = uPositions[ x ];
-					uv.v0 = vPositions[ y ];
-					uv.u1 = uPositions[ nextX ];
-					uv.v1 = vPositions[ nextY ];
+			yPositions[ 0u ] = rect.pos.y;
+			yPositions[ 1u ] = rect.pos.y + (skinData->border.top * yScale);
+			yPositions[ 3u ] = rect.pos.y + rect.size.height;
+			yPositions[ 2u ] = yPositions[ 3u ] - (skinData->border.bottom * yScale);
 
-					command->count += imuiDrawSurfacePushRect( draw, surface, posTl, posBr, uv, skinData->color );
-				}
-			}
+			command->count += imuiDrawSurfacePushSkin( draw, surface, xPositions, yPositions, skinData->uv, skinData->centerUv, skinData->color );
 		}
 		break;
 
@@ -1263,3 +1651,94 @@ static uintsize imuiDrawSurfacePushRect( ImuiDraw* draw, ImuiDrawSurfaceData* su
 
 	return 0u;
 }
+
+static uintsize imuiDrawSurfacePushSkin( ImuiDraw* draw, ImuiDrawSurfaceData* surface, const float* xPositions, const float* yPositions, ImuiTexCoord uv, ImuiTexCoord centerUv, ImuiColor color )
+{
+	if( xPositions[ ImuiDrawSkinPointX_Right ] - xPositions[ ImuiDrawSkinPointX_Left ] <= 0.0f ||
+		yPositions[ ImuiDrawSkinPointY_Bottom ] - yPositions[ ImuiDrawSkinPointY_Top ] <= 0.0f )
+	{
+		return 0u;
+	}
+
+	const float uPositions[] = { uv.u0, centerUv.u0, centerUv.u1, uv.u1 };
+	const float vPositions[] = { uv.v0, centerUv.v0, centerUv.v1, uv.v1 };
+
+	switch( draw->triangleTopology )
+	{
+	case ImuiDrawTopology_LineList:
+		break;
+
+	case ImuiDrawTopology_TriangleList:
+		{
+			uintsize count = 0u;
+			for( uintsize y = 0u; y < ImuiDrawSkinPointY_END; ++y )
+			{
+				for( uintsize x = 0u; x < ImuiDrawSkinPointX_END; ++x )
+				{
+					const ImuiPos posTl = imuiPosCreate( xPositions[ x ], yPositions[ y ] );
+					const ImuiPos posBr = imuiPosCreate( xPositions[ x + 1u ], yPositions[ y + 1u ] );
+
+					ImuiTexCoord sliceUv;
+					sliceUv.u0 = uPositions[ x ];
+					sliceUv.v0 = vPositions[ y ];
+					sliceUv.u1 = uPositions[ x + 1u ];
+					sliceUv.v1 = vPositions[ y + 1u ];
+
+					count += imuiDrawSurfacePushRect( draw, surface, posTl, posBr, sliceUv, color );
+				}
+			}
+			return count;
+		}
+
+	case ImuiDrawTopology_IndexedTriangleList:
+		{
+			// the slices share their corners, so 16 vertices cover all of them
+			uint32 vertexIndices[ 16u ];
+			for( uintsize y = 0u; y <= ImuiDrawSkinPointY_END; ++y )
+			{
+				for( uintsize x = 0u; x <= ImuiDrawSkinPointX_END; ++x )
+				{
+					vertexIndices[ (y * 4u) + x ] = imuiDrawSurfacePushVertex( draw, surface, xPositions[ x ], yPositions[ y ], uPositions[ x ], vPositions[ y ], color );
+				}
+			}
+
+			uint32 indices[ 54u ];
+			uintsize indexCount = 0u;
+			for( uintsize y = 0u; y < ImuiDrawSkinPointY_END; ++y )
+			{
+				if( yPositions[ y + 1u ] - yPositions[ y ] <= 0.0f )
+				{
+					continue;
+				}
+
+				for( uintsize x = 0u; x < ImuiDrawSkinPointX_END; ++x )
+				{
+					if( xPositions[ x + 1u ] - xPositions[ x ] <= 0.0f )
+					{
+						continue;
+					}
+
+					const uint32 indexTl = vertexIndices[ (y * 4u) + x ];
+					const uint32 indexTr = vertexIndices[ (y * 4u) + x + 1u ];
+					const uint32 indexBl = vertexIndices[ ((y + 1u) * 4u) + x ];
+					const uint32 indexBr = vertexIndices[ ((y + 1u) * 4u) + x + 1u ];
+
+					indices[ indexCount++ ] = indexTl;
+					indices[ indexCount++ ] = indexTr;
+					indices[ indexCount++ ] = indexBl;
+					indices[ indexCount++ ] = indexBl;
+					indices[ indexCount++ ] = indexTr;
+					indices[ indexCount++ ] = indexBr;
+				}
+			}
+
+			imuiDrawSurfacePushIndices( surface->buffers, indices, indexCount );
+			return indexCount;
+		}
+
+	case ImuiDrawTopology_MAX:
+		break;
+	}
+
+	return 0u;
+}
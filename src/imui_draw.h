@@ -2,6 +2,7 @@
 
 #include "imui/imui.h"
 
+#include "imui_stats.h"
 #include "imui_types.h"
 
 typedef struct ImuiDrawSurfaceData ImuiDrawSurfaceData;
@@ -41,7 +42,7 @@ typedef struct ImuiDrawElementDataSkin
 	ImuiColor			color;
 	ImuiTexCoord		uv;
 	ImuiBorder			border;
-	ImuiSize			texSize;
+	ImuiTexCoord		centerUv;
 } ImuiDrawElementDataSkin;
 
 typedef struct ImuiDrawElementDataText
@@ -71,6 +72,7 @@ typedef struct ImuiDrawElement
 struct ImuiDraw
 {
 	ImuiAllocator*			allocator;
+	ImuiStats*				stats;
 	ImuiVertexFormat		vertexFormat;
 	uintsize				vertexSize;
 	ImuiVertexType			vertexType;
@@ -82,14 +84,18 @@ struct ImuiDraw
 	ImuiDrawWindowData*		windows;
 	uintsize				windowCapacity;
 	uintsize				windowCount;
+
+	bool					trackChanges;	// ImuiParameters::trackChanges, otherwise every surface is dirty
 };
 
-bool				imuiDrawConstruct( ImuiDraw* draw, ImuiAllocator* allocator, const ImuiVertexFormat* vertexFormat, ImuiVertexType vertexType );
+bool				imuiDrawConstruct( ImuiDraw* draw, ImuiAllocator* allocator, ImuiStats* stats, const ImuiVertexFormat* vertexFormat, ImuiVertexType vertexType, bool trackChanges );
 void				imuiDrawDestruct( ImuiDraw* draw );
 
 uintsize			imuiDrawRegisterSurface( ImuiDraw* draw, ImuiStringView name, ImuiSize size );
 uintsize			imuiDrawRegisterWindow( ImuiDraw* draw, ImuiStringView name, uintsize surfaceIndex, uint32 zOrder );
 void				imuiDrawSurfaceEnd( ImuiDraw* draw, uintsize surfaceIndex );
+bool				imuiDrawIsSurfaceDirty( const ImuiDraw* draw, uintsize surfaceIndex );
+const ImuiRect*		imuiDrawGetSurfaceDamageRects( const ImuiDraw* draw, uintsize surfaceIndex, uintsize* outCount );
 void				imuiDrawEndFrame( ImuiDraw* draw );
 
 ImuiDrawElement*	imuiDrawPushElement( ImuiWidget* widget, ImuiDrawElementType type, uint64_t textureHandle );
@@ -11,6 +11,7 @@
 struct ImuiFontTrueTypeData
 {
 	ImuiAllocator*		allocator;
+	ImuiStats*			stats;
 
 	const void*			data;
 	uintsize			dataSize;
@@ -49,14 +50,15 @@ static bool imuiFontCodepointIsKeyEquals( const void* lhs, const void* rhs )
 
 ImuiFont* imuiFontCreate( ImuiContext* imui, const ImuiFontParameters* parameters )
 {
-	ImuiFont* font = IMUI_MEMORY_NEW_ZERO( &imui->allocator, ImuiFont );
+	ImuiAllocator* allocator = imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Fonts );
+	ImuiFont* font = IMUI_MEMORY_NEW_ZERO( allocator, ImuiFont );
 	if( !font )
 	{
 		return NULL;
 	}
 
 	font->image				= parameters->image;
-	font->codepoints		= IMUI_MEMORY_ARRAY_NEW( &imui->allocator, ImuiFontCodepoint, parameters->codepointCount );
+	font->codepoints		= IMUI_MEMORY_ARRAY_NEW( allocator, ImuiFontCodepoint, parameters->codepointCount );
 	font->codepointCount	= parameters->codepointCount;
 	font->fontSize			= parameters->fontSize;
 	font->lineGap			= parameters->lineGap;
@@ -69,12 +71,26 @@ ImuiFont* imuiFontCreate( ImuiContext* imui, const ImuiFontParameters* parameter
 
 	memcpy( font->codepoints, parameters->codepoints, sizeof( *parameters->codepoints ) * parameters->codepointCount );
 
-	if( !imuiHashMapConstructStaticPointer( &font->codepointMap, &imui->allocator, font->codepoints, sizeof( *font->codepoints ), parameters->codepointCount, imuiFontCodepointHash, imuiFontCodepointIsKeyEquals ) )
+	if( !imuiHashMapConstructStaticPointer( &font->codepointMap, allocator, font->codepoints, sizeof( *font->codepoints ), parameters->codepointCount, imuiFontCodepointHash, imuiFontCodepointIsKeyEquals ) )
 	{
 		imuiFontDestroy( imui, font );
 		return NULL;
 	}
 
+	for( uintsize i = 0u; i < font->codepointCount; ++i )
+	{
+		const ImuiFontCodepoint* codepoint = &font->codepoints[ i ];
+		if( codepoint->codepoint < IMUI_FONT_DENSE_CODEPOINT_COUNT )
+		{
+			font->denseCodepoints[ codepoint->codepoint ] = codepoint;
+		}
+	}
+
+	uint32 invalidCodepoint = 0xfffd;
+	uint32* invalidCodepointKey = &invalidCodepoint;
+	const ImuiFontCodepoint** mapInvalidCodepoint = (const ImuiFontCodepoint**)imuiHashMapFind( &font->codepointMap, &invalidCodepointKey );
+	font->invalidCodepoint = mapInvalidCodepoint ? *mapInvalidCodepoint : NULL;
+
 	return font;
 }
 
@@ -89,8 +105,22 @@ ImuiFont* imuiFontCreateTrueType( ImuiContext* imui, ImuiFontTrueTypeImage* ttfI
 	return font;
 }
 
+const ImuiFontCodepoint* imuiFontFindCodepoint( ImuiFont* font, uint32 codepoint )
+{
+	if( codepoint < IMUI_FONT_DENSE_CODEPOINT_COUNT )
+	{
+		return font->denseCodepoints[ codepoint ];
+	}
+
+	uint32* mapCodepointKey = &codepoint;
+	const ImuiFontCodepoint** mapCodepoint = (const ImuiFontCodepoint**)imuiHashMapFind( &font->codepointMap, &mapCodepointKey );
+	return mapCodepoint ? *mapCodepoint : NULL;
+}
+
 void imuiFontDestroy( ImuiContext* imui, ImuiFont* font )
 {
+	imuiTextLayoutCacheRemoveFont( &imui->layoutCache, font );
+
 	imuiHashMapDestruct( &font->codepointMap );
 	imuiMemoryFree( &imui->allocator, font->codepoints );
 	imuiMemoryFree( &imui->allocator, font );
@@ -98,13 +128,15 @@ void imuiFontDestroy( ImuiContext* imui, ImuiFont* font )
 
 ImuiFontTrueTypeData* imuiFontTrueTypeDataCreate( ImuiContext* imui, const void* data, size_t dataSize )
 {
-	ImuiFontTrueTypeData* ttf = IMUI_MEMORY_NEW_ZERO( &imui->allocator, ImuiFontTrueTypeData );
+	ImuiAllocator* allocator = imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Fonts );
+	ImuiFontTrueTypeData* ttf = IMUI_MEMORY_NEW_ZERO( allocator, ImuiFontTrueTypeData );
 	if( !ttf )
 	{
 		return NULL;
 	}
 
-	ttf->allocator	= &imui->allocator;
+	ttf->allocator	= allocator;
+	ttf->stats		= &imui->stats;
 	ttf->data		= data;
 	ttf->dataSize	= dataSize;
 
@@ -119,7 +151,7 @@ ImuiFontTrueTypeData* imuiFontTrueTypeDataCreate( ImuiContext* imui, const void*
 
 ImuiFontTrueTypeData* imuiFontTrueTypeDataCreateCopy( ImuiContext* imui, const void* data, size_t dataSize )
 {
-	void* dataCopy = imuiMemoryAlloc( &imui->allocator, dataSize );
+	void* dataCopy = imuiMemoryAlloc( imuiStatsGetAllocator( &imui->stats, ImuiMemoryTag_Fonts ), dataSize );
 	if( !dataCopy )
 	{
 		return NULL;
@@ -410,14 +442,22 @@ ImuiFontTrueTypeImage* imuiFontTrueTypeDataGenerateTextureDataInternal(ImuiFontT
 
 ImuiFontTrueTypeImage* imuiFontTrueTypeDataGenerateTextureData( ImuiFontTrueTypeData* ttf, float fontSizeInPixel, void* targetData, size_t targetDataSize, uint32_t width, uint32_t height )
 {
-	return imuiFontTrueTypeDataGenerateTextureDataInternal( ttf, fontSizeInPixel, targetData, targetDataSize, width, height, /*sdfSpread =*/ 0.0f );
+	IMUI_STATS_ZONE_BEGIN( ttf->stats, "imuiFontTrueTypeDataGenerateTextureData", NULL, 0u );
+	ImuiFontTrueTypeImage* image = imuiFontTrueTypeDataGenerateTextureDataInternal( ttf, fontSizeInPixel, targetData, targetDataSize, width, height, /*sdfSpread =*/ 0.0f );
+	IMUI_STATS_ZONE_END( ttf->stats );
+
+	return image;
 }
 
 ImuiFontTrueTypeImage* imuiFontTrueTypeDataGenerateSDFTextureData( ImuiFontTrueTypeData* ttf, float fontSizeInPixel, void* targetData, size_t targetDataSize, uint32_t width, uint32_t height, float sdfSpread )
 {
 	// sdfSpread is a fraction of the font size, values around [0.1f, 0.3f] work
 	// If using SDFs you need a larger target image than for pure bitmap font, so use imuiFontTrueTypeDataCalculateMinSDFTextureSize to compute that.
-	return imuiFontTrueTypeDataGenerateTextureDataInternal( ttf, fontSizeInPixel, targetData, targetDataSize, width, height, sdfSpread );
+	IMUI_STATS_ZONE_BEGIN( ttf->stats, "imuiFontTrueTypeDataGenerateSDFTextureData", NULL, 0u );
+	ImuiFontTrueTypeImage* image = imuiFontTrueTypeDataGenerateTextureDataInternal( ttf, fontSizeInPixel, targetData, targetDataSize, width, height, sdfSpread );
+	IMUI_STATS_ZONE_END( ttf->stats );
+
+	return image;
 }
 
 void imuiFontTrueTypeImageGetCodepoints( ImuiFontTrueTypeImage* ttfImage, const ImuiFontCodepoint** codepoints, size_t* codepointCount )
@@ -5,6 +5,8 @@
 #include "imui_types.h"
 #include "imui_helpers.h"
 
+#define IMUI_FONT_DENSE_CODEPOINT_COUNT	256u
+
 struct ImuiFont
 {
 	ImuiImage			image;
@@ -16,5 +18,10 @@ struct ImuiFont
 	float				lineGap;
 	bool				isScalable;
 
+	const ImuiFontCodepoint*	denseCodepoints[ IMUI_FONT_DENSE_CODEPOINT_COUNT ];	// direct lookup for ASCII and Latin-1
+	const ImuiFontCodepoint*	invalidCodepoint;
+
 	ImuiHashMap			codepointMap;
 };
+
+const ImuiFontCodepoint*		imuiFontFindCodepoint( ImuiFont* font, uint32 codepoint );
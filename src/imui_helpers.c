@@ -3,6 +3,8 @@
 #include "imui_internal.h"
 #include "imui_memory.h"
 
+#include <math.h>
+#include <stdio.h>
 #include <string.h>
 
 //////////////////////////////////////////////////////////////////////////
@@ -522,3 +524,433 @@ const ImuiStringView* imuiStringPoolFind( ImuiStringPool* stringPool, ImuiString
 {
 	return (const ImuiStringView*)imuiHashMapFind( &stringPool->keyMap, &string );
 }
+
+//////////////////////////////////////////////////////////////////////////
+// String Arena
+
+struct ImuiStringArenaChunk
+{
+	ImuiStringArenaChunk*	nextChunk;
+
+	uintsize				usedSize;
+	uintsize				size;
+	char					data[ 1u ];
+};
+
+void imuiStringArenaConstruct( ImuiStringArena* arena, ImuiAllocator* allocator )
+{
+	arena->allocator	= allocator;
+	arena->firstChunk	= NULL;
+	arena->currentChunk	= NULL;
+}
+
+void imuiStringArenaDestruct( ImuiStringArena* arena )
+{
+	ImuiStringArenaChunk* chunk = arena->firstChunk;
+	while( chunk )
+	{
+		ImuiStringArenaChunk* nextChunk = chunk->nextChunk;
+		imuiMemoryFree( arena->allocator, chunk );
+		chunk = nextChunk;
+	}
+
+	arena->firstChunk	= NULL;
+	arena->currentChunk	= NULL;
+}
+
+void imuiStringArenaClear( ImuiStringArena* arena )
+{
+	for( ImuiStringArenaChunk* chunk = arena->firstChunk; chunk != NULL; chunk = chunk->nextChunk )
+	{
+		chunk->usedSize = 0u;
+	}
+
+	arena->currentChunk = arena->firstChunk;
+}
+
+static ImuiStringArenaChunk* imuiStringArenaFindChunk( ImuiStringArena* arena, uintsize size )
+{
+	// chunks are kept over frames, so after warm up this never allocates
+	ImuiStringArenaChunk* chunk = arena->currentChunk;
+	while( chunk && chunk->size - chunk->usedSize < size )
+	{
+		chunk = chunk->nextChunk;
+	}
+
+	if( chunk )
+	{
+		arena->currentChunk = chunk;
+		return chunk;
+	}
+
+	const uintsize chunkSize = IMUI_MAX( size, IMUI_DEFAULT_STRING_ARENA_CHUNK_SIZE );
+	chunk = (ImuiStringArenaChunk*)imuiMemoryAlloc( arena->allocator, sizeof( ImuiStringArenaChunk ) + chunkSize );
+	if( !chunk )
+	{
+		return NULL;
+	}
+
+	chunk->usedSize	= 0u;
+	chunk->size		= chunkSize;
+
+	if( arena->currentChunk )
+	{
+		chunk->nextChunk = arena->currentChunk->nextChunk;
+		arena->currentChunk->nextChunk = chunk;
+	}
+	else
+	{
+		chunk->nextChunk = arena->firstChunk;
+		arena->firstChunk = chunk;
+	}
+
+	arena->currentChunk = chunk;
+	return chunk;
+}
+
+char* imuiStringArenaAlloc( ImuiStringArena* arena, uintsize length )
+{
+	ImuiStringArenaChunk* chunk = imuiStringArenaFindChunk( arena, length + 1u );
+	if( !chunk )
+	{
+		return NULL;
+	}
+
+	char* string = chunk->data + chunk->usedSize;
+	string[ length ] = '\0';
+
+	chunk->usedSize += length + 1u;
+	return string;
+}
+
+ImuiStringView imuiStringArenaFormatArgs( ImuiStringArena* arena, const char* format, va_list args )
+{
+	// try to format into the remaining space of the current chunk first
+	char* target = NULL;
+	uintsize remainingSize = 0u;
+	if( arena->currentChunk )
+	{
+		target			= arena->currentChunk->data + arena->currentChunk->usedSize;
+		remainingSize	= arena->currentChunk->size - arena->currentChunk->usedSize;
+	}
+
+	va_list argsCopy;
+	va_copy( argsCopy, args );
+	const int length = vsnprintf( target, remainingSize, format, argsCopy );
+	va_end( argsCopy );
+
+	if( length < 0 )
+	{
+		return imuiStringViewCreateEmpty();
+	}
+	else if( (uintsize)length < remainingSize )
+	{
+		arena->currentChunk->usedSize += (uintsize)length + 1u;
+		return imuiStringViewCreateLength( target, (uintsize)length );
+	}
+
+	target = imuiStringArenaAlloc( arena, (uintsize)length );
+	if( !target )
+	{
+		return imuiStringViewCreateEmpty();
+	}
+
+	va_copy( argsCopy, args );
+	vsnprintf( target, (uintsize)length + 1u, format, argsCopy );
+	va_end( argsCopy );
+
+	return imuiStringViewCreateLength( target, (uintsize)length );
+}
+
+static ImuiStringView imuiStringArenaFormatDigits( ImuiStringArena* arena, bool negative, uint64 value, uint64 fraction, uint32 decimals )
+{
+	char buffer[ 48u ];
+	char* end = buffer + sizeof( buffer );
+	char* start = end;
+
+	for( uint32 i = 0u; i < decimals; ++i )
+	{
+		*--start = (char)('0' + (fraction % 10u));
+		fraction /= 10u;
+	}
+
+	if( decimals > 0u )
+	{
+		*--start = '.';
+	}
+
+	do
+	{
+		*--start = (char)('0' + (value % 10u));
+		value /= 10u;
+	}
+	while( value > 0u );
+
+	if( negative )
+	{
+		*--start = '-';
+	}
+
+	const uintsize length = (uintsize)(end - start);
+	char* target = imuiStringArenaAlloc( arena, length );
+	if( !target )
+	{
+		return imuiStringViewCreateEmpty();
+	}
+
+	memcpy( target, start, length );
+	return imuiStringViewCreateLength( target, length );
+}
+
+ImuiStringView imuiStringArenaFormatInt( ImuiStringArena* arena, sint64 value )
+{
+	const uint64 absValue = value < 0 ? (uint64)0u - (uint64)value : (uint64)value;
+	return imuiStringArenaFormatDigits( arena, value < 0, absValue, 0u, 0u );
+}
+
+ImuiStringView imuiStringArenaFormatUInt( ImuiStringArena* arena, uint64 value )
+{
+	return imuiStringArenaFormatDigits( arena, false, value, 0u, 0u );
+}
+
+static ImuiStringView imuiStringArenaFormat( ImuiStringArena* arena, const char* format, ... )
+{
+	va_list args;
+	va_start( args, format );
+	const ImuiStringView result = imuiStringArenaFormatArgs( arena, format, args );
+	va_end( args );
+
+	return result;
+}
+
+ImuiStringView imuiStringArenaFormatFloat( ImuiStringArena* arena, double value, uint32 decimals )
+{
+	static const double s_powersOfTen[] = { 1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6 };
+
+	const double absValue = fabs( value );
+	const double scaledValue = absValue * (decimals < IMUI_ARRAY_COUNT( s_powersOfTen ) ? s_powersOfTen[ decimals ] : 0.0);
+	const double fraction = scaledValue - floor( scaledValue );
+	if( decimals >= IMUI_ARRAY_COUNT( s_powersOfTen ) ||
+		!(scaledValue < 9007199254740992.0) ||
+		fabs( fraction - 0.5 ) <= scaledValue * DBL_EPSILON * 4.0 )
+	{
+		// out of exact fixed point range, inf, nan and ties where printf rounds the exact value instead of the product
+		return imuiStringArenaFormat( arena, "%.*f", (int)decimals, value );
+	}
+
+	const uint64 scale	= (uint64)s_powersOfTen[ decimals ];
+	const uint64 scaled	= (uint64)nearbyint( scaledValue );		// same as printf outside of the tie band
+	// values rounding to zero are printed without sign
+	return imuiStringArenaFormatDigits( arena, value < 0.0 && scaled > 0u, scaled / scale, scaled % scale, decimals );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SlabAllocator
+
+struct ImuiSlabAllocatorChunk
+{
+	ImuiSlabAllocatorChunk*	prevFreeChunk;
+	ImuiSlabAllocatorChunk*	nextFreeChunk;
+	ImuiSlabAllocatorBlock*	freeBlocks;
+	uint32					classIndex;
+	uint32					usedCount;
+};
+
+struct ImuiSlabAllocatorBlock
+{
+	ImuiSlabAllocatorBlock*	nextBlock;
+};
+
+static uintsize imuiSlabAllocatorGetClassIndex( uintsize size )
+{
+	const uintsize blockSize = imuiSlabAllocatorGetBlockSize( size );
+	return (uintsize)(IMUI_COUNT_LEADING_ZEROS32( IMUI_SLAB_ALLOCATOR_MIN_BLOCK_SIZE ) - IMUI_COUNT_LEADING_ZEROS32( (uint32)blockSize ));
+}
+
+// index of the first chunk with a higher address than memory
+static uintsize imuiSlabAllocatorFindChunkIndex( const ImuiSlabAllocator* slab, const void* memory )
+{
+	uintsize first = 0u;
+	uintsize last = slab->chunkCount;
+	while( first < last )
+	{
+		const uintsize middle = first + ((last - first) / 2u);
+		if( (const byte*)slab->chunks[ middle ] <= (const byte*)memory )
+		{
+			first = middle + 1u;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	return first;
+}
+
+static void imuiSlabAllocatorLinkFreeChunk( ImuiSlabAllocator* slab, ImuiSlabAllocatorChunk* chunk )
+{
+	ImuiSlabAllocatorChunk** firstChunk = &slab->freeChunks[ chunk->classIndex ];
+
+	chunk->prevFreeChunk = NULL;
+	chunk->nextFreeChunk = *firstChunk;
+	if( *firstChunk )
+	{
+		(*firstChunk)->prevFreeChunk = chunk;
+	}
+	*firstChunk = chunk;
+}
+
+static void imuiSlabAllocatorUnlinkFreeChunk( ImuiSlabAllocator* slab, ImuiSlabAllocatorChunk* chunk )
+{
+	if( chunk->prevFreeChunk )
+	{
+		chunk->prevFreeChunk->nextFreeChunk = chunk->nextFreeChunk;
+	}
+	else
+	{
+		slab->freeChunks[ chunk->classIndex ] = chunk->nextFreeChunk;
+	}
+
+	if( chunk->nextFreeChunk )
+	{
+		chunk->nextFreeChunk->prevFreeChunk = chunk->prevFreeChunk;
+	}
+
+	chunk->prevFreeChunk = NULL;
+	chunk->nextFreeChunk = NULL;
+}
+
+void imuiSlabAllocatorConstruct( ImuiSlabAllocator* slab, ImuiAllocator* allocator )
+{
+	slab->allocator		= allocator;
+	slab->chunks		= NULL;
+	slab->chunkCount	= 0u;
+	slab->chunkCapacity	= 0u;
+
+	for( uintsize i = 0u; i < IMUI_SLAB_ALLOCATOR_CLASS_COUNT; ++i )
+	{
+		slab->freeChunks[ i ] = NULL;
+	}
+}
+
+void imuiSlabAllocatorDestruct( ImuiSlabAllocator* slab )
+{
+	for( uintsize i = 0u; i < slab->chunkCount; ++i )
+	{
+		imuiMemoryFree( slab->allocator, slab->chunks[ i ] );
+	}
+	IMUI_MEMORY_ARRAY_FREE( slab->allocator, slab->chunks, slab->chunkCapacity );
+
+	imuiSlabAllocatorConstruct( slab, slab->allocator );
+}
+
+uintsize imuiSlabAllocatorGetBlockSize( uintsize size )
+{
+	if( size > IMUI_SLAB_ALLOCATOR_MAX_BLOCK_SIZE )
+	{
+		return size;
+	}
+	else if( size <= IMUI_SLAB_ALLOCATOR_MIN_BLOCK_SIZE )
+	{
+		return IMUI_SLAB_ALLOCATOR_MIN_BLOCK_SIZE;
+	}
+
+	return (uintsize)IMUI_NEXT_POWER_OF_TWO( size );
+}
+
+void* imuiSlabAllocatorAlloc( ImuiSlabAllocator* slab, uintsize size )
+{
+	if( size > IMUI_SLAB_ALLOCATOR_MAX_BLOCK_SIZE )
+	{
+		return imuiMemoryAlloc( slab->allocator, size );
+	}
+
+	const uintsize blockSize = imuiSlabAllocatorGetBlockSize( size );
+	const uintsize classIndex = imuiSlabAllocatorGetClassIndex( size );
+	if( !slab->freeChunks[ classIndex ] )
+	{
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( slab->allocator, slab->chunks, slab->chunkCapacity, slab->chunkCount + 1u ) )
+		{
+			return NULL;
+		}
+
+		const uintsize blockCount = IMUI_MAX( IMUI_DEFAULT_SLAB_CHUNK_SIZE / blockSize, 1u );
+		ImuiSlabAllocatorChunk* chunk = (ImuiSlabAllocatorChunk*)imuiMemoryAlloc( slab->allocator, sizeof( ImuiSlabAllocatorChunk ) + (blockSize * blockCount) );
+		if( !chunk )
+		{
+			return NULL;
+		}
+
+		chunk->freeBlocks	= NULL;
+		chunk->classIndex	= (uint32)classIndex;
+		chunk->usedCount	= 0u;
+
+		byte* blockData = (byte*)&chunk[ 1u ];
+		for( uintsize i = blockCount; i > 0u; --i )
+		{
+			ImuiSlabAllocatorBlock* block = (ImuiSlabAllocatorBlock*)&blockData[ blockSize * (i - 1u) ];
+			block->nextBlock = chunk->freeBlocks;
+			chunk->freeBlocks = block;
+		}
+
+		const uintsize chunkIndex = imuiSlabAllocatorFindChunkIndex( slab, chunk );
+		memmove( &slab->chunks[ chunkIndex + 1u ], &slab->chunks[ chunkIndex ], sizeof( *slab->chunks ) * (slab->chunkCount - chunkIndex) );
+		slab->chunks[ chunkIndex ] = chunk;
+		slab->chunkCount++;
+
+		imuiSlabAllocatorLinkFreeChunk( slab, chunk );
+	}
+
+	ImuiSlabAllocatorChunk* chunk = slab->freeChunks[ classIndex ];
+	ImuiSlabAllocatorBlock* block = chunk->freeBlocks;
+	chunk->freeBlocks = block->nextBlock;
+	chunk->usedCount++;
+
+	if( !chunk->freeBlocks )
+	{
+		imuiSlabAllocatorUnlinkFreeChunk( slab, chunk );
+	}
+
+	return block;
+}
+
+void imuiSlabAllocatorFree( ImuiSlabAllocator* slab, void* memory, uintsize size )
+{
+	if( !memory )
+	{
+		return;
+	}
+
+	if( size > IMUI_SLAB_ALLOCATOR_MAX_BLOCK_SIZE )
+	{
+		imuiMemoryFree( slab->allocator, memory );
+		return;
+	}
+
+	const uintsize chunkIndex = imuiSlabAllocatorFindChunkIndex( slab, memory ) - 1u;
+	ImuiSlabAllocatorChunk* chunk = slab->chunks[ chunkIndex ];
+	IMUI_ASSERT( chunk->classIndex == imuiSlabAllocatorGetClassIndex( size ) );
+
+	if( !chunk->freeBlocks )
+	{
+		imuiSlabAllocatorLinkFreeChunk( slab, chunk );
+	}
+
+	ImuiSlabAllocatorBlock* block = (ImuiSlabAllocatorBlock*)memory;
+	block->nextBlock = chunk->freeBlocks;
+	chunk->freeBlocks = block;
+	chunk->usedCount--;
+
+	// keep the last chunk with free blocks of a class, so a single block doesn't allocate and free a chunk every time
+	if( chunk->usedCount == 0u &&
+		(chunk->prevFreeChunk || chunk->nextFreeChunk) )
+	{
+		imuiSlabAllocatorUnlinkFreeChunk( slab, chunk );
+
+		memmove( &slab->chunks[ chunkIndex ], &slab->chunks[ chunkIndex + 1u ], sizeof( *slab->chunks ) * (slab->chunkCount - chunkIndex - 1u) );
+		slab->chunkCount--;
+
+		imuiMemoryFree( slab->allocator, chunk );
+	}
+}
@@ -3,6 +3,8 @@
 #include "imui/imui.h"
 #include "imui_types.h"
 
+#include <stdarg.h>
+
 typedef ImuiHash(*imuiHashMapEntryHashFunc)( const void* entry );
 typedef bool(*imuiHashMapIsKeyEqualsFunc)( const void* lhs, const void* rhs );
 
@@ -54,3 +56,48 @@ void						imuiStringPoolClear( ImuiStringPool* stringPool );
 ImuiStringView				imuiStringPoolAdd( ImuiStringPool* stringPool, ImuiStringView string );
 const ImuiStringView*		imuiStringPoolFind( ImuiStringPool* stringPool, ImuiStringView string );
 
+typedef struct ImuiStringArenaChunk ImuiStringArenaChunk;
+
+typedef struct ImuiStringArena
+{
+	ImuiAllocator*			allocator;
+	ImuiStringArenaChunk*	firstChunk;
+	ImuiStringArenaChunk*	currentChunk;
+} ImuiStringArena;
+
+void						imuiStringArenaConstruct( ImuiStringArena* arena, ImuiAllocator* allocator );
+void						imuiStringArenaDestruct( ImuiStringArena* arena );
+
+void						imuiStringArenaClear( ImuiStringArena* arena );
+
+char*						imuiStringArenaAlloc( ImuiStringArena* arena, uintsize length );	// allocates length + 1 for the terminator
+ImuiStringView				imuiStringArenaFormatArgs( ImuiStringArena* arena, const char* format, va_list args );
+ImuiStringView				imuiStringArenaFormatInt( ImuiStringArena* arena, sint64 value );
+ImuiStringView				imuiStringArenaFormatUInt( ImuiStringArena* arena, uint64 value );
+ImuiStringView				imuiStringArenaFormatFloat( ImuiStringArena* arena, double value, uint32 decimals );
+
+
+#define IMUI_SLAB_ALLOCATOR_MIN_BLOCK_SIZE		64u
+#define IMUI_SLAB_ALLOCATOR_MAX_BLOCK_SIZE		4096u	// bigger allocations use the allocator directly
+#define IMUI_SLAB_ALLOCATOR_CLASS_COUNT			7u
+
+typedef struct ImuiSlabAllocatorChunk ImuiSlabAllocatorChunk;
+typedef struct ImuiSlabAllocatorBlock ImuiSlabAllocatorBlock;
+
+typedef struct ImuiSlabAllocator
+{
+	ImuiAllocator*			allocator;
+
+	ImuiSlabAllocatorChunk**	chunks;		// sorted by address to find the chunk of a block
+	uintsize				chunkCount;
+	uintsize				chunkCapacity;
+
+	ImuiSlabAllocatorChunk*	freeChunks[ IMUI_SLAB_ALLOCATOR_CLASS_COUNT ];	// chunks with free blocks, empty chunks are returned to the allocator if there is another one
+} ImuiSlabAllocator;
+
+void						imuiSlabAllocatorConstruct( ImuiSlabAllocator* slab, ImuiAllocator* allocator );
+void						imuiSlabAllocatorDestruct( ImuiSlabAllocator* slab );
+
+uintsize					imuiSlabAllocatorGetBlockSize( uintsize size );
+void*						imuiSlabAllocatorAlloc( ImuiSlabAllocator* slab, uintsize size );
+void						imuiSlabAllocatorFree( ImuiSlabAllocator* slab, void* memory, uintsize size ); // size must be same as for alloc
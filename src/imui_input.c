@@ -11,10 +11,13 @@ static const char*	imuiInputTextGetRead( const ImuiInputText* text );
 static void			imuiInputTextFree( ImuiInput* input, ImuiInputText* text );
 static bool			imuiInputTextCheckCapacity( ImuiInput* input, ImuiInputText* text, uintsize requiredCapacity );
 static bool			imuiInputTextPush( ImuiInput* input, ImuiInputText* text, const char* string, uintsize length );
+static void			imuiInputPushTextBytes( ImuiInput* input, const char* text, uintsize length );
+static ImuiInputEvent*	imuiInputPushEvent( ImuiInput* input, ImuiInputEventType type, uint32_t code );
 
-bool imuiInputConstruct( ImuiInput* input, ImuiAllocator* allocator, const ImuiInputShortcutConfig* shortcuts, size_t shortcutCount )
+bool imuiInputConstruct( ImuiInput* input, ImuiAllocator* allocator, const ImuiInputShortcutConfig* shortcuts, size_t shortcutCount, size_t eventCapacity )
 {
-	input->allocator = allocator;
+	input->allocator		= allocator;
+	input->eventCapacity	= eventCapacity;
 
 	ImuiInputShortcutConfig* newShortcuts = NULL;
 	if( shortcutCount > 0u )
@@ -48,6 +51,11 @@ void imuiInputDestruct( ImuiInput* input )
 		ImuiInputStateChunk* chunk = input->firstStateChunk;
 		input->firstStateChunk = chunk->nextChunk;
 
+		for( uintsize i = 0u; i < chunk->usedCount; ++i )
+		{
+			imuiMemoryFree( input->allocator, chunk->states[ i ].events );
+		}
+
 		imuiMemoryFree( input->allocator, chunk );
 	}
 
@@ -81,7 +89,7 @@ void imuiInputEndFrame( ImuiInput* input )
 
 bool imuiInputBeginState( ImuiInput* input, const ImuiInputState* previousState )
 {
-	assert( input->pushState == NULL );
+	IMUI_ASSERT( input->pushState == NULL );
 
 	ImuiInputState* state;
 	if( input->freeStates )
@@ -107,6 +115,9 @@ bool imuiInputBeginState( ImuiInput* input, const ImuiInputState* previousState
 
 		state = &input->firstStateChunk->states[ input->firstStateChunk->usedCount ];
 		input->firstStateChunk->usedCount++;
+
+		state->events			= NULL;
+		state->eventCapacity	= 0u;
 	}
 
 	state->nextState = input->newStates;
@@ -139,6 +150,14 @@ bool imuiInputBeginState( ImuiInput* input, const ImuiInputState* previousState
 
 	state->current.mouseScroll = imuiPosCreateZero();
 
+	memset( state->mouseButtonTransitions, 0, sizeof( state->mouseButtonTransitions ) );
+	memset( state->keyTransitions, 0, sizeof( state->keyTransitions ) );
+
+	state->eventFirst	= 0u;
+	state->eventCount	= 0u;
+	state->eventTime	= previousState ? previousState->eventTime : 0.0;
+	state->eventsLost	= false;
+
 	return true;
 }
 
@@ -165,6 +184,35 @@ const ImuiInputState* imuiInputEndState( ImuiInput* input )
 	return state;
 }
 
+bool imuiInputHasChanges( const ImuiInputState* input )
+{
+	const ImuiInputData* current	= &input->current;
+	const ImuiInputData* last		= &input->last;
+	if( current->text.length > 0u ||
+		current->shortcut != ImuiInputShortcut_None ||
+		current->focusExecute ||
+		current->focusDirection.x != 0.0f || current->focusDirection.y != 0.0f ||
+		current->mouseScroll.x != 0.0f || current->mouseScroll.y != 0.0f ||
+		current->mousePos.x != last->mousePos.x || current->mousePos.y != last->mousePos.y ||
+		current->keyModifiers != last->keyModifiers ||
+		input->eventCount > 0u )	// in-frame transitions always come with events
+	{
+		return true;
+	}
+
+	for( uintsize i = 0u; i < ImuiInputMouseButton_MAX; ++i )
+	{
+		if( current->mouseButtons[ i ] != last->mouseButtons[ i ] ||
+			current->mouseButtonDoubleClick[ i ] )
+		{
+			return true;
+		}
+	}
+
+	// also catches key repeats which reset the last state
+	return memcmp( current->keys, last->keys, sizeof( current->keys ) ) != 0;
+}
+
 ImuiInputMouseCursor imuiInputGetMouseCursor( const ImuiContext* imui )
 {
 	return imui->input.mouseCursor;
@@ -244,7 +292,18 @@ void imuiInputPushKeyDown( ImuiInput* input, ImuiInputKey key )
 		input->pushState->current.keyModifiers |= ImuiInputModifier_RightAlt;
 	}
 
-	input->pushState->current.keys[ key ] = true;
+	ImuiInputState* state = input->pushState;
+	if( input->eventCapacity > 0u )
+	{
+		if( !state->current.keys[ key ] )
+		{
+			state->keyTransitions[ key ] |= ImuiInputTransition_Pressed;
+		}
+
+		imuiInputPushEvent( input, ImuiInputEventType_KeyDown, key );
+	}
+
+	state->current.keys[ key ] = true;
 }
 
 void imuiInputPushKeyUp( ImuiInput* input, ImuiInputKey key )
@@ -274,18 +333,53 @@ void imuiInputPushKeyUp( ImuiInput* input, ImuiInputKey key )
 		input->pushState->current.keyModifiers &= ~ImuiInputModifier_RightAlt;
 	}
 
-	input->pushState->current.keys[ key ] = false;
+	ImuiInputState* state = input->pushState;
+	if( input->eventCapacity > 0u )
+	{
+		if( state->current.keys[ key ] )
+		{
+			state->keyTransitions[ key ] |= ImuiInputTransition_Released;
+		}
+
+		imuiInputPushEvent( input, ImuiInputEventType_KeyUp, key );
+	}
+
+	state->current.keys[ key ] = false;
 }
 
 void imuiInputPushKeyRepeat( ImuiInput* input, ImuiInputKey key )
 {
 	// fake key repeat by setting last state to released so 'was pressed' trigger again
 	input->pushState->last.keys[ key ] = false;
+
+	if( input->eventCapacity > 0u )
+	{
+		input->pushState->keyTransitions[ key ] |= ImuiInputTransition_Pressed;
+		imuiInputPushEvent( input, ImuiInputEventType_KeyRepeat, key );
+	}
 }
 
 void imuiInputPushText( ImuiInput* input, const char* text )
 {
-	imuiInputTextPush( input, &input->pushState->current.text, text, strlen( text ) );
+	imuiInputPushTextBytes( input, text, strlen( text ) );
+}
+
+static void imuiInputPushTextBytes( ImuiInput* input, const char* text, uintsize length )
+{
+	ImuiInputText* stateText = &input->pushState->current.text;
+	const uintsize offset = stateText->length;
+	if( !imuiInputTextPush( input, stateText, text, length ) ||
+		input->eventCapacity == 0u ||
+		stateText->length == offset )
+	{
+		return;
+	}
+
+	ImuiInputEvent* event = imuiInputPushEvent( input, ImuiInputEventType_Text, (uint32_t)offset );
+	if( event )
+	{
+		event->data.textLength = stateText->length - offset;
+	}
 }
 
 void imuiInputPushTextChar( ImuiInput* input, uint32_t c )
@@ -302,7 +396,7 @@ void imuiInputPushTextChar( ImuiInput* input, uint32_t c )
 		bytes[ 1u ] = 0x80 | (char)((c >> 12) & 0x3f);
 		bytes[ 2u ] = 0x80 | (char)((c >> 6) & 0x3f);
 		bytes[ 3u ] = 0x80 | (char)(c & 0x3f);
-		imuiInputTextPush( input, &input->pushState->current.text, bytes, sizeof( bytes ) );
+		imuiInputPushTextBytes( input, bytes, sizeof( bytes ) );
 	}
 	else if( c >= 0x800u )
 	{
@@ -310,56 +404,111 @@ void imuiInputPushTextChar( ImuiInput* input, uint32_t c )
 		bytes[ 0u ]	= 0xe0 | (char)(c >> 12);
 		bytes[ 1u ] = 0x80 | (char)((c >> 6) & 0x3f);
 		bytes[ 2u ] = 0x80 | (char)(c & 0x3f);
-		imuiInputTextPush( input, &input->pushState->current.text, bytes, sizeof( bytes ) );
+		imuiInputPushTextBytes( input, bytes, sizeof( bytes ) );
 	}
 	else if( c >= 0x80u )
 	{
 		char bytes[ 2u ];
 		bytes[ 0u ]	= 0xc0 | (char)(c >> 6);
 		bytes[ 1u ] = 0x80 | (char)(c & 0x3f);
-		imuiInputTextPush( input, &input->pushState->current.text, bytes, sizeof( bytes ) );
+		imuiInputPushTextBytes( input, bytes, sizeof( bytes ) );
 	}
 	else
 	{
 		char bytes[ 1u ];
 		bytes[ 0u ] = (char)c;
-		imuiInputTextPush( input, &input->pushState->current.text, bytes, sizeof( bytes ) );
+		imuiInputPushTextBytes( input, bytes, sizeof( bytes ) );
 	}
 }
 
 void imuiInputPushMouseDown( ImuiInput* input, ImuiInputMouseButton button )
 {
-	input->pushState->current.mouseButtons[ button ] = true;
+	ImuiInputState* state = input->pushState;
+	if( input->eventCapacity > 0u )
+	{
+		if( !state->current.mouseButtons[ button ] )
+		{
+			state->mouseButtonTransitions[ button ] |= ImuiInputTransition_Pressed;
+		}
+
+		imuiInputPushEvent( input, ImuiInputEventType_MouseDown, button );
+	}
+
+	state->current.mouseButtons[ button ] = true;
 }
 
 void imuiInputPushMouseUp( ImuiInput* input, ImuiInputMouseButton button )
 {
-	input->pushState->current.mouseButtons[ button ] = false;
+	ImuiInputState* state = input->pushState;
+	if( input->eventCapacity > 0u )
+	{
+		if( state->current.mouseButtons[ button ] )
+		{
+			state->mouseButtonTransitions[ button ] |= ImuiInputTransition_Released;
+		}
+
+		imuiInputPushEvent( input, ImuiInputEventType_MouseUp, button );
+	}
+
+	state->current.mouseButtons[ button ] = false;
 }
 
 void imuiInputPushMouseDoubleClick( ImuiInput* input, ImuiInputMouseButton button )
 {
 	input->pushState->current.mouseButtonDoubleClick[ button ] = true;
+
+	if( input->eventCapacity > 0u )
+	{
+		imuiInputPushEvent( input, ImuiInputEventType_MouseDoubleClick, button );
+	}
 }
 
 void imuiInputPushMouseMove( ImuiInput* input, float x, float y )
 {
 	input->pushState->current.mousePos = imuiPosCreate( x, y );
+
+	if( input->eventCapacity > 0u )
+	{
+		imuiInputPushEvent( input, ImuiInputEventType_MouseMove, 0u );
+	}
 }
 
 void imuiInputPushMouseMoveDelta( ImuiInput* input, float deltaX, float deltaY )
 {
 	input->pushState->current.mousePos = imuiPosAdd( input->pushState->current.mousePos, deltaX, deltaY );
+
+	if( input->eventCapacity > 0u )
+	{
+		imuiInputPushEvent( input, ImuiInputEventType_MouseMove, 0u );
+	}
 }
 
 void imuiInputPushMouseScroll( ImuiInput* input, float horizontalOffset, float verticalOffset )
 {
 	input->pushState->current.mouseScroll = imuiPosCreate( horizontalOffset, verticalOffset );
+
+	if( input->eventCapacity > 0u )
+	{
+		ImuiInputEvent* event = imuiInputPushEvent( input, ImuiInputEventType_MouseScroll, 0u );
+		if( event )
+		{
+			event->data.pos = imuiPosCreate( horizontalOffset, verticalOffset );
+		}
+	}
 }
 
 void imuiInputPushMouseScrollDelta( ImuiInput* input, float horizontalDelta, float verticalDelta )
 {
 	input->pushState->current.mouseScroll = imuiPosAddPos( input->pushState->current.mouseScroll, imuiPosCreate( horizontalDelta, verticalDelta ) );
+
+	if( input->eventCapacity > 0u )
+	{
+		ImuiInputEvent* event = imuiInputPushEvent( input, ImuiInputEventType_MouseScroll, 0u );
+		if( event )
+		{
+			event->data.pos = imuiPosCreate( horizontalDelta, verticalDelta );
+		}
+	}
 }
 
 void imuiInputPushDirection( ImuiInput* input, float x, float y )
@@ -381,6 +530,11 @@ void imuiInputPushFocusExecute( ImuiInput* input )
 	input->pushState->current.focusExecute = true;
 }
 
+void imuiInputPushTime( ImuiInput* input, double timeInSeconds )
+{
+	input->pushState->eventTime = timeInSeconds;
+}
+
 uint32_t imuiInputGetKeyModifiers( const ImuiInputState* input )
 {
 	return input->current.keyModifiers;
@@ -398,12 +552,14 @@ bool imuiInputIsKeyUp( const ImuiInputState* input, ImuiInputKey key )
 
 bool imuiInputHasKeyPressed( const ImuiInputState* input, ImuiInputKey key )
 {
-	return input->current.keys[ key ] && !input->last.keys[ key ];
+	return (input->current.keys[ key ] && !input->last.keys[ key ]) ||
+		(input->keyTransitions[ key ] & ImuiInputTransition_Pressed);
 }
 
 bool imuiInputHasKeyReleased( const ImuiInputState* input, ImuiInputKey key )
 {
-	return !input->current.keys[ key ] && input->last.keys[ key ];
+	return (!input->current.keys[ key ] && input->last.keys[ key ]) ||
+		(input->keyTransitions[ key ] & ImuiInputTransition_Released);
 }
 
 ImuiInputShortcut imuiInputGetShortcut( const ImuiInputState* input )
@@ -438,12 +594,14 @@ bool imuiInputIsMouseButtonUp( const ImuiInputState* input, ImuiInputMouseButton
 
 bool imuiInputHasMouseButtonPressed( const ImuiInputState* input, ImuiInputMouseButton button )
 {
-	return input->current.mouseButtons[ button ] && !input->last.mouseButtons[ button ];
+	return (input->current.mouseButtons[ button ] && !input->last.mouseButtons[ button ]) ||
+		(input->mouseButtonTransitions[ button ] & ImuiInputTransition_Pressed);
 }
 
 bool imuiInputHasMouseButtonReleased( const ImuiInputState* input, ImuiInputMouseButton button )
 {
-	return !input->current.mouseButtons[ button ] && input->last.mouseButtons[ button ];
+	return (!input->current.mouseButtons[ button ] && input->last.mouseButtons[ button ]) ||
+		(input->mouseButtonTransitions[ button ] & ImuiInputTransition_Released);
 }
 
 bool imuiInputHasMouseButtonDoubleClicked( const ImuiInputState* input, ImuiInputMouseButton button )
@@ -466,6 +624,22 @@ bool imuiInputGetFocusExecute( const ImuiInputState* input )
 	return input->current.focusExecute;
 }
 
+size_t imuiInputGetEventCount( const ImuiInputState* input )
+{
+	return input->eventCount;
+}
+
+const ImuiInputEvent* imuiInputGetEvent( const ImuiInputState* input, size_t index )
+{
+	IMUI_ASSERT( index < input->eventCount );
+	return &input->events[ (input->eventFirst + index) % input->eventCapacity ];
+}
+
+bool imuiInputHasLostEvents( const ImuiInputState* input )
+{
+	return input->eventsLost;
+}
+
 static char* imuiInputTextGet( ImuiInputText* text )
 {
 	return text->capacity > sizeof( text->data.buffer ) ? text->data.pointer : text->data.buffer;
@@ -561,4 +735,45 @@ static bool imuiInputTextPush( ImuiInput* input, ImuiInputText* text, const char
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+static ImuiInputEvent* imuiInputPushEvent( ImuiInput* input, ImuiInputEventType type, uint32_t code )
+{
+	ImuiInputState* state = input->pushState;
+	if( state->eventCapacity != input->eventCapacity )
+	{
+		imuiMemoryFree( input->allocator, state->events );
+
+		state->events			= IMUI_MEMORY_ARRAY_NEW( input->allocator, ImuiInputEvent, input->eventCapacity );
+		state->eventCapacity	= state->events ? input->eventCapacity : 0u;
+		state->eventFirst		= 0u;
+		state->eventCount		= 0u;
+	}
+
+	if( !state->events )
+	{
+		state->eventsLost = true;
+		return NULL;
+	}
+
+	ImuiInputEvent* event;
+	if( state->eventCount == state->eventCapacity )
+	{
+		// overwrite the oldest event, the snapshot still has the final state
+		event = &state->events[ state->eventFirst ];
+		state->eventFirst = (state->eventFirst + 1u) % state->eventCapacity;
+		state->eventsLost = true;
+	}
+	else
+	{
+		event = &state->events[ (state->eventFirst + state->eventCount) % state->eventCapacity ];
+		state->eventCount++;
+	}
+
+	event->time		= state->eventTime;
+	event->type		= type;
+	event->code		= code;
+	event->data.pos	= state->current.mousePos;
+
+	return event;
+}
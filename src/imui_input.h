@@ -33,12 +33,28 @@ typedef struct ImuiInputData
 	ImuiInputShortcut				shortcut;
 } ImuiInputData;
 
+enum
+{
+	ImuiInputTransition_Pressed		= 1u << 0u,
+	ImuiInputTransition_Released	= 1u << 1u
+};
+
 typedef struct ImuiInputState
 {
 	ImuiInputState*					nextState;
 
 	ImuiInputData					current;
 	ImuiInputData					last;
+
+	uint8							mouseButtonTransitions[ ImuiInputMouseButton_MAX ];	// ImuiInputTransition, only in event mode
+	uint8							keyTransitions[ ImuiInputKey_MAX ];
+
+	ImuiInputEvent*					events;			// ring buffer, kept when the state gets recycled
+	uintsize						eventCapacity;
+	uintsize						eventFirst;
+	uintsize						eventCount;
+	double							eventTime;
+	bool							eventsLost;
 } ImuiInputState;
 
 typedef struct ImuiInputStateChunk
@@ -55,6 +71,8 @@ struct ImuiInput
 	const ImuiInputShortcutConfig*	shortcuts;
 	size_t							shortcutCount;
 
+	uintsize						eventCapacity;
+
 	ImuiInputStateChunk*			firstStateChunk;
 
 	ImuiInputState*					newStates;
@@ -69,10 +87,12 @@ struct ImuiInput
 	ImuiInputMouseCursor			mouseCursor;
 };
 
-bool								imuiInputConstruct( ImuiInput* input, ImuiAllocator* allocator, const ImuiInputShortcutConfig* shortcuts, size_t shortcutCount );
+bool								imuiInputConstruct( ImuiInput* input, ImuiAllocator* allocator, const ImuiInputShortcutConfig* shortcuts, size_t shortcutCount, size_t eventCapacity );
 void								imuiInputDestruct( ImuiInput* input );
 
 void								imuiInputEndFrame( ImuiInput* input );
 
 bool								imuiInputBeginState( ImuiInput* input, const ImuiInputState* previousState );
 const ImuiInputState*				imuiInputEndState( ImuiInput* input );
+
+bool								imuiInputHasChanges( const ImuiInputState* input );
@@ -5,9 +5,18 @@
 #include "imui_draw.h"
 #include "imui_input.h"
 #include "imui_helpers.h"
+#include "imui_stats.h"
 #include "imui_types.h"
 #include "imui_text.h"
 
+typedef struct ImuiSurfaceHitTest
+{
+	bool					valid;
+	const ImuiWindow*		window;			// a window with the highest z-order at the position
+	uint32					zOrder;
+	uintsize				count;			// windows with zOrder at the position
+} ImuiSurfaceHitTest;
+
 struct ImuiSurface
 {
 	bool					inUse;
@@ -25,6 +34,10 @@ struct ImuiSurface
 	ImuiWindow*				windows;
 	uintsize				windowCapacity;
 	uintsize				windowCount;
+
+	bool					hitTestValid;		// reset when input or windows change
+	ImuiSurfaceHitTest*		hitTests;			// mouse position first, then one per input event
+	uintsize				hitTestCapacity;
 };
 
 struct ImuiWindow
@@ -39,6 +52,7 @@ struct ImuiWindow
 	ImuiRect		rect;
 	uint32			zOrder;
 	bool			hasFocus;
+	bool			hasFocusQuery;	// directional input or focus shortcut in this frame
 	bool			focusLocked;
 	bool			focusWrap;
 	ImuiPos			focusPoint;
@@ -198,23 +212,58 @@ struct ImuiWidgetChunk
 	uintsize				usedCount;
 };
 
+typedef struct ImuiFocusCell
+{
+	float					maxFactor;		// upper bound of the focus factor of all widgets in the cell
+	uint32					index;
+} ImuiFocusCell;
+
+typedef struct ImuiFocusCandidates
+{
+	ImuiWidget**			widgets;		// focusable widgets of the window in layout order
+	uintsize				widgetCapacity;
+	uintsize				widgetCount;
+	ImuiPos*				centers;		// of the widget rects at collection time
+	uintsize				centerCapacity;
+
+	uint32*					cellStarts;		// uniform grid over the widget centers, cellCount + 1 prefix sums
+	uintsize				cellStartCapacity;
+	uint32*					cellWidgets;	// widget indices sorted by cell
+	uintsize				cellWidgetCapacity;
+	ImuiFocusCell*			cells;			// non-empty cells sorted by maxFactor
+	uintsize				cellCapacity;
+
+	ImuiPos*				gridCenters;	// centers the grid was built from
+	uintsize				gridCenterCapacity;
+	uintsize				gridCenterCount;
+	ImuiPos					gridPos;
+	ImuiSize				gridCellSize;
+	uint32					gridSide;		// 0 if the grid is not built
+} ImuiFocusCandidates;
+
 struct ImuiFrame
 {
 	ImuiContext*			context;
 	uint32					index;
 	double					timeInSeconds;
+	double					nextUpdateTime;		// DBL_MAX if no widget requested an update
+	bool					hasChanges;			// any surface was dirty or got new input
 };
 
 struct ImuiContext
 {
 	ImuiAllocator			allocator;
+	ImuiStats				stats;
 
 	ImuiInput				input;
 	ImuiDraw				draw;
 	ImuiStringPool			strings;
+	ImuiStringArena			frameStrings;	// cleared every frame
 	ImuiTextLayoutCache		layoutCache;
 
 	ImuiFrame				frame;
+	double					nextUpdateTime;		// of the last finished frame
+	bool					lastFrameHasChanges;
 
 	ImuiSurface*			surfaces;
 	uintsize				surfaceCapacity;
@@ -229,6 +278,8 @@ struct ImuiContext
 
 	ImuiLayoutGridContext*	firstGridContext;
 	ImuiLayoutGridContext*	firstUnusedGridContext;
+
+	ImuiFocusCandidates		focusCandidates;	// of the window in layout
 };
 
 ImuiStringView				imuiStringViewCreate( const char* str );
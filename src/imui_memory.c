@@ -107,10 +107,10 @@ bool imuiMemoryArrayCheckCapacity( ImuiAllocator* allocator, void** memory, uint
 		return true;
 	}
 
-	uintsize nextCapacity = IMUI_NEXT_POWER_OF_TWO( requiredCapacity );
-	if( nextCapacity < IMUI_DEFAULT_ARRAY_CAPACITY )
+	uintsize nextCapacity = IMUI_DEFAULT_ARRAY_CAPACITY;
+	if( requiredCapacity > IMUI_DEFAULT_ARRAY_CAPACITY )
 	{
-		nextCapacity = IMUI_DEFAULT_ARRAY_CAPACITY;
+		nextCapacity = IMUI_NEXT_POWER_OF_TWO( requiredCapacity );
 	}
 
 	const uintsize oldSize = *capacity * elementSize;
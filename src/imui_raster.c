@@ -0,0 +1,401 @@
+#include "imui/imui_raster.h"
+
+#include "imui_types.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#if defined( IMUI_SIMD_SSE2 )
+#	include <emmintrin.h>
+#elif defined( IMUI_SIMD_NEON )
+#	include <arm_neon.h>
+#endif
+
+static_assert( sizeof( ImuiRasterVertex ) == 8u * sizeof( float ), "vertex must match the default vertex format" );
+
+typedef struct ImuiRasterClip
+{
+	sint32						minX;
+	sint32						minY;
+	sint32						maxX;		// exclusive
+	sint32						maxY;
+} ImuiRasterClip;
+
+typedef struct ImuiRasterGradient
+{
+	float						dx;
+	float						dy;
+} ImuiRasterGradient;
+
+static ImuiRasterClip	imuiRasterClipCreate( const ImuiRasterTarget* target, ImuiRect rect );
+static void				imuiRasterDrawTriangle( const ImuiRasterTarget* target, const ImuiRasterClip* clip, const ImuiRasterTexture* texture, const ImuiRasterVertex* v0, const ImuiRasterVertex* v1, const ImuiRasterVertex* v2 );
+static void				imuiRasterDrawLine( const ImuiRasterTarget* target, const ImuiRasterClip* clip, const ImuiRasterTexture* texture, const ImuiRasterVertex* v0, const ImuiRasterVertex* v1 );
+static float			imuiRasterEdgeGetX( const ImuiRasterVertex* p0, const ImuiRasterVertex* p1, float y );
+static ImuiRasterGradient	imuiRasterGradientCreate( const ImuiRasterVertex* v0, const ImuiRasterVertex* v1, const ImuiRasterVertex* v2, float a0, float a1, float a2 );
+static void				imuiRasterColorCreate( uint8 target[ 4u ], float red, float green, float blue, float alpha );
+static void				imuiRasterSample( uint8 target[ 4u ], const ImuiRasterTexture* texture, const uint8 color[ 4u ], float u, float v );
+static void				imuiRasterBlendPixel( uint8* pixel, const uint8 color[ 4u ] );
+static void				imuiRasterBlendSpan( uint8* pixels, uintsize count, const uint8 color[ 4u ] );
+
+static inline uint32 imuiRasterDiv255( uint32 value )
+{
+	// exact for value <= 255 * 255, the SIMD path uses the same formula
+	const uint32 temp = value + 128u;
+	return (temp + (temp >> 8u)) >> 8u;
+}
+
+void imuiRasterClear( const ImuiRasterTarget* target, ImuiColor color )
+{
+	for( uint32 y = 0u; y < target->height; ++y )
+	{
+		uint8* row = target->pixels + (y * target->stride);
+		for( uint32 x = 0u; x < target->width; ++x )
+		{
+			row[ (x * 4u) + 0u ] = color.red;
+			row[ (x * 4u) + 1u ] = color.green;
+			row[ (x * 4u) + 2u ] = color.blue;
+			row[ (x * 4u) + 3u ] = color.alpha;
+		}
+	}
+}
+
+void imuiRasterDraw( const ImuiRasterTarget* target, const ImuiDrawData* data, const void* vertexData, const uint32_t* indexData, const ImuiRect* limitRect )
+{
+	const ImuiRasterVertex* vertices = (const ImuiRasterVertex*)vertexData;
+
+	ImuiRasterClip limitClip = imuiRasterClipCreate( target, imuiRectCreate( 0.0f, 0.0f, (float)target->width, (float)target->height ) );
+	if( limitRect )
+	{
+		const ImuiRasterClip rectClip = imuiRasterClipCreate( target, *limitRect );
+		limitClip.minX = IMUI_MAX( limitClip.minX, rectClip.minX );
+		limitClip.minY = IMUI_MAX( limitClip.minY, rectClip.minY );
+		limitClip.maxX = IMUI_MIN( limitClip.maxX, rectClip.maxX );
+		limitClip.maxY = IMUI_MIN( limitClip.maxY, rectClip.maxY );
+	}
+
+	uintsize offset = 0u;
+	for( uintsize i = 0u; i < data->commandCount; ++i )
+	{
+		const ImuiDrawCommand* command = &data->commands[ i ];
+		const ImuiRasterTexture* texture = (const ImuiRasterTexture*)(uintptr_t)command->textureHandle;
+
+		ImuiRasterClip clip = imuiRasterClipCreate( target, command->clipRect );
+		clip.minX = IMUI_MAX( clip.minX, limitClip.minX );
+		clip.minY = IMUI_MAX( clip.minY, limitClip.minY );
+		clip.maxX = IMUI_MIN( clip.maxX, limitClip.maxX );
+		clip.maxY = IMUI_MIN( clip.maxY, limitClip.maxY );
+
+		const uintsize begin = offset;
+		offset += command->count;
+		if( clip.minX >= clip.maxX || clip.minY >= clip.maxY )
+		{
+			continue;
+		}
+
+		if( command->topology == ImuiDrawTopology_LineList )
+		{
+			for( uintsize j = begin; j + 1u < offset; j += 2u )
+			{
+				const ImuiRasterVertex* v0 = &vertices[ indexData ? indexData[ j ] : j ];
+				const ImuiRasterVertex* v1 = &vertices[ indexData ? indexData[ j + 1u ] : j + 1u ];
+				imuiRasterDrawLine( target, &clip, texture, v0, v1 );
+			}
+		}
+		else
+		{
+			for( uintsize j = begin; j + 2u < offset; j += 3u )
+			{
+				const ImuiRasterVertex* v0 = &vertices[ indexData ? indexData[ j ] : j ];
+				const ImuiRasterVertex* v1 = &vertices[ indexData ? indexData[ j + 1u ] : j + 1u ];
+				const ImuiRasterVertex* v2 = &vertices[ indexData ? indexData[ j + 2u ] : j + 2u ];
+				imuiRasterDrawTriangle( target, &clip, texture, v0, v1, v2 );
+			}
+		}
+	}
+}
+
+static ImuiRasterClip imuiRasterClipCreate( const ImuiRasterTarget* target, ImuiRect rect )
+{
+	// pixels are covered if their center is inside
+	ImuiRasterClip clip;
+	clip.minX = IMUI_MAX( (sint32)ceilf( rect.pos.x - 0.5f ), 0 );
+	clip.minY = IMUI_MAX( (sint32)ceilf( rect.pos.y - 0.5f ), 0 );
+	clip.maxX = IMUI_MIN( (sint32)ceilf( rect.pos.x + rect.size.width - 0.5f ), (sint32)target->width );
+	clip.maxY = IMUI_MIN( (sint32)ceilf( rect.pos.y + rect.size.height - 0.5f ), (sint32)target->height );
+	return clip;
+}
+
+static void imuiRasterDrawTriangle( const ImuiRasterTarget* target, const ImuiRasterClip* clip, const ImuiRasterTexture* texture, const ImuiRasterVertex* v0, const ImuiRasterVertex* v1, const ImuiRasterVertex* v2 )
+{
+	// sort by y and then x so edges shared by two triangles are evaluated the same way and leave no gaps
+	const ImuiRasterVertex* sorted[ 3u ] = { v0, v1, v2 };
+	for( uintsize i = 1u; i < 3u; ++i )
+	{
+		for( uintsize j = i; j > 0u && (sorted[ j ]->y < sorted[ j - 1u ]->y || (sorted[ j ]->y == sorted[ j - 1u ]->y && sorted[ j ]->x < sorted[ j - 1u ]->x)); --j )
+		{
+			const ImuiRasterVertex* temp = sorted[ j ];
+			sorted[ j ]			= sorted[ j - 1u ];
+			sorted[ j - 1u ]	= temp;
+		}
+	}
+
+	const ImuiRasterVertex* a = sorted[ 0u ];
+	const ImuiRasterVertex* b = sorted[ 1u ];
+	const ImuiRasterVertex* c = sorted[ 2u ];
+
+	const float area = ((b->x - a->x) * (c->y - a->y)) - ((c->x - a->x) * (b->y - a->y));
+	if( area == 0.0f )
+	{
+		return;
+	}
+
+	const sint32 rowBegin	= IMUI_MAX( (sint32)ceilf( a->y - 0.5f ), clip->minY );
+	const sint32 rowEnd		= IMUI_MIN( (sint32)ceilf( c->y - 0.5f ), clip->maxY );
+	if( rowBegin >= rowEnd )
+	{
+		return;
+	}
+
+	const bool isConstantColor = memcmp( &a->red, &b->red, sizeof( float ) * 4u ) == 0 && memcmp( &a->red, &c->red, sizeof( float ) * 4u ) == 0;
+	const bool isTextured = texture != NULL;
+
+	uint8 color[ 4u ];
+	imuiRasterColorCreate( color, a->red, a->green, a->blue, a->alpha );
+
+	ImuiRasterGradient gradients[ 6u ];
+	if( isTextured )
+	{
+		gradients[ 0u ] = imuiRasterGradientCreate( a, b, c, a->u, b->u, c->u );
+		gradients[ 1u ] = imuiRasterGradientCreate( a, b, c, a->v, b->v, c->v );
+	}
+
+	if( !isConstantColor )
+	{
+		gradients[ 2u ] = imuiRasterGradientCreate( a, b, c, a->red, b->red, c->red );
+		gradients[ 3u ] = imuiRasterGradientCreate( a, b, c, a->green, b->green, c->green );
+		gradients[ 4u ] = imuiRasterGradientCreate( a, b, c, a->blue, b->blue, c->blue );
+		gradients[ 5u ] = imuiRasterGradientCreate( a, b, c, a->alpha, b->alpha, c->alpha );
+	}
+
+	for( sint32 y = rowBegin; y < rowEnd; ++y )
+	{
+		const float centerY = (float)y + 0.5f;
+		const float longX	= imuiRasterEdgeGetX( a, c, centerY );
+		const float shortX	= centerY < b->y ? imuiRasterEdgeGetX( a, b, centerY ) : imuiRasterEdgeGetX( b, c, centerY );
+
+		const sint32 columnBegin	= IMUI_MAX( (sint32)ceilf( IMUI_MIN( longX, shortX ) - 0.5f ), clip->minX );
+		const sint32 columnEnd		= IMUI_MIN( (sint32)ceilf( IMUI_MAX( longX, shortX ) - 0.5f ), clip->maxX );
+		if( columnBegin >= columnEnd )
+		{
+			continue;
+		}
+
+		uint8* pixels = target->pixels + (y * target->stride) + (columnBegin * 4u);
+		if( !isTextured && isConstantColor )
+		{
+			imuiRasterBlendSpan( pixels, (uintsize)(columnEnd - columnBegin), color );
+			continue;
+		}
+
+		const float offsetX = ((float)columnBegin + 0.5f) - a->x;
+		const float offsetY = centerY - a->y;
+
+		float values[ 6u ] = { a->u, a->v, a->red, a->green, a->blue, a->alpha };
+		for( uintsize i = 0u; i < 6u; ++i )
+		{
+			if( (i < 2u && isTextured) || (i >= 2u && !isConstantColor) )
+			{
+				values[ i ] += (gradients[ i ].dx * offsetX) + (gradients[ i ].dy * offsetY);
+			}
+		}
+
+		for( sint32 x = columnBegin; x < columnEnd; ++x, pixels += 4u )
+		{
+			if( !isConstantColor )
+			{
+				imuiRasterColorCreate( color, values[ 2u ], values[ 3u ], values[ 4u ], values[ 5u ] );
+				for( uintsize i = 2u; i < 6u; ++i )
+				{
+					values[ i ] += gradients[ i ].dx;
+				}
+			}
+
+			uint8 pixelColor[ 4u ];
+			if( isTextured )
+			{
+				imuiRasterSample( pixelColor, texture, color, values[ 0u ], values[ 1u ] );
+				values[ 0u ] += gradients[ 0u ].dx;
+				values[ 1u ] += gradients[ 1u ].dx;
+			}
+			else
+			{
+				memcpy( pixelColor, color, sizeof( pixelColor ) );
+			}
+
+			imuiRasterBlendPixel( pixels, pixelColor );
+		}
+	}
+}
+
+static void imuiRasterDrawLine( const ImuiRasterTarget* target, const ImuiRasterClip* clip, const ImuiRasterTexture* texture, const ImuiRasterVertex* v0, const ImuiRasterVertex* v1 )
+{
+	uint8 color[ 4u ];
+	imuiRasterColorCreate( color, v0->red, v0->green, v0->blue, v0->alpha );
+	if( texture )
+	{
+		imuiRasterSample( color, texture, color, v0->u, v0->v );
+	}
+
+	// one pixel per step along the major axis, the last pixel is left out like most GPUs do
+	const float deltaX		= v1->x - v0->x;
+	const float deltaY		= v1->y - v0->y;
+	const sint32 stepCount	= (sint32)ceilf( IMUI_MAX( fabsf( deltaX ), fabsf( deltaY ) ) );
+	for( sint32 i = 0; i < stepCount; ++i )
+	{
+		const float factor	= (float)i / (float)stepCount;
+		const sint32 x		= (sint32)floorf( v0->x + (deltaX * factor) );
+		const sint32 y		= (sint32)floorf( v0->y + (deltaY * factor) );
+		if( x < clip->minX || x >= clip->maxX ||
+			y < clip->minY || y >= clip->maxY )
+		{
+			continue;
+		}
+
+		imuiRasterBlendPixel( target->pixels + (y * target->stride) + (x * 4u), color );
+	}
+}
+
+static float imuiRasterEdgeGetX( const ImuiRasterVertex* p0, const ImuiRasterVertex* p1, float y )
+{
+	return p0->x + ((p1->x - p0->x) * ((y - p0->y) / (p1->y - p0->y)));
+}
+
+static ImuiRasterGradient imuiRasterGradientCreate( const ImuiRasterVertex* v0, const ImuiRasterVertex* v1, const ImuiRasterVertex* v2, float a0, float a1, float a2 )
+{
+	const float x1 = v1->x - v0->x;
+	const float y1 = v1->y - v0->y;
+	const float x2 = v2->x - v0->x;
+	const float y2 = v2->y - v0->y;
+	const float area = (x1 * y2) - (x2 * y1);
+
+	ImuiRasterGradient gradient;
+	gradient.dx = (((a1 - a0) * y2) - ((a2 - a0) * y1)) / area;
+	gradient.dy = (((a2 - a0) * x1) - ((a1 - a0) * x2)) / area;
+	return gradient;
+}
+
+static void imuiRasterColorCreate( uint8 target[ 4u ], float red, float green, float blue, float alpha )
+{
+	target[ 0u ] = (uint8)(IMUI_MAX( IMUI_MIN( red, 1.0f ), 0.0f ) * 255.0f + 0.5f);
+	target[ 1u ] = (uint8)(IMUI_MAX( IMUI_MIN( green, 1.0f ), 0.0f ) * 255.0f + 0.5f);
+	target[ 2u ] = (uint8)(IMUI_MAX( IMUI_MIN( blue, 1.0f ), 0.0f ) * 255.0f + 0.5f);
+	target[ 3u ] = (uint8)(IMUI_MAX( IMUI_MIN( alpha, 1.0f ), 0.0f ) * 255.0f + 0.5f);
+}
+
+static void imuiRasterSample( uint8 target[ 4u ], const ImuiRasterTexture* texture, const uint8 color[ 4u ], float u, float v )
+{
+	// nearest filtering with clamped coordinates
+	const sint32 x = IMUI_MAX( IMUI_MIN( (sint32)floorf( u * (float)texture->width ), (sint32)texture->width - 1 ), 0 );
+	const sint32 y = IMUI_MAX( IMUI_MIN( (sint32)floorf( v * (float)texture->height ), (sint32)texture->height - 1 ), 0 );
+
+	if( texture->format == ImuiRasterTextureFormat_R8 )
+	{
+		const uint8 coverage = texture->data[ (y * texture->width) + x ];
+		target[ 0u ] = color[ 0u ];
+		target[ 1u ] = color[ 1u ];
+		target[ 2u ] = color[ 2u ];
+		target[ 3u ] = (uint8)imuiRasterDiv255( color[ 3u ] * coverage );
+		return;
+	}
+
+	const uint8* texel = texture->data + (((y * texture->width) + x) * 4u);
+	for( uintsize i = 0u; i < 4u; ++i )
+	{
+		target[ i ] = (uint8)imuiRasterDiv255( color[ i ] * texel[ i ] );
+	}
+}
+
+static void imuiRasterBlendPixel( uint8* pixel, const uint8 color[ 4u ] )
+{
+	const uint32 alpha			= color[ 3u ];
+	const uint32 inverseAlpha	= 255u - alpha;
+	pixel[ 0u ] = (uint8)(imuiRasterDiv255( color[ 0u ] * alpha ) + imuiRasterDiv255( pixel[ 0u ] * inverseAlpha ));
+	pixel[ 1u ] = (uint8)(imuiRasterDiv255( color[ 1u ] * alpha ) + imuiRasterDiv255( pixel[ 1u ] * inverseAlpha ));
+	pixel[ 2u ] = (uint8)(imuiRasterDiv255( color[ 2u ] * alpha ) + imuiRasterDiv255( pixel[ 2u ] * inverseAlpha ));
+	pixel[ 3u ] = (uint8)(alpha + imuiRasterDiv255( pixel[ 3u ] * inverseAlpha ));
+}
+
+static void imuiRasterBlendSpan( uint8* pixels, uintsize count, const uint8 color[ 4u ] )
+{
+	const uint32 alpha			= color[ 3u ];
+	const uint32 inverseAlpha	= 255u - alpha;
+	if( alpha == 0u )
+	{
+		return;
+	}
+
+	uint8 premultiplied[ 4u ];
+	premultiplied[ 0u ] = (uint8)imuiRasterDiv255( color[ 0u ] * alpha );
+	premultiplied[ 1u ] = (uint8)imuiRasterDiv255( color[ 1u ] * alpha );
+	premultiplied[ 2u ] = (uint8)imuiRasterDiv255( color[ 2u ] * alpha );
+	premultiplied[ 3u ] = (uint8)alpha;
+
+	if( inverseAlpha == 0u )
+	{
+		for( uintsize i = 0u; i < count; ++i )
+		{
+			memcpy( pixels + (i * 4u), premultiplied, sizeof( premultiplied ) );
+		}
+		return;
+	}
+
+	uintsize i = 0u;
+#if defined( IMUI_SIMD_SSE2 )
+	// 4 pixels per step in 16 bit lanes, same rounding as imuiRasterDiv255
+	uint32 premultipliedValue;
+	memcpy( &premultipliedValue, premultiplied, sizeof( premultipliedValue ) );
+
+	const __m128i zero			= _mm_setzero_si128();
+	const __m128i inverse		= _mm_set1_epi16( (short)inverseAlpha );
+	const __m128i bias			= _mm_set1_epi16( 128 );
+	const __m128i source		= _mm_set1_epi32( (int)premultipliedValue );
+	for( ; i + 4u <= count; i += 4u )
+	{
+		const __m128i destination	= _mm_loadu_si128( (const __m128i*)(pixels + (i * 4u)) );
+
+		__m128i low		= _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( destination, zero ), inverse ), bias );
+		__m128i high	= _mm_add_epi16( _mm_mullo_epi16( _mm_unpackhi_epi8( destination, zero ), inverse ), bias );
+		low				= _mm_srli_epi16( _mm_add_epi16( low, _mm_srli_epi16( low, 8 ) ), 8 );
+		high			= _mm_srli_epi16( _mm_add_epi16( high, _mm_srli_epi16( high, 8 ) ), 8 );
+
+		_mm_storeu_si128( (__m128i*)(pixels + (i * 4u)), _mm_add_epi8( _mm_packus_epi16( low, high ), source ) );
+	}
+#elif defined( IMUI_SIMD_NEON )
+	const uint8x8_t inverse		= vdup_n_u8( (uint8_t)inverseAlpha );
+	const uint16x8_t bias		= vdupq_n_u16( 128u );
+	uint32_t premultipliedValue;
+	memcpy( &premultipliedValue, premultiplied, sizeof( premultipliedValue ) );
+	const uint8x16_t source		= vreinterpretq_u8_u32( vdupq_n_u32( premultipliedValue ) );
+	for( ; i + 4u <= count; i += 4u )
+	{
+		const uint8x16_t destination = vld1q_u8( pixels + (i * 4u) );
+
+		uint16x8_t low		= vaddq_u16( vmull_u8( vget_low_u8( destination ), inverse ), bias );
+		uint16x8_t high		= vaddq_u16( vmull_u8( vget_high_u8( destination ), inverse ), bias );
+		low					= vshrq_n_u16( vaddq_u16( low, vshrq_n_u16( low, 8 ) ), 8 );
+		high				= vshrq_n_u16( vaddq_u16( high, vshrq_n_u16( high, 8 ) ), 8 );
+
+		vst1q_u8( pixels + (i * 4u), vaddq_u8( vcombine_u8( vmovn_u16( low ), vmovn_u16( high ) ), source ) );
+	}
+#endif
+
+	for( ; i < count; ++i )
+	{
+		uint8* pixel = pixels + (i * 4u);
+		pixel[ 0u ] = (uint8)(premultiplied[ 0u ] + imuiRasterDiv255( pixel[ 0u ] * inverseAlpha ));
+		pixel[ 1u ] = (uint8)(premultiplied[ 1u ] + imuiRasterDiv255( pixel[ 1u ] * inverseAlpha ));
+		pixel[ 2u ] = (uint8)(premultiplied[ 2u ] + imuiRasterDiv255( pixel[ 2u ] * inverseAlpha ));
+		pixel[ 3u ] = (uint8)(premultiplied[ 3u ] + imuiRasterDiv255( pixel[ 3u ] * inverseAlpha ));
+	}
+}
@@ -0,0 +1,457 @@
+#include "imui_stats.h"
+
+#include "imui_memory.h"
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct ImuiStatsAllocationHeader	// in front of every tagged allocation
+{
+	uintsize		size;
+	uint32			tag;
+} ImuiStatsAllocationHeader;
+
+#define IMUI_STATS_ALLOCATION_HEADER_SIZE	16u		// keeps the alignment of the allocator
+
+static_assert( sizeof( ImuiStatsAllocationHeader ) <= IMUI_STATS_ALLOCATION_HEADER_SIZE, "header too big" );
+
+static const char* s_memoryTagNames[] =
+{
+	"General",
+	"Widgets",
+	"States",
+	"TextLayouts",
+	"Draw",
+	"Fonts",
+	"Input",
+	"Strings"
+};
+static_assert( IMUI_ARRAY_COUNT( s_memoryTagNames ) == ImuiMemoryTag_MAX, "more memory tags" );
+
+typedef struct ImuiStatsTraceWriter
+{
+	char*			buffer;
+	uintsize		capacity;
+	uintsize		length;
+} ImuiStatsTraceWriter;
+
+#if !defined( IMUI_NO_STATS )
+static void*	imuiStatsAlloc( uintsize size, void* userData );
+static void*	imuiStatsRealloc( void* oldMemory, uintsize oldSize, uintsize newSize, void* userData );
+static void		imuiStatsFree( void* memory, void* userData );
+static void		imuiStatsMemoryTagAdd( ImuiStatsMemoryTag* tag, uintsize oldSize, uintsize newSize );
+
+static double	imuiStatsTraceGetTime( const ImuiStats* stats );
+#endif
+
+static void		imuiStatsTraceWriteFormat( ImuiStatsTraceWriter* writer, const char* format, ... );
+static void		imuiStatsTraceWriteString( ImuiStatsTraceWriter* writer, const char* string );
+
+void imuiStatsConstruct( ImuiStats* stats, ImuiAllocator* allocator, const ImuiParameters* parameters )
+{
+	memset( stats, 0, sizeof( *stats ) );
+	stats->allocator		= *allocator;
+	stats->clockFunc		= parameters->clockFunc;
+	stats->clockUserData	= parameters->clockUserData;
+
+	for( uintsize i = 0u; i < ImuiMemoryTag_MAX; ++i )
+	{
+		stats->tagAllocators[ i ] = *allocator;
+	}
+
+#if !defined( IMUI_NO_STATS )
+	stats->memoryBudgetFunc	= parameters->memoryBudgetFunc;
+	stats->memoryLeakFunc	= parameters->memoryLeakFunc;
+	stats->memoryUserData	= parameters->memoryUserData;
+
+	for( uintsize i = 0u; i < ImuiMemoryTag_MAX; ++i )
+	{
+		ImuiStatsMemoryTag* tag = &stats->tags[ i ];
+		tag->stats			= stats;
+		tag->tag			= (ImuiMemoryTag)i;
+		tag->data.budget	= parameters->memoryBudgets[ i ];
+
+		ImuiAllocator* tagAllocator = &stats->tagAllocators[ i ];
+		tagAllocator->mallocFunc	= imuiStatsAlloc;
+		tagAllocator->freeFunc		= imuiStatsFree;
+		tagAllocator->userData		= tag;
+
+		// pseudo realloc already goes through alloc and free of the allocator
+		if( allocator->reallocFunc == imuiMemoryPseudoRealloc )
+		{
+			tagAllocator->internalData	= tagAllocator;
+		}
+		else
+		{
+			tagAllocator->reallocFunc	= imuiStatsRealloc;
+			tagAllocator->internalData	= tag;
+		}
+	}
+
+	*allocator = stats->tagAllocators[ ImuiMemoryTag_General ];
+
+	if( parameters->zoneBeginFunc && parameters->zoneEndFunc )
+	{
+		stats->zoneBeginFunc	= parameters->zoneBeginFunc;
+		stats->zoneEndFunc		= parameters->zoneEndFunc;
+		stats->zoneUserData		= parameters->zoneUserData;
+		stats->hasZones			= true;
+	}
+#endif
+}
+
+void imuiStatsDestruct( ImuiStats* stats, ImuiAllocator* allocator )
+{
+	if( stats->memoryLeakFunc )
+	{
+		for( uintsize i = 0u; i < ImuiMemoryTag_MAX; ++i )
+		{
+			const ImuiStatsMemoryTag* tag = &stats->tags[ i ];
+			if( tag->data.allocationCount > 0u )
+			{
+				stats->memoryLeakFunc( tag->tag, &tag->data, stats->memoryUserData );
+			}
+		}
+	}
+
+	*allocator = stats->allocator;
+
+	imuiMemoryFree( allocator, stats->trace.events );
+	stats->trace.events = NULL;
+}
+
+ImuiAllocator* imuiStatsGetAllocator( ImuiStats* stats, ImuiMemoryTag tag )
+{
+	return &stats->tagAllocators[ tag ];
+}
+
+const char* imuiMemoryTagGetName( ImuiMemoryTag tag )
+{
+	return tag < ImuiMemoryTag_MAX ? s_memoryTagNames[ tag ] : NULL;
+}
+
+void imuiStatsBeginFrame( ImuiStats* stats )
+{
+#if !defined( IMUI_NO_STATS )
+	stats->frameStartTime = imuiStatsGetTime( stats );
+#else
+	(void)stats;
+#endif
+}
+
+void imuiStatsEndFrame( ImuiStats* stats )
+{
+#if !defined( IMUI_NO_STATS )
+	imuiStatsAddPhaseTime( stats, ImuiFramePhase_Frame, stats->frameStartTime );
+
+	stats->last = stats->current;
+	memset( &stats->current, 0, sizeof( stats->current ) );
+#else
+	(void)stats;
+#endif
+}
+
+void imuiStatsZoneBegin( ImuiStats* stats, const char* name, const char* detail, uintsize detailLength )
+{
+#if !defined( IMUI_NO_STATS )
+	if( stats->zoneBeginFunc )
+	{
+		stats->zoneBeginFunc( name, detail, detailLength, stats->zoneUserData );
+	}
+
+	ImuiStatsTrace* trace = &stats->trace;
+	if( !trace->isRecording )
+	{
+		return;
+	}
+
+	// keep room for the end of every open zone so begin and end always match
+	if( trace->skipDepth > 0u ||
+		trace->eventCount + trace->openCount + 2u > trace->eventCapacity )
+	{
+		trace->skipDepth++;
+		return;
+	}
+
+	ImuiStatsTraceEvent* event = &trace->events[ trace->eventCount++ ];
+	event->time	= imuiStatsTraceGetTime( stats ) - trace->startTime;
+	event->name	= name;
+
+	if( !detail )
+	{
+		detailLength = 0u;
+	}
+	else if( detailLength >= sizeof( event->detail ) )
+	{
+		// don't cut inside of an UTF-8 sequence
+		detailLength = sizeof( event->detail ) - 1u;
+		while( detailLength > 0u && ((uint8)detail[ detailLength ] & 0xc0u) == 0x80u )
+		{
+			detailLength--;
+		}
+	}
+
+	if( detailLength > 0u )
+	{
+		memcpy( event->detail, detail, detailLength );
+	}
+	event->detail[ detailLength ] = '\0';
+
+	trace->openCount++;
+#else
+	(void)stats;
+	(void)name;
+	(void)detail;
+	(void)detailLength;
+#endif
+}
+
+void imuiStatsZoneEnd( ImuiStats* stats )
+{
+#if !defined( IMUI_NO_STATS )
+	if( stats->zoneEndFunc )
+	{
+		stats->zoneEndFunc( stats->zoneUserData );
+	}
+
+	ImuiStatsTrace* trace = &stats->trace;
+	if( trace->skipDepth > 0u )
+	{
+		trace->skipDepth--;
+		return;
+	}
+
+	if( trace->openCount == 0u )
+	{
+		// zone was opened before the trace started
+		return;
+	}
+
+	ImuiStatsTraceEvent* event = &trace->events[ trace->eventCount++ ];
+	event->time			= imuiStatsTraceGetTime( stats ) - trace->startTime;
+	event->name			= NULL;
+	event->detail[ 0u ]	= '\0';
+
+	trace->openCount--;
+#else
+	(void)stats;
+#endif
+}
+
+bool imuiStatsTraceBegin( ImuiStats* stats, uintsize maxEventCount )
+{
+#if !defined( IMUI_NO_STATS )
+	ImuiStatsTrace* trace = &stats->trace;
+	if( trace->eventCapacity < maxEventCount )
+	{
+		// tracing memory is not counted in the frame stats
+		imuiMemoryFree( &stats->allocator, trace->events );
+		trace->events			= IMUI_MEMORY_ARRAY_NEW( &stats->allocator, ImuiStatsTraceEvent, maxEventCount );
+		trace->eventCapacity	= trace->events ? maxEventCount : 0u;
+	}
+
+	trace->eventCount	= 0u;
+	trace->openCount	= 0u;
+	trace->skipDepth	= 0u;
+	trace->startTime	= imuiStatsTraceGetTime( stats );
+	trace->isRecording	= trace->events != NULL;
+
+	stats->hasZones = trace->isRecording || stats->zoneBeginFunc;
+	return trace->isRecording;
+#else
+	(void)stats;
+	(void)maxEventCount;
+	return false;
+#endif
+}
+
+void imuiStatsTraceEnd( ImuiStats* stats )
+{
+	stats->trace.isRecording	= false;
+	stats->trace.skipDepth		= 0u;
+	stats->hasZones				= stats->zoneBeginFunc != NULL;
+}
+
+uintsize imuiStatsTraceWrite( const ImuiStats* stats, char* buffer, uintsize bufferSize )
+{
+	ImuiStatsTraceWriter writer;
+	writer.buffer	= buffer;
+	writer.capacity	= buffer ? bufferSize : 0u;
+	writer.length	= 0u;
+
+	imuiStatsTraceWriteFormat( &writer, "{\"traceEvents\":[" );
+
+	const ImuiStatsTrace* trace = &stats->trace;
+	for( uintsize i = 0u; i < trace->eventCount; ++i )
+	{
+		const ImuiStatsTraceEvent* event = &trace->events[ i ];
+		const char* separator = i > 0u ? "," : "";
+		const double timestamp = event->time * 1000000.0;
+
+		if( !event->name )
+		{
+			imuiStatsTraceWriteFormat( &writer, "%s\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":1}", separator, timestamp );
+			continue;
+		}
+
+		imuiStatsTraceWriteFormat( &writer, "%s\n{\"name\":\"%s\",\"cat\":\"imui\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":1", separator, event->name, timestamp );
+		if( event->detail[ 0u ] != '\0' )
+		{
+			imuiStatsTraceWriteFormat( &writer, ",\"args\":{\"detail\":\"" );
+			imuiStatsTraceWriteString( &writer, event->detail );
+			imuiStatsTraceWriteFormat( &writer, "\"}" );
+		}
+		imuiStatsTraceWriteFormat( &writer, "}" );
+	}
+
+	imuiStatsTraceWriteFormat( &writer, "\n]}\n" );
+
+	return writer.length;
+}
+
+#if !defined( IMUI_NO_STATS )
+static void* imuiStatsAlloc( uintsize size, void* userData )
+{
+	ImuiStatsMemoryTag* tag = (ImuiStatsMemoryTag*)userData;
+	ImuiStats* stats = tag->stats;
+
+	ImuiStatsAllocationHeader* header = (ImuiStatsAllocationHeader*)stats->allocator.mallocFunc( size + IMUI_STATS_ALLOCATION_HEADER_SIZE, stats->allocator.userData );
+	if( !header )
+	{
+		return NULL;
+	}
+
+	header->size	= size;
+	header->tag		= tag->tag;
+
+	stats->current.allocationCount++;
+	stats->current.allocationSize += size;
+	tag->data.allocationCount++;
+	imuiStatsMemoryTagAdd( tag, 0u, size );
+
+	return (uint8*)header + IMUI_STATS_ALLOCATION_HEADER_SIZE;
+}
+
+static void* imuiStatsRealloc( void* oldMemory, uintsize oldSize, uintsize newSize, void* userData )
+{
+	ImuiStatsMemoryTag* tag = (ImuiStatsMemoryTag*)userData;
+	ImuiStats* stats = tag->stats;
+
+	ImuiStatsAllocationHeader* oldHeader = NULL;
+	if( oldMemory )
+	{
+		oldHeader = (ImuiStatsAllocationHeader*)((uint8*)oldMemory - IMUI_STATS_ALLOCATION_HEADER_SIZE);
+		oldSize = oldHeader->size + IMUI_STATS_ALLOCATION_HEADER_SIZE;
+		tag = &stats->tags[ oldHeader->tag ];
+	}
+
+	// the allocation stays with its tag. the old size is read before realloc can free the header
+	const uintsize oldTagSize = oldHeader ? oldHeader->size : 0u;
+	ImuiStatsAllocationHeader* header = (ImuiStatsAllocationHeader*)stats->allocator.reallocFunc( oldHeader, oldHeader ? oldSize : 0u, newSize + IMUI_STATS_ALLOCATION_HEADER_SIZE, stats->allocator.internalData );
+	if( !header )
+	{
+		return NULL;
+	}
+
+	header->size	= newSize;
+	header->tag		= tag->tag;
+
+	stats->current.allocationCount++;
+	stats->current.allocationSize += newSize;
+	if( !oldHeader )
+	{
+		tag->data.allocationCount++;
+	}
+	imuiStatsMemoryTagAdd( tag, oldTagSize, newSize );
+
+	return (uint8*)header + IMUI_STATS_ALLOCATION_HEADER_SIZE;
+}
+
+static void imuiStatsFree( void* memory, void* userData )
+{
+	if( !memory )
+	{
+		return;
+	}
+
+	ImuiStatsMemoryTag* tag = (ImuiStatsMemoryTag*)userData;
+	ImuiStats* stats = tag->stats;
+
+	ImuiStatsAllocationHeader* header = (ImuiStatsAllocationHeader*)((uint8*)memory - IMUI_STATS_ALLOCATION_HEADER_SIZE);
+	ImuiStatsMemoryTag* headerTag = &stats->tags[ header->tag ];
+	headerTag->data.allocationCount--;
+	headerTag->data.size -= header->size;
+
+	stats->current.freeCount++;
+
+	stats->allocator.freeFunc( header, stats->allocator.userData );
+}
+
+static void imuiStatsMemoryTagAdd( ImuiStatsMemoryTag* tag, uintsize oldSize, uintsize newSize )
+{
+	ImuiMemoryTagStats* data = &tag->data;
+	const uintsize lastSize = data->size;
+	data->size		= data->size - oldSize + newSize;
+	data->peakSize	= IMUI_MAX( data->peakSize, data->size );
+
+	// report once when the budget gets exceeded
+	ImuiStats* stats = tag->stats;
+	if( stats->memoryBudgetFunc &&
+		data->budget > 0u &&
+		lastSize <= data->budget &&
+		data->size > data->budget )
+	{
+		stats->memoryBudgetFunc( tag->tag, data, stats->memoryUserData );
+	}
+}
+
+static double imuiStatsTraceGetTime( const ImuiStats* stats )
+{
+	if( stats->clockFunc )
+	{
+		return stats->clockFunc( stats->clockUserData );
+	}
+
+	struct timespec time;
+	timespec_get( &time, TIME_UTC );
+	return (double)time.tv_sec + ((double)time.tv_nsec / 1000000000.0);
+}
+#endif
+
+static void imuiStatsTraceWriteFormat( ImuiStatsTraceWriter* writer, const char* format, ... )
+{
+	char* target = writer->length < writer->capacity ? writer->buffer + writer->length : NULL;
+	const uintsize targetSize = target ? writer->capacity - writer->length : 0u;
+
+	va_list args;
+	va_start( args, format );
+	const int length = vsnprintf( target, targetSize, format, args );
+	va_end( args );
+
+	if( length > 0 )
+	{
+		writer->length += (uintsize)length;
+	}
+}
+
+static void imuiStatsTraceWriteString( ImuiStatsTraceWriter* writer, const char* string )
+{
+	for( const char* c = string; *c != '\0'; ++c )
+	{
+		if( *c == '"' || *c == '\\' )
+		{
+			imuiStatsTraceWriteFormat( writer, "\\%c", *c );
+		}
+		else if( (uint8)*c < 0x20u )
+		{
+			imuiStatsTraceWriteFormat( writer, "\\u%04x", (uint8)*c );
+		}
+		else
+		{
+			imuiStatsTraceWriteFormat( writer, "%c", *c );
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "imui/imui.h"
+
+#include "imui_types.h"
+
+// define IMUI_NO_STATS to remove all counters from the hot paths
+#if defined( IMUI_NO_STATS )
+#	define IMUI_STATS_ADD( STATS, FIELD, VALUE )
+#	define IMUI_STATS_PHASE_BEGIN( STATS, NAME )
+#	define IMUI_STATS_PHASE_END( STATS, NAME, PHASE )
+#	define IMUI_STATS_ZONE_BEGIN( STATS, NAME, DETAIL, DETAIL_LENGTH )
+#	define IMUI_STATS_ZONE_END( STATS )
+#else
+#	define IMUI_STATS_ADD( STATS, FIELD, VALUE )		((STATS)->current.FIELD += (VALUE))
+#	define IMUI_STATS_PHASE_BEGIN( STATS, NAME )		const double NAME = imuiStatsGetTime( STATS )
+#	define IMUI_STATS_PHASE_END( STATS, NAME, PHASE )	imuiStatsAddPhaseTime( STATS, PHASE, NAME )
+#	define IMUI_STATS_ZONE_BEGIN( STATS, NAME, DETAIL, DETAIL_LENGTH )	((STATS)->hasZones ? imuiStatsZoneBegin( STATS, NAME, DETAIL, DETAIL_LENGTH ) : (void)0)
+#	define IMUI_STATS_ZONE_END( STATS )									((STATS)->hasZones ? imuiStatsZoneEnd( STATS ) : (void)0)
+#endif
+
+typedef struct ImuiStatsTraceEvent
+{
+	double							time;			// in seconds since imuiTraceBegin
+	const char*						name;			// NULL for the end of a zone
+	char							detail[ IMUI_DEFAULT_TRACE_DETAIL_LENGTH ];
+} ImuiStatsTraceEvent;
+
+typedef struct ImuiStatsTrace
+{
+	bool							isRecording;
+	double							startTime;
+
+	ImuiStatsTraceEvent*			events;
+	uintsize						eventCapacity;
+	uintsize						eventCount;
+	uintsize						openCount;		// recorded zones without end
+	uintsize						skipDepth;		// dropped zones without end
+} ImuiStatsTrace;
+
+typedef struct ImuiStats ImuiStats;
+
+typedef struct ImuiStatsMemoryTag
+{
+	ImuiStats*						stats;
+	ImuiMemoryTag					tag;
+	ImuiMemoryTagStats				data;
+} ImuiStatsMemoryTag;
+
+struct ImuiStats
+{
+	ImuiAllocator					allocator;		// wrapped by the tag allocators to count calls
+	ImuiAllocator					tagAllocators[ ImuiMemoryTag_MAX ];
+	ImuiStatsMemoryTag				tags[ ImuiMemoryTag_MAX ];
+	ImuiMemoryReportFunc			memoryBudgetFunc;
+	ImuiMemoryReportFunc			memoryLeakFunc;
+	void*							memoryUserData;
+
+	ImuiClockFunc					clockFunc;
+	void*							clockUserData;
+	double							frameStartTime;
+
+	ImuiFrameStats					current;
+	ImuiFrameStats					last;
+
+	bool							hasZones;		// callbacks are set or a trace is recording
+	ImuiZoneBeginFunc				zoneBeginFunc;
+	ImuiZoneEndFunc					zoneEndFunc;
+	void*							zoneUserData;
+	ImuiStatsTrace					trace;
+};
+
+void								imuiStatsConstruct( ImuiStats* stats, ImuiAllocator* allocator, const ImuiParameters* parameters );
+void								imuiStatsDestruct( ImuiStats* stats, ImuiAllocator* allocator );
+
+ImuiAllocator*						imuiStatsGetAllocator( ImuiStats* stats, ImuiMemoryTag tag );	// same as the context allocator with IMUI_NO_STATS
+
+void								imuiStatsBeginFrame( ImuiStats* stats );
+void								imuiStatsEndFrame( ImuiStats* stats );
+
+void								imuiStatsZoneBegin( ImuiStats* stats, const char* name, const char* detail, uintsize detailLength );
+void								imuiStatsZoneEnd( ImuiStats* stats );
+
+bool								imuiStatsTraceBegin( ImuiStats* stats, uintsize maxEventCount );
+void								imuiStatsTraceEnd( ImuiStats* stats );
+uintsize							imuiStatsTraceWrite( const ImuiStats* stats, char* buffer, uintsize bufferSize );
+
+static inline double imuiStatsGetTime( const ImuiStats* stats )
+{
+	return stats->clockFunc ? stats->clockFunc( stats->clockUserData ) : 0.0;
+}
+
+static inline void imuiStatsAddPhaseTime( ImuiStats* stats, ImuiFramePhase phase, double startTime )
+{
+	if( stats->clockFunc )
+	{
+		stats->current.phaseTimes[ phase ] += stats->clockFunc( stats->clockUserData ) - startTime;
+	}
+}
@@ -4,17 +4,38 @@
 #include "imui_internal.h"
 #include "imui_memory.h"
 
+#include <assert.h>
 #include <math.h>
+#include <stddef.h>
 #include <string.h>
 
-static ImuiTextLayout*	imuiTextLayoutCreateNew( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters, ImuiTextLayout** mapLayout );
+#if defined( IMUI_SIMD_SSE2 )
+#	include <emmintrin.h>
+#elif defined( IMUI_SIMD_NEON )
+#	include <arm_neon.h>
+#endif
+
+static ImuiTextLayout*				imuiTextLayoutCreateNew( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters, ImuiTextLayout** mapLayout );
+static ImuiTextLayout*				imuiTextLayoutCreateNewWrapped( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters, ImuiTextLayout* unwrappedLayout, ImuiTextLayout** mapLayout );
+static void							imuiTextLayoutFree( ImuiTextLayoutCache* cache, ImuiTextLayout* layout );
+static void							imuiTextLayoutPushUsed( ImuiTextLayoutCache* cache, ImuiTextLayout* layout, ImuiTextLayout** mapLayout );
+static void							imuiTextLayoutUnlink( ImuiTextLayoutCache* cache, ImuiTextLayout* layout );
+
+static_assert( offsetof( ImuiTextLayout, font ) == offsetof( ImuiTextLayoutParameters, font ), "layout key changed" );
+static_assert( offsetof( ImuiTextLayout, text ) == offsetof( ImuiTextLayoutParameters, text ), "layout key changed" );
+static_assert( offsetof( ImuiTextLayout, wrapWidth ) == offsetof( ImuiTextLayoutParameters, wrapWidth ), "layout key changed" );
+static_assert( offsetof( ImuiTextLayout, hAlign ) == offsetof( ImuiTextLayoutParameters, hAlign ), "layout key changed" );
+static_assert( offsetof( ImuiTextLayout, isStatic ) == offsetof( ImuiTextLayoutParameters, isStatic ), "layout key changed" );
+static_assert( offsetof( ImuiTextLayout, textVersion ) == offsetof( ImuiTextLayoutParameters, textVersion ), "layout key changed" );
 
 static ImuiHash ImuiTextLayoutCacheHash( const void* entry )
 {
 	const ImuiTextLayout* layout = *(const ImuiTextLayout**)entry;
 
-	const ImuiHash fontHash = imuiHashCreate( &layout->font, sizeof( &layout->font ) );
-	return imuiHashStringSeed( layout->text, fontHash );
+	ImuiHash hash = imuiHashCreate( &layout->font, sizeof( &layout->font ) );
+	hash = imuiHashCreateSeed( &layout->wrapWidth, sizeof( layout->wrapWidth ), hash );
+	hash = imuiHashCreateSeed( &layout->hAlign, sizeof( layout->hAlign ), hash );
+	return imuiHashStringSeed( layout->text, hash );
 }
 
 static bool ImuiTextLayoutCacheIsKeyEquals( const void* lhs, const void* rhs )
@@ -22,7 +43,9 @@ static bool ImuiTextLayoutCacheIsKeyEquals( const void* lhs, const void* rhs )
 	const ImuiTextLayout* lhsLayout = *(const ImuiTextLayout**)lhs;
 	const ImuiTextLayout* rhsLayout = *(const ImuiTextLayout**)rhs;
 
-	if( lhsLayout->font != rhsLayout->font )
+	if( lhsLayout->font != rhsLayout->font ||
+		lhsLayout->wrapWidth != rhsLayout->wrapWidth ||
+		lhsLayout->hAlign != rhsLayout->hAlign )
 	{
 		return false;
 	}
@@ -43,11 +66,46 @@ static bool ImuiTextLayoutCacheIsKeyEquals( const void* lhs, const void* rhs )
 	return memcmp( lhsLayout->text.data, rhsLayout->text.data, lhsLayout->text.length ) == 0;
 }
 
-bool imuiTextLayoutCacheConstruct( ImuiTextLayoutCache* cache, ImuiAllocator* allocator )
+static ImuiHash ImuiTextLayoutCacheStaticHash( const void* entry )
 {
-	cache->allocator = allocator;
+	const ImuiTextLayout* layout = *(const ImuiTextLayout**)entry;
+
+	ImuiHash hash = imuiHashCreate( &layout->font, sizeof( &layout->font ) );
+	hash = imuiHashCreateSeed( &layout->text, sizeof( layout->text ), hash );
+	hash = imuiHashCreateSeed( &layout->textVersion, sizeof( layout->textVersion ), hash );
+	hash = imuiHashCreateSeed( &layout->wrapWidth, sizeof( layout->wrapWidth ), hash );
+	return imuiHashCreateSeed( &layout->hAlign, sizeof( layout->hAlign ), hash );
+}
+
+static bool ImuiTextLayoutCacheStaticIsKeyEquals( const void* lhs, const void* rhs )
+{
+	const ImuiTextLayout* lhsLayout = *(const ImuiTextLayout**)lhs;
+	const ImuiTextLayout* rhsLayout = *(const ImuiTextLayout**)rhs;
+
+	return lhsLayout->font == rhsLayout->font &&
+		lhsLayout->text.data == rhsLayout->text.data &&
+		lhsLayout->text.length == rhsLayout->text.length &&
+		lhsLayout->textVersion == rhsLayout->textVersion &&
+		lhsLayout->wrapWidth == rhsLayout->wrapWidth &&
+		lhsLayout->hAlign == rhsLayout->hAlign;
+}
+
+static ImuiHashMap* imuiTextLayoutCacheGetMap( ImuiTextLayoutCache* cache, bool isStatic )
+{
+	return isStatic ? &cache->staticLayoutMap : &cache->layoutMap;
+}
 
-	if( !imuiHashMapConstructSize( &cache->layoutMap, allocator, sizeof( ImuiTextLayout* ), ImuiTextLayoutCacheHash, ImuiTextLayoutCacheIsKeyEquals, 64u ) )
+bool imuiTextLayoutCacheConstruct( ImuiTextLayoutCache* cache, ImuiAllocator* allocator, ImuiStats* frameStats, uintsize memoryBudget, uint32 maxAge )
+{
+	cache->allocator		= allocator;
+	cache->frameStats		= frameStats;
+	cache->memoryBudget		= memoryBudget ? memoryBudget : IMUI_DEFAULT_TEXT_LAYOUT_CACHE_BUDGET;
+	cache->maxAge			= maxAge ? maxAge : IMUI_DEFAULT_TEXT_LAYOUT_CACHE_MAX_AGE;
+
+	imuiSlabAllocatorConstruct( &cache->slab, allocator );
+
+	if( !imuiHashMapConstructSize( &cache->layoutMap, allocator, sizeof( ImuiTextLayout* ), ImuiTextLayoutCacheHash, ImuiTextLayoutCacheIsKeyEquals, 64u ) ||
+		!imuiHashMapConstructSize( &cache->staticLayoutMap, allocator, sizeof( ImuiTextLayout* ), ImuiTextLayoutCacheStaticHash, ImuiTextLayoutCacheStaticIsKeyEquals, 16u ) )
 	{
 		imuiTextLayoutCacheDestruct( cache );
 		return false;
@@ -56,54 +114,110 @@ bool imuiTextLayoutCacheConstruct( ImuiTextLayoutCache* cache, ImuiAllocator* al
 	return true;
 }
 
-static void imuiTextLayoutCacheDestruct( ImuiTextLayoutCache* cache )
+void imuiTextLayoutCacheDestruct( ImuiTextLayoutCache* cache )
 {
 	ImuiTextLayout* layout = cache->firstLayout;
 	ImuiTextLayout* nextLayout = NULL;
 	while( layout )
 	{
 		nextLayout = layout->nextLayout;
-		imuiMemoryFree( cache->allocator, layout );
+		imuiTextLayoutFree( cache, layout );
 		layout = nextLayout;
 	}
 
-	layout = cache->firstUnusedLayout;
-	while( layout )
-	{
-		nextLayout = layout->nextLayout;
-		imuiMemoryFree( cache->allocator, layout );
-		layout = nextLayout;
-	}
+	cache->firstLayout	= NULL;
+	cache->lastLayout	= NULL;
 
 	imuiHashMapDestruct( &cache->layoutMap );
+	imuiHashMapDestruct( &cache->staticLayoutMap );
+	imuiSlabAllocatorDestruct( &cache->slab );
 }
 
 void imuiTextLayoutCacheEndFrame( ImuiTextLayoutCache* cache )
 {
-	ImuiTextLayout* unusedLayout = cache->firstUnusedLayout;
-	ImuiTextLayout* nextUnusedLayout = NULL;
-	while( unusedLayout )
+	// layouts used in this frame are referenced by draw data and must stay
+	while( cache->lastLayout && cache->lastLayout->frameIndex != cache->frameIndex )
 	{
-		nextUnusedLayout = unusedLayout->nextLayout;
+		ImuiTextLayout* layout = cache->lastLayout;
+
+		const bool isOverBudget	= cache->stats.memorySize > cache->memoryBudget;
+		const bool isTooOld		= cache->frameIndex - layout->frameIndex >= cache->maxAge;
+		if( !isOverBudget && !isTooOld )
+		{
+			break;
+		}
 
-		const bool removed = imuiHashMapRemove( &cache->layoutMap, &unusedLayout );
+		const bool removed = imuiHashMapRemove( imuiTextLayoutCacheGetMap( cache, layout->isStatic ), &layout );
 		(void)removed;
 		IMUI_ASSERT( removed );
-		imuiMemoryFree( cache->allocator, unusedLayout );
-		unusedLayout = nextUnusedLayout;
+
+		imuiTextLayoutUnlink( cache, layout );
+		imuiTextLayoutFree( cache, layout );
+
+		cache->stats.evictionCount++;
 	}
-	cache->firstUnusedLayout	= cache->firstLayout;
-	cache->firstLayout			= NULL;
 
 	cache->frameIndex++;
 }
 
+void imuiTextLayoutCacheRemoveFont( ImuiTextLayoutCache* cache, const ImuiFont* font )
+{
+	ImuiTextLayout* layout = cache->firstLayout;
+	ImuiTextLayout* nextLayout = NULL;
+	while( layout )
+	{
+		nextLayout = layout->nextLayout;
+
+		if( layout->font == font )
+		{
+			imuiHashMapRemove( imuiTextLayoutCacheGetMap( cache, layout->isStatic ), &layout );
+			imuiTextLayoutUnlink( cache, layout );
+			imuiTextLayoutFree( cache, layout );
+		}
+
+		layout = nextLayout;
+	}
+
+	for( uintsize i = 0u; i < IMUI_ARRAY_COUNT( cache->sizeCache ); ++i )
+	{
+		if( cache->sizeCache[ i ].font == font )
+		{
+			cache->sizeCache[ i ].font = NULL;
+		}
+	}
+}
+
+void imuiTextLayoutCacheGetStats( ImuiContext* imui, ImuiTextLayoutCacheStats* stats )
+{
+	*stats = imui->layoutCache.stats;
+}
+
 ImuiTextLayout* imuiTextLayoutCreate( ImuiContext* imui, ImuiFont* font, const char* text )
 {
 	return imuiTextLayoutCreateLength( imui, font, text, strlen( text ) );
 }
 
 ImuiTextLayout* imuiTextLayoutCreateLength( ImuiContext* imui, ImuiFont* font, const char* text, size_t length )
+{
+	return imuiTextLayoutCreateWrappedLength( imui, font, text, length, 0.0f, 0.0f );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWidget( ImuiWidget* widget, ImuiFont* font, const char* text )
+{
+	return imuiTextLayoutCreateWidgetLength( widget, font, text, strlen( text ) );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWidgetLength( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length )
+{
+	return imuiTextLayoutCreateLength( widget->window->context, font, text, length );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWrapped( ImuiContext* imui, ImuiFont* font, const char* text, float wrapWidth, float hAlign )
+{
+	return imuiTextLayoutCreateWrappedLength( imui, font, text, strlen( text ), wrapWidth, hAlign );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWrappedLength( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, float wrapWidth, float hAlign )
 {
 	if( !font )
 	{
@@ -114,18 +228,56 @@ ImuiTextLayout* imuiTextLayoutCreateLength( ImuiContext* imui, ImuiFont* font, c
 	parameters.font			= font;
 	parameters.text.data	= text;
 	parameters.text.length	= length;
+	parameters.wrapWidth	= wrapWidth;
+	parameters.hAlign		= hAlign;
+	parameters.isStatic		= false;
+	parameters.textVersion	= 0u;
 
 	return imuiTextLayoutCacheCreateLayout( &imui->layoutCache, &parameters );
 }
 
-ImuiTextLayout* imuiTextLayoutCreateWidget( ImuiWidget* widget, ImuiFont* font, const char* text )
+ImuiTextLayout* imuiTextLayoutCreateWidgetWrapped( ImuiWidget* widget, ImuiFont* font, const char* text, float wrapWidth, float hAlign )
 {
-	return imuiTextLayoutCreateWidgetLength( widget, font, text, strlen( text ) );
+	return imuiTextLayoutCreateWidgetWrappedLength( widget, font, text, strlen( text ), wrapWidth, hAlign );
 }
 
-ImuiTextLayout* imuiTextLayoutCreateWidgetLength( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length )
+ImuiTextLayout* imuiTextLayoutCreateWidgetWrappedLength( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, float wrapWidth, float hAlign )
 {
-	return imuiTextLayoutCreateLength( widget->window->context, font, text, length );
+	return imuiTextLayoutCreateWrappedLength( widget->window->context, font, text, length, wrapWidth, hAlign );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateStatic( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, uint64_t textVersion )
+{
+	return imuiTextLayoutCreateStaticWrapped( imui, font, text, length, textVersion, 0.0f, 0.0f );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateStaticWrapped( ImuiContext* imui, ImuiFont* font, const char* text, size_t length, uint64_t textVersion, float wrapWidth, float hAlign )
+{
+	if( !font )
+	{
+		return NULL;
+	}
+
+	ImuiTextLayoutParameters parameters;
+	parameters.font			= font;
+	parameters.text.data	= text;
+	parameters.text.length	= length;
+	parameters.wrapWidth	= wrapWidth;
+	parameters.hAlign		= hAlign;
+	parameters.isStatic		= true;
+	parameters.textVersion	= textVersion;
+
+	return imuiTextLayoutCacheCreateLayout( &imui->layoutCache, &parameters );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWidgetStatic( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, uint64_t textVersion )
+{
+	return imuiTextLayoutCreateStaticWrapped( widget->window->context, font, text, length, textVersion, 0.0f, 0.0f );
+}
+
+ImuiTextLayout* imuiTextLayoutCreateWidgetStaticWrapped( ImuiWidget* widget, ImuiFont* font, const char* text, size_t length, uint64_t textVersion, float wrapWidth, float hAlign )
+{
+	return imuiTextLayoutCreateStaticWrapped( widget->window->context, font, text, length, textVersion, wrapWidth, hAlign );
 }
 
 ImuiTextLayout* imuiTextLayoutCacheCreateLayout( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters )
@@ -135,8 +287,41 @@ ImuiTextLayout* imuiTextLayoutCacheCreateLayout( ImuiTextLayoutCache* cache, con
 		return NULL;
 	}
 
+	// quantize wrap width to keep the cache small while resizing
+	ImuiTextLayoutParameters key = *parameters;
+	if( key.wrapWidth > 0.0f )
+	{
+		key.wrapWidth = floorf( key.wrapWidth / IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP ) * IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP;
+		key.wrapWidth = IMUI_MAX( key.wrapWidth, IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP );
+	}
+	else
+	{
+		key.wrapWidth = key.hAlign != 0.0f ? IMUI_FLOAT_INF : 0.0f;
+	}
+	key.hAlign = IMUI_MAX( IMUI_MIN( key.hAlign, 1.0f ), 0.0f );
+	if( key.wrapWidth == 0.0f )
+	{
+		key.hAlign = 0.0f;
+	}
+
+	// wrapped layouts reuse glyphs and line breaks of the unwrapped layout
+	ImuiTextLayout* unwrappedLayout = NULL;
+	if( key.wrapWidth > 0.0f )
+	{
+		ImuiTextLayoutParameters unwrappedParameters = key;
+		unwrappedParameters.wrapWidth	= 0.0f;
+		unwrappedParameters.hAlign		= 0.0f;
+
+		unwrappedLayout = imuiTextLayoutCacheCreateLayout( cache, &unwrappedParameters );
+		if( !unwrappedLayout )
+		{
+			return NULL;
+		}
+	}
+
+	const ImuiTextLayoutParameters* keyPointer = &key;
 	bool isNew = false;
-	ImuiTextLayout** mapLayout = (ImuiTextLayout**)imuiHashMapInsertNew( &cache->layoutMap, &parameters, &isNew );
+	ImuiTextLayout** mapLayout = (ImuiTextLayout**)imuiHashMapInsertNew( imuiTextLayoutCacheGetMap( cache, key.isStatic ), &keyPointer, &isNew );
 	if( !mapLayout )
 	{
 		return NULL;
@@ -147,43 +332,45 @@ ImuiTextLayout* imuiTextLayoutCacheCreateLayout( ImuiTextLayoutCache* cache, con
 		ImuiTextLayout* layout = *mapLayout;
 		if( layout->frameIndex != cache->frameIndex )
 		{
-			if( layout->prevLayout )
-			{
-				layout->prevLayout->nextLayout = layout->nextLayout;
-			}
-			else
-			{
-				IMUI_ASSERT( cache->firstUnusedLayout == layout );
-				cache->firstUnusedLayout = layout->nextLayout;
-			}
-
-			if( layout->nextLayout )
-			{
-				layout->nextLayout->prevLayout = layout->prevLayout;
-			}
+			imuiTextLayoutUnlink( cache, layout );
+			imuiTextLayoutPushUsed( cache, layout, mapLayout );
+		}
 
-			layout->nextLayout = cache->firstLayout;
-			layout->prevLayout = NULL;
+		cache->stats.hitCount++;
+		IMUI_STATS_ADD( cache->frameStats, textLayoutReuseCount, 1u );
+		return layout;
+	}
 
-			if( cache->firstLayout )
-			{
-				cache->firstLayout->prevLayout = layout;
-			}
-			cache->firstLayout = layout;
+	cache->stats.missCount++;
+	IMUI_STATS_ADD( cache->frameStats, textLayoutCreateCount, 1u );
 
-			layout->frameIndex = cache->frameIndex;
-		}
+	IMUI_STATS_ZONE_BEGIN( cache->frameStats, "imuiTextLayoutCreate", NULL, 0u );
+	IMUI_STATS_PHASE_BEGIN( cache->frameStats, startTime );
+	ImuiTextLayout* layout;
+	if( unwrappedLayout )
+	{
+		layout = imuiTextLayoutCreateNewWrapped( cache, &key, unwrappedLayout, mapLayout );
+	}
+	else
+	{
+		layout = imuiTextLayoutCreateNew( cache, &key, mapLayout );
+	}
 
-		return *mapLayout;
+	if( layout )
+	{
+		layout->hash = key.isStatic ? ImuiTextLayoutCacheStaticHash( &layout ) : ImuiTextLayoutCacheHash( &layout );
 	}
+	IMUI_STATS_PHASE_END( cache->frameStats, startTime, ImuiFramePhase_TextLayout );
+	IMUI_STATS_ZONE_END( cache->frameStats );
 
-	return imuiTextLayoutCreateNew( cache, parameters, mapLayout );
+	return layout;
 }
 
-size_t imuiTextLayoutCalculateGlyphCount( const char* text, size_t length )
+static uintsize imuiTextLayoutCalculateGlyphCountScalar( const char* text, uintsize length, uintsize* index, uintsize endIndex )
 {
-	size_t glyphCount = 0u;
-	for( uintsize i = 0; i < length; )
+	uintsize glyphCount = 0u;
+	uintsize i = *index;
+	while( i < endIndex )
 	{
 		const char c = text[ i ];
 		if( c == '\n' )
@@ -203,146 +390,559 @@ size_t imuiTextLayoutCalculateGlyphCount( const char* text, size_t length )
 		glyphCount++;
 	}
 
+	*index = IMUI_MIN( i, length );
+	return glyphCount;
+}
+
+#if defined( IMUI_SIMD_SSE2 ) || defined( IMUI_SIMD_NEON )
+static bool imuiTextLayoutCalculateGlyphCountAscii16( const char* text, uintsize* glyphCount )
+{
+#	if defined( IMUI_SIMD_SSE2 )
+	const __m128i chars = _mm_loadu_si128( (const __m128i*)text );
+	if( _mm_movemask_epi8( chars ) != 0 )
+	{
+		return false;
+	}
+
+	const uint32 newLineMask = (uint32)_mm_movemask_epi8( _mm_cmpeq_epi8( chars, _mm_set1_epi8( '\n' ) ) );
+	*glyphCount = 16u - IMUI_POPULATION_COUNT32( newLineMask );
+#	else
+	const uint8x16_t chars = vld1q_u8( (const uint8_t*)text );
+	if( vmaxvq_u8( chars ) >= 0x80u )
+	{
+		return false;
+	}
+
+	const uint8x16_t newLines = vshrq_n_u8( vceqq_u8( chars, vdupq_n_u8( '\n' ) ), 7 );
+	*glyphCount = 16u - vaddvq_u8( newLines );
+#	endif
+
+	return true;
+}
+#endif
+
+size_t imuiTextLayoutCalculateGlyphCount( const char* text, size_t length )
+{
+	size_t glyphCount = 0u;
+	uintsize i = 0u;
+
+#if defined( IMUI_SIMD_SSE2 ) || defined( IMUI_SIMD_NEON )
+	// count 16 bytes at once while text is ASCII
+	while( i + 16u <= length )
+	{
+		uintsize blockGlyphCount;
+		if( imuiTextLayoutCalculateGlyphCountAscii16( text + i, &blockGlyphCount ) )
+		{
+			glyphCount += blockGlyphCount;
+			i += 16u;
+		}
+		else
+		{
+			glyphCount += imuiTextLayoutCalculateGlyphCountScalar( text, length, &i, i + 16u );
+		}
+	}
+#endif
+
+	glyphCount += imuiTextLayoutCalculateGlyphCountScalar( text, length, &i, length );
 	return glyphCount;
 }
 
 ImuiSize imuiTextLayoutCalculateSize( ImuiContext* imui, ImuiFont* font, const char* text, size_t length )
 {
-	ImuiTextLayout* pLayout = imuiTextLayoutCreateLength( imui, font, text, length );
-	if( !pLayout )
+	if( !font )
 	{
 		return imuiSizeCreateZero();
 	}
 
-	return pLayout->size;
+	ImuiTextLayoutParameters parameters;
+	parameters.font			= font;
+	parameters.text.data	= text;
+	parameters.text.length	= length;
+	parameters.wrapWidth	= 0.0f;
+	parameters.hAlign		= 0.0f;
+	parameters.isStatic		= false;
+	parameters.textVersion	= 0u;
+
+	return imuiTextLayoutCacheMesureTextSize( &imui->layoutCache, &parameters );
+}
+
+static const ImuiFontCodepoint* imuiTextLayoutDecodeCodepoint( ImuiFont* font, ImuiStringView text, uintsize* index, uint32* targetCodepoint )
+{
+	uintsize i = *index;
+	const char c = text.data[ i ];
+	if( (uint8)c < 0x80u )
+	{
+		*index = i + 1u;
+
+		const ImuiFontCodepoint* codepointInfo = font->denseCodepoints[ (uint8)c ];
+		*targetCodepoint = codepointInfo ? (uint32)c : 0xfffd;
+		return codepointInfo ? codepointInfo : font->invalidCodepoint;
+	}
+
+	const uint32 codepointByteCount = IMUI_COUNT_LEADING_ZEROS32( ~((uint32)c << 24u) );
+
+	uint32 codepoint;
+	if( codepointByteCount == 1 || codepointByteCount > 4 )
+	{
+		// invalid character
+		codepoint = 0xfffd; // invalid codepoint
+	}
+	else
+	{
+		const uint32 codepointMask = (1u << (8 - codepointByteCount)) - 1u;
+		codepoint = c & codepointMask;
+		for( int remainingBytes = (int)codepointByteCount - 1; remainingBytes > 0; --remainingBytes )
+		{
+			i++;
+			if( i >= text.length )
+			{
+				break;
+			}
+			const char c2 = text.data[ i ];
+
+			codepoint <<= 6u;
+			codepoint += (c2 & 0x3fu);
+		}
+	}
+	*index = i + 1u;
+
+	const ImuiFontCodepoint* codepointInfo = imuiFontFindCodepoint( font, codepoint );
+	if( !codepointInfo )
+	{
+		codepoint = 0xfffd; // invalid codepoint
+		codepointInfo = font->invalidCodepoint;
+	}
+
+	*targetCodepoint = codepoint;
+	return codepointInfo;
+}
+
+static ImuiTextLayout* imuiTextLayoutAlloc( ImuiTextLayoutCache* cache, uintsize memorySize, ImuiTextLayout** mapLayout )
+{
+	ImuiTextLayout* layout = (ImuiTextLayout*)imuiSlabAllocatorAlloc( &cache->slab, memorySize );
+	if( !layout )
+	{
+		imuiHashMapRemove( imuiTextLayoutCacheGetMap( cache, (*mapLayout)->isStatic ), mapLayout );
+		return NULL;
+	}
+
+	layout->memorySize			= memorySize;
+	layout->lineBreaks			= NULL;
+	layout->lineBreakCount		= 0u;
+	layout->lineBreakCapacity	= 0u;
+
+	cache->stats.memorySize += imuiSlabAllocatorGetBlockSize( memorySize );
+	cache->stats.layoutCount++;
+
+	return layout;
+}
+
+static void imuiTextLayoutFree( ImuiTextLayoutCache* cache, ImuiTextLayout* layout )
+{
+	cache->stats.memorySize -= imuiSlabAllocatorGetBlockSize( layout->memorySize ) + (sizeof( ImuiTextLineBreak ) * layout->lineBreakCapacity);
+	cache->stats.layoutCount--;
+
+	IMUI_MEMORY_ARRAY_FREE( cache->allocator, layout->lineBreaks, layout->lineBreakCapacity );
+	imuiSlabAllocatorFree( &cache->slab, layout, layout->memorySize );
+}
+
+static void imuiTextLayoutPushUsed( ImuiTextLayoutCache* cache, ImuiTextLayout* layout, ImuiTextLayout** mapLayout )
+{
+	layout->frameIndex	= cache->frameIndex;
+
+	layout->prevLayout	= NULL;
+	layout->nextLayout	= cache->firstLayout;
+
+	if( cache->firstLayout )
+	{
+		cache->firstLayout->prevLayout = layout;
+	}
+	else
+	{
+		cache->lastLayout = layout;
+	}
+	cache->firstLayout = layout;
+
+	*mapLayout = layout;
+}
+
+static void imuiTextLayoutUnlink( ImuiTextLayoutCache* cache, ImuiTextLayout* layout )
+{
+	if( layout->prevLayout )
+	{
+		layout->prevLayout->nextLayout = layout->nextLayout;
+	}
+	else
+	{
+		IMUI_ASSERT( cache->firstLayout == layout );
+		cache->firstLayout = layout->nextLayout;
+	}
+
+	if( layout->nextLayout )
+	{
+		layout->nextLayout->prevLayout = layout->prevLayout;
+	}
+	else
+	{
+		IMUI_ASSERT( cache->lastLayout == layout );
+		cache->lastLayout = layout->prevLayout;
+	}
 }
 
 static ImuiTextLayout* imuiTextLayoutCreateNew( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters, ImuiTextLayout** mapLayout )
 {
 	uintsize glyphCount = imuiTextLayoutCalculateGlyphCount( parameters->text.data, parameters->text.length );
-	const uintsize memorySize = sizeof( ImuiTextLayout ) + parameters->text.length + 1u + (sizeof( ImuiTextGlyph ) * glyphCount);
-	ImuiTextLayout* layout = (ImuiTextLayout*)imuiMemoryAlloc( cache->allocator, memorySize );
+	const uintsize textSize = parameters->isStatic ? 0u : parameters->text.length + 1u;
+	const uintsize memorySize = sizeof( ImuiTextLayout ) + textSize + (sizeof( ImuiTextGlyph ) * glyphCount);
+	ImuiTextLayout* layout = imuiTextLayoutAlloc( cache, memorySize, mapLayout );
 	if( !layout )
 	{
-		imuiHashMapRemove( &cache->layoutMap, mapLayout );
 		return NULL;
 	}
 
 	ImuiTextGlyph* glyphs = (ImuiTextGlyph*)&layout[ 1u ];
-	char* textData = (char*)&glyphs[ glyphCount ];
-	memcpy( textData, parameters->text.data, parameters->text.length + 1u );
+	const char* textData = parameters->text.data;
+	if( !parameters->isStatic )
+	{
+		char* textCopy = (char*)&glyphs[ glyphCount ];
+		memcpy( textCopy, parameters->text.data, parameters->text.length );
+		textCopy[ parameters->text.length ] = '\0';
+		textData = textCopy;
+	}
 
 	uintsize lineCount = 1u;
 	uintsize glyphIndex = 0u;
 	float x = 0.0f;
 	float y = 0.0f;
-	for( uintsize i = 0; i < parameters->text.length; ++i )
+	float width = 0.0f;
+	for( uintsize i = 0; i < parameters->text.length; )
 	{
-		ImuiTextGlyph* glyph = &glyphs[ glyphIndex ];
-
-		glyph->charIndex = (uint32)i;
-
-		const char c = parameters->text.data[ i ];
-		if( c == '\n' )
+		if( parameters->text.data[ i ] == '\n' )
 		{
+			width = IMUI_MAX( width, x );
 			x = 0.0f;
 			y += parameters->font->fontSize; // parameters->font->lineGap * parameters->font->fontSize
 			y = ceilf( y );
 			lineCount++;
+			i++;
 			continue;
 		}
 
-		const uint32 codepointByteCount = IMUI_COUNT_LEADING_ZEROS32( ~((uint32)c << 24u) );
+		const uint32 charIndex = (uint32)i;
 
 		uint32 codepoint;
-		if( codepointByteCount == 1 || codepointByteCount > 4 )
+		const ImuiFontCodepoint* codepointInfo = imuiTextLayoutDecodeCodepoint( parameters->font, parameters->text, &i, &codepoint );
+		if( !codepointInfo )
 		{
-			// invalid character
-			codepoint = 0xfffd; // invalid codepoint
+			// TODO: what to do here?
+			x += parameters->font->lineGap;
+			glyphCount--;
+			continue;
 		}
-		else
+
+		ImuiTextGlyph* glyph = &glyphs[ glyphIndex ];
+		glyph->charIndex	= charIndex;
+		glyph->codepoint	= codepoint;
+		glyph->pos			= imuiPosCreate( x + codepointInfo->xOffset, y + codepointInfo->ascentOffset );
+		glyph->size			= imuiSizeCreate( (float)codepointInfo->width, (float)codepointInfo->height );
+		glyph->uv			= codepointInfo->uv;
+
+		glyphIndex++;
+		x += codepointInfo->advance;
+	}
+	width = IMUI_MAX( width, x );
+
+	layout->font				= parameters->font;
+	layout->text.data			= textData;
+	layout->text.length			= parameters->text.length;
+	layout->wrapWidth			= 0.0f;
+	layout->hAlign				= 0.0f;
+	layout->isStatic			= parameters->isStatic;
+	layout->textVersion			= parameters->textVersion;
+	layout->glyphs				= glyphs;
+	layout->glyphCount			= glyphCount;
+	layout->size				= imuiSizeCreate( ceilf( width ), lineCount * parameters->font->fontSize );
+
+	imuiTextLayoutPushUsed( cache, layout, mapLayout );
+	return layout;
+}
+
+static ImuiTextLineBreak* imuiTextLayoutPushLineBreak( ImuiTextLayoutCache* cache, ImuiTextLayout* layout, uintsize glyphIndex, float x, float y )
+{
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( cache->allocator, layout->lineBreaks, layout->lineBreakCapacity, layout->lineBreakCount + 1u ) )
+	{
+		return NULL;
+	}
+
+	ImuiTextLineBreak* lineBreak = &layout->lineBreaks[ layout->lineBreakCount++ ];
+	lineBreak->glyphIndex	= (uint32)glyphIndex;
+	lineBreak->glyphCount	= 0u;
+	lineBreak->x			= x;
+	lineBreak->y			= y;
+	lineBreak->width		= 0.0f;
+	lineBreak->advance		= 0.0f;
+	lineBreak->isLineEnd	= false;
+
+	return lineBreak;
+}
+
+static bool imuiTextLayoutCalculateLineBreaks( ImuiTextLayoutCache* cache, ImuiTextLayout* layout )
+{
+	// split text into words with trailing white spaces. words are never broken.
+	ImuiTextLineBreak* lineBreak = NULL;
+	bool hasWhiteSpace = false;
+	uintsize glyphIndex = 0u;
+	float x = 0.0f;
+	float y = 0.0f;
+	for( uintsize i = 0; i < layout->text.length; )
+	{
+		if( layout->text.data[ i ] == '\n' )
 		{
-			const uint32 codepointMask = (1u << (8 - codepointByteCount)) - 1u;
-			codepoint = c & codepointMask;
-			for( int remainingBytes = (int)codepointByteCount - 1; remainingBytes > 0; --remainingBytes )
+			if( !lineBreak )
 			{
-				i++;
-				if( i >= parameters->text.length )
+				lineBreak = imuiTextLayoutPushLineBreak( cache, layout, glyphIndex, x, y );
+				if( !lineBreak )
 				{
-					break;
+					return false;
 				}
-				const char c2 = parameters->text.data[ i ];
-
-				codepoint <<= 6u;
-				codepoint += (c2 & 0x3fu);
 			}
+			lineBreak->isLineEnd = true;
+			lineBreak = NULL;
+
+			x = 0.0f;
+			y += layout->font->fontSize;
+			y = ceilf( y );
+			i++;
+			continue;
 		}
 
-		uint32* mapCodepointKey = &codepoint;
-		ImuiFontCodepoint** mapCodepoint = (ImuiFontCodepoint**)imuiHashMapFind( &parameters->font->codepointMap, &mapCodepointKey );
-		if( !mapCodepoint )
+		uint32 codepoint;
+		const ImuiFontCodepoint* codepointInfo = imuiTextLayoutDecodeCodepoint( layout->font, layout->text, &i, &codepoint );
+		if( !codepointInfo )
 		{
-			codepoint = 0xfffd; // invalid codepoint
-			mapCodepoint = (ImuiFontCodepoint**)imuiHashMapFind( &parameters->font->codepointMap, &mapCodepointKey );
-			if( !mapCodepoint )
-			{
+			x += layout->font->lineGap;
+			continue;
+		}
 
+		const bool isWhiteSpace = codepoint == ' ' || codepoint == '\t';
+		if( !lineBreak || (hasWhiteSpace && !isWhiteSpace) )
+		{
+			lineBreak = imuiTextLayoutPushLineBreak( cache, layout, glyphIndex, x, y );
+			if( !lineBreak )
+			{
+				return false;
 			}
+			hasWhiteSpace = false;
 		}
 
-		ImuiFontCodepoint* codepointInfo;
-		if( mapCodepoint )
+		glyphIndex++;
+		x += codepointInfo->advance;
+
+		lineBreak->glyphCount++;
+		lineBreak->advance = x - lineBreak->x;
+		if( isWhiteSpace )
 		{
-			codepointInfo = *mapCodepoint;
+			hasWhiteSpace = true;
 		}
 		else
 		{
-			// TODO: what to do here?
-			x += parameters->font->lineGap;
-			glyphCount--;
-			continue;
+			lineBreak->width = lineBreak->advance;
 		}
+	}
 
-		glyph->codepoint	= codepoint;
-		glyph->pos			= imuiPosCreate( x + codepointInfo->xOffset, y + codepointInfo->ascentOffset );
-		glyph->size			= imuiSizeCreate( (float)codepointInfo->width, (float)codepointInfo->height );
-		glyph->uv			= codepointInfo->uv;
+	IMUI_ASSERT( glyphIndex == layout->glyphCount );
+	return true;
+}
 
-		glyphIndex++;
-		x += codepointInfo->advance;
-		//height = IMUI_MAX( height, glyph->pos.y + glyph->size.height );
+static bool imuiTextLayoutPrepareLineBreaks( ImuiTextLayoutCache* cache, ImuiTextLayout* layout )
+{
+	if( layout->lineBreaks )
+	{
+		return true;
 	}
 
-	layout->font		= parameters->font;
-	layout->text.data	= textData;
-	layout->text.length	= parameters->text.length;
-	layout->glyphs		= glyphs;
-	layout->glyphCount	= glyphCount;
-	layout->size		= imuiSizeCreate( ceilf( x ), lineCount * parameters->font->fontSize );
-	layout->frameIndex	= cache->frameIndex;
+	if( !imuiTextLayoutCalculateLineBreaks( cache, layout ) )
+	{
+		IMUI_MEMORY_ARRAY_FREE( cache->allocator, layout->lineBreaks, layout->lineBreakCapacity );
+		layout->lineBreakCount = 0u;
+		return false;
+	}
 
-	layout->prevLayout	= NULL;
-	layout->nextLayout	= cache->firstLayout;
+	cache->stats.memorySize += sizeof( ImuiTextLineBreak ) * layout->lineBreakCapacity;
+	return true;
+}
 
-	if( cache->firstLayout )
+static uintsize imuiTextLayoutFindLineEnd( const ImuiTextLayout* unwrappedLayout, float wrapWidth, uintsize firstBreakIndex, float* lineWidth )
+{
+	float x = 0.0f;
+	float width = 0.0f;
+	uintsize breakIndex = firstBreakIndex;
+	while( breakIndex < unwrappedLayout->lineBreakCount )
 	{
-		cache->firstLayout->prevLayout = layout;
+		const ImuiTextLineBreak* lineBreak = &unwrappedLayout->lineBreaks[ breakIndex ];
+		if( breakIndex > firstBreakIndex && x + lineBreak->width > wrapWidth )
+		{
+			break;
+		}
+
+		width = x + lineBreak->width;
+		x += lineBreak->advance;
+		breakIndex++;
+
+		if( lineBreak->isLineEnd )
+		{
+			break;
+		}
 	}
-	cache->firstLayout = layout;
 
-	*mapLayout = layout;
+	*lineWidth = width;
+	return breakIndex;
+}
+
+static ImuiTextLayout* imuiTextLayoutCreateNewWrapped( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters, ImuiTextLayout* unwrappedLayout, ImuiTextLayout** mapLayout )
+{
+	if( !imuiTextLayoutPrepareLineBreaks( cache, unwrappedLayout ) )
+	{
+		imuiHashMapRemove( imuiTextLayoutCacheGetMap( cache, parameters->isStatic ), mapLayout );
+		return NULL;
+	}
+
+	const uintsize glyphCount = unwrappedLayout->glyphCount;
+	const uintsize textSize = parameters->isStatic ? 0u : parameters->text.length + 1u;
+	const uintsize memorySize = sizeof( ImuiTextLayout ) + textSize + (sizeof( ImuiTextGlyph ) * glyphCount);
+	ImuiTextLayout* layout = imuiTextLayoutAlloc( cache, memorySize, mapLayout );
+	if( !layout )
+	{
+		return NULL;
+	}
+
+	ImuiTextGlyph* glyphs = (ImuiTextGlyph*)&layout[ 1u ];
+	const char* textData = parameters->text.data;
+	if( !parameters->isStatic )
+	{
+		char* textCopy = (char*)&glyphs[ glyphCount ];
+		memcpy( textCopy, unwrappedLayout->text.data, parameters->text.length + 1u );
+		textData = textCopy;
+	}
+
+	float width = 0.0f;
+	for( uintsize breakIndex = 0u; breakIndex < unwrappedLayout->lineBreakCount; )
+	{
+		float lineWidth;
+		breakIndex = imuiTextLayoutFindLineEnd( unwrappedLayout, parameters->wrapWidth, breakIndex, &lineWidth );
+		width = IMUI_MAX( width, lineWidth );
+	}
+
+	uintsize lineCount = 0u;
+	float y = 0.0f;
+	for( uintsize breakIndex = 0u; breakIndex < unwrappedLayout->lineBreakCount; )
+	{
+		float lineWidth;
+		const uintsize lineEndIndex = imuiTextLayoutFindLineEnd( unwrappedLayout, parameters->wrapWidth, breakIndex, &lineWidth );
+
+		float x = floorf( (width - lineWidth) * parameters->hAlign );
+		for( ; breakIndex < lineEndIndex; ++breakIndex )
+		{
+			const ImuiTextLineBreak* lineBreak = &unwrappedLayout->lineBreaks[ breakIndex ];
+			for( uintsize i = lineBreak->glyphIndex; i < lineBreak->glyphIndex + lineBreak->glyphCount; ++i )
+			{
+				ImuiTextGlyph* glyph = &glyphs[ i ];
+				*glyph = unwrappedLayout->glyphs[ i ];
+				glyph->pos.x += x - lineBreak->x;
+				glyph->pos.y += y - lineBreak->y;
+			}
+
+			x += lineBreak->advance;
+		}
+
+		y += parameters->font->fontSize;
+		y = ceilf( y );
+		lineCount++;
+	}
+
+	// a trailing '\n' starts an empty line
+	if( unwrappedLayout->lineBreakCount > 0u && unwrappedLayout->lineBreaks[ unwrappedLayout->lineBreakCount - 1u ].isLineEnd )
+	{
+		lineCount++;
+	}
+
+	layout->font				= parameters->font;
+	layout->text.data			= textData;
+	layout->text.length			= parameters->text.length;
+	layout->wrapWidth			= parameters->wrapWidth;
+	layout->hAlign				= parameters->hAlign;
+	layout->isStatic			= parameters->isStatic;
+	layout->textVersion			= parameters->textVersion;
+	layout->glyphs				= glyphs;
+	layout->glyphCount			= glyphCount;
+	layout->size				= imuiSizeCreate( ceilf( width ), IMUI_MAX( lineCount, 1u ) * parameters->font->fontSize );
+
+	imuiTextLayoutPushUsed( cache, layout, mapLayout );
 	return layout;
 }
 
+static ImuiSize imuiTextLayoutMeasure( ImuiFont* font, ImuiStringView text )
+{
+	uintsize lineCount = 1u;
+	float x = 0.0f;
+	float width = 0.0f;
+	for( uintsize i = 0; i < text.length; )
+	{
+		if( text.data[ i ] == '\n' )
+		{
+			width = IMUI_MAX( width, x );
+			x = 0.0f;
+			lineCount++;
+			i++;
+			continue;
+		}
+
+		uint32 codepoint;
+		const ImuiFontCodepoint* codepointInfo = imuiTextLayoutDecodeCodepoint( font, text, &i, &codepoint );
+		x += codepointInfo ? codepointInfo->advance : font->lineGap;
+	}
+	width = IMUI_MAX( width, x );
+
+	return imuiSizeCreate( ceilf( width ), lineCount * font->fontSize );
+}
+
 ImuiSize imuiTextLayoutCacheMesureTextSize( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters )
 {
-	ImuiTextLayout* layout = imuiTextLayoutCacheCreateLayout( cache, parameters );
-	if( !layout )
+	if( parameters->text.length == 0u )
 	{
-		return imuiSizeCreateZero();
+		return imuiSizeCreateZero();	// same as the size of a layout for empty text
+	}
+	else if( parameters->wrapWidth > 0.0f )
+	{
+		// wrapping needs line breaks of a full layout
+		ImuiTextLayout* layout = imuiTextLayoutCacheCreateLayout( cache, parameters );
+		return imuiTextLayoutGetSize( layout );
+	}
+	else if( parameters->text.length > IMUI_DEFAULT_TEXT_SIZE_CACHE_TEXT_LENGTH )
+	{
+		// measuring is linear like hashing and comparing, so long text is not worth a copy
+		return imuiTextLayoutMeasure( parameters->font, parameters->text );
 	}
 
-	return imuiTextLayoutGetSize( layout );
+	const ImuiHash fontHash = imuiHashCreate( &parameters->font, sizeof( parameters->font ) );
+	const ImuiHash hash = imuiHashStringSeed( parameters->text, fontHash );
+
+	ImuiTextSizeCacheEntry* entry = &cache->sizeCache[ hash & (IMUI_DEFAULT_TEXT_SIZE_CACHE_SIZE - 1u) ];
+	if( entry->font == parameters->font &&
+		entry->hash == hash &&
+		entry->length == (uint32)parameters->text.length &&
+		memcmp( entry->text, parameters->text.data, parameters->text.length ) == 0 )
+	{
+		return entry->size;
+	}
+
+	entry->font		= parameters->font;
+	entry->hash		= hash;
+	entry->length	= (uint32)parameters->text.length;
+	entry->size		= imuiTextLayoutMeasure( parameters->font, parameters->text );
+	memcpy( entry->text, parameters->text.data, parameters->text.length );
+
+	return entry->size;
 }
 
 size_t imuiTextLayoutGetGlyphCount( const ImuiTextLayout* layout )
@@ -3,17 +3,36 @@
 #include <imui/imui.h>
 
 #include "imui_helpers.h"
+#include "imui_stats.h"
+
+typedef struct ImuiTextSizeCacheEntry
+{
+	const ImuiFont*				font;
+	ImuiHash					hash;
+	uint32						length;
+	ImuiSize					size;
+	char						text[ IMUI_DEFAULT_TEXT_SIZE_CACHE_TEXT_LENGTH ];	// compared on hash hits
+} ImuiTextSizeCacheEntry;
 
 typedef struct ImuiTextLayoutCache
 {
-	ImuiAllocator*			allocator;
+	ImuiAllocator*				allocator;
+	ImuiStats*					frameStats;
+	ImuiSlabAllocator			slab;
 
-	ImuiHashMap				layoutMap;
+	ImuiHashMap					layoutMap;
+	ImuiHashMap					staticLayoutMap;	// layouts of stable text by pointer and version
 
-	ImuiTextLayout*			firstLayout;
-	ImuiTextLayout*			firstUnusedLayout;
+	ImuiTextLayout*				firstLayout;		// most recently used
+	ImuiTextLayout*				lastLayout;			// least recently used
 
-	uint32					frameIndex;
+	uintsize					memoryBudget;
+	uint32						maxAge;
+	uint32						frameIndex;
+
+	ImuiTextLayoutCacheStats	stats;
+
+	ImuiTextSizeCacheEntry		sizeCache[ IMUI_DEFAULT_TEXT_SIZE_CACHE_SIZE ];	// direct mapped by hash
 } ImuiTextLayoutCache;
 
 typedef struct ImuiTextGlyph
@@ -25,16 +44,38 @@ typedef struct ImuiTextGlyph
 	ImuiTexCoord			uv;
 } ImuiTextGlyph;
 
+typedef struct ImuiTextLineBreak
+{
+	uint32					glyphIndex;		// first glyph of the word
+	uint32					glyphCount;		// including trailing white spaces
+	float					x;				// word position in the unwrapped layout
+	float					y;
+	float					width;			// without trailing white spaces
+	float					advance;		// with trailing white spaces
+	bool					isLineEnd;		// word is followed by '\n'
+} ImuiTextLineBreak;
+
 typedef struct ImuiTextLayoutParameters
 {
 	ImuiFont*				font;
 	ImuiStringView			text;
+	float					wrapWidth;		// 0 to disable wrapping
+	float					hAlign;			// line alignment from 0(left) to 1(right)
+	bool					isStatic;		// text is referenced instead of copied and identified by pointer and version
+	uint64					textVersion;
 } ImuiTextLayoutParameters;
 
 struct ImuiTextLayout
 {
+	// same order as ImuiTextLayoutParameters to use them as hash map key
 	ImuiFont*				font;
 	ImuiStringView			text;
+	float					wrapWidth;
+	float					hAlign;
+	bool					isStatic;
+	uint64					textVersion;
+
+	ImuiHash				hash;			// of the key, identifies the content without reading the text again
 
 	ImuiTextLayout*			prevLayout;
 	ImuiTextLayout*			nextLayout;
@@ -42,15 +83,21 @@ struct ImuiTextLayout
 	const ImuiTextGlyph*	glyphs;
 	uintsize				glyphCount;
 
+	ImuiTextLineBreak*		lineBreaks;		// only unwrapped layouts, created on first wrap
+	uintsize				lineBreakCount;
+	uintsize				lineBreakCapacity;
+
+	uintsize				memorySize;
 	uint32					frameIndex;
 
 	ImuiSize				size;
 };
 
-bool						imuiTextLayoutCacheConstruct( ImuiTextLayoutCache* cache, ImuiAllocator* allocator );
+bool						imuiTextLayoutCacheConstruct( ImuiTextLayoutCache* cache, ImuiAllocator* allocator, ImuiStats* frameStats, uintsize memoryBudget, uint32 maxAge );
 void						imuiTextLayoutCacheDestruct( ImuiTextLayoutCache* cache );
 
 void						imuiTextLayoutCacheEndFrame( ImuiTextLayoutCache* cachce );
+void						imuiTextLayoutCacheRemoveFont( ImuiTextLayoutCache* cache, const ImuiFont* font );
 
 ImuiTextLayout*				imuiTextLayoutCacheCreateLayout( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters );
 ImuiSize					imuiTextLayoutCacheMesureTextSize( ImuiTextLayoutCache* cache, const ImuiTextLayoutParameters* parameters );
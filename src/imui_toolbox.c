@@ -11,6 +11,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #if defined( _MSC_VER )
@@ -22,7 +23,28 @@
 #	define static_assert(x, m) _Static_assert(x, m)
 #endif
 
+typedef struct ImuiToolboxThemeOverride
+{
+	uint16			offset;		// byte offset of the overridden field in s_theme
+	uint16			size;
+	union
+	{
+		ImuiColor	color;
+		ImuiSkin	skin;
+		ImuiImage	image;
+		ImuiBorder	border;
+		float		value;
+	} oldValue;
+} ImuiToolboxThemeOverride;
+
+static_assert( sizeof( ImuiToolboxTheme ) <= 0xffffu, "ImuiToolboxThemeOverride offset is too small" );
+
 static ImuiToolboxTheme s_theme;
+static ImuiToolboxThemeOverride s_themeOverrides[ IMUI_DEFAULT_THEME_OVERRIDE_STACK_SIZE ];
+static uintsize s_themeOverrideCount;
+static uintsize s_themeOverrideOverflowCount;
+static bool s_skinDescriptorsValid[ ImuiToolboxSkin_MAX ];		// reset by imuiToolboxThemeSet and by overrides of the skin
+static ImuiSkinDescriptor s_skinDescriptors[ ImuiToolboxSkin_MAX ];
 
 struct ImuiToolboxScrollAreaState
 {
@@ -37,12 +59,70 @@ struct ImuiToolboxTextBuffer
 	ImuiAllocator*	allocator;
 
 	char*			data;
+	uintsize		dataOffset;		// start of the oldest line in ring mode
 	uintsize		dataLength;
 	uintsize		dataCapacity;
 
 	uintsize*		lines;
+	uintsize		linesOffset;	// oldest line in ring mode
 	uintsize		linesLength;
 	uintsize		linesCapacity;
+
+	uintsize		maxDataLength;	// ring mode limits, 0 for no limit
+	uintsize		maxLinesLength;
+	uint64			evictedLineCount;
+};
+
+typedef struct ImuiToolboxTextDocumentEdit
+{
+	uintsize		offset;
+	uintsize		length;
+	uintsize		dataOffset;		// in editData
+	bool			isInsert;
+} ImuiToolboxTextDocumentEdit;
+
+struct ImuiToolboxTextDocument
+{
+	ImuiAllocator*					allocator;
+
+	char*							data;			// gap buffer
+	uintsize						dataCapacity;
+	uintsize						gapStart;
+	uintsize						gapEnd;
+
+	uintsize*						lines;			// gap buffer of line starts. lines after the gap store the distance to the end of the text
+	uintsize						linesCapacity;
+	uintsize						linesGapStart;
+	uintsize						linesGapEnd;
+
+	ImuiToolboxTextDocumentEdit*	edits;
+	uintsize						editsLength;	// undo position, redo edits follow
+	uintsize						editsCount;
+	uintsize						editsCapacity;
+	char*							editData;
+	uintsize						editDataLength;
+	uintsize						editDataCapacity;
+	bool							editCanMerge;
+
+	uint64							version;
+};
+
+typedef struct ImuiToolboxTextEditorState
+{
+	bool			hasFocus;
+
+	uintsize		cursorOffset;
+	uintsize		selectionOffset;	// other end of the selection, equal to cursor when nothing is selected
+	uintsize		cursorColumn;		// glyph column kept while moving up and down
+} ImuiToolboxTextEditorState;
+
+struct ImuiToolboxTextViewState
+{
+	ImuiToolboxTextBuffer			textBuffer;		// line index of caller owned text, data is not copied
+	uint64							textVersion;
+
+	const ImuiToolboxTextBuffer*	lastTextBuffer;
+	uint64							evictedLineCount;
 };
 
 typedef struct ImuiToolboxTextEditState
@@ -66,11 +146,142 @@ struct ImuiToolboxListState
 	uintsize		selectedIndex;
 };
 
+typedef struct ImuiToolboxDropDownSearchItem
+{
+	const char*		text;
+	uintsize		index;
+} ImuiToolboxDropDownSearchItem;
+
+typedef struct ImuiToolboxFilterListLevel
+{
+	uintsize		offset;		// into matches, -1 for all items
+	uintsize		count;
+} ImuiToolboxFilterListLevel;
+
+struct ImuiToolboxFilterListState
+{
+	ImuiAllocator*	allocator;
+
+	const void*		items;
+	uintsize		itemCount;
+	uintsize		itemStride;
+	uint64			itemsVersion;
+
+	// level n holds the matches for the first n filter characters
+	char*			filter;
+	uintsize		filterCapacity;
+	ImuiToolboxFilterListLevel*	levels;
+	uintsize		levelCount;
+	uintsize		levelCapacity;
+	uintsize*		matches;
+	uintsize		matchesLength;
+	uintsize		matchesCapacity;
+
+	uintsize		selectedIndex;
+};
+
+typedef struct ImuiToolboxTreeViewRow
+{
+	uint64			nodeId;
+	uintsize		childCount;
+	uint32			depth;
+	bool			isExpanded;
+} ImuiToolboxTreeViewRow;
+
+typedef struct ImuiToolboxTreeViewStackEntry
+{
+	uint64			nodeId;
+	uintsize		childIndex;
+	uintsize		childCount;
+	uint32			depth;
+} ImuiToolboxTreeViewStackEntry;
+
+typedef struct ImuiToolboxTreeViewRowMapEntry
+{
+	uint64			nodeId;
+	uintsize		rowNumber;	// row index + 1 at the time of rowShifts[ shiftIndex ], 0 for empty slots
+	uintsize		shiftIndex;
+} ImuiToolboxTreeViewRowMapEntry;
+
+typedef struct ImuiToolboxTreeViewRowShift
+{
+	uintsize		rowIndex;	// first moved row
+	sintsize		offset;
+} ImuiToolboxTreeViewRowShift;
+
+typedef struct ImuiToolboxTreeViewToggle
+{
+	uint64			nodeId;
+	uintsize		rowIndex;	// hint, -1 when unknown
+	bool			expanded;
+} ImuiToolboxTreeViewToggle;
+
+struct ImuiToolboxTreeViewState
+{
+	ImuiAllocator*					allocator;
+
+	const void*						userData;
+	uint64							rootId;
+	uint64							version;
+	bool							hasRows;
+
+	// flattened visible nodes in display order
+	ImuiToolboxTreeViewRow*			rows;
+	uintsize						rowCount;
+	uintsize						rowCapacity;
+
+	// open addressing node id to row index, built on the first lookup. expand and collapse are recorded
+	// as shifts and applied to old entries on lookup until the map gets rebuilt
+	bool							hasRowMap;
+	ImuiToolboxTreeViewRowMapEntry*	rowMap;
+	uintsize						rowMapCount;
+	uintsize						rowMapCapacity;
+	ImuiToolboxTreeViewRowShift		rowShifts[ IMUI_DEFAULT_TREE_VIEW_ROW_SHIFTS ];
+	uintsize						rowShiftCount;
+
+	// sorted
+	uint64*							expandedIds;
+	uintsize						expandedCount;
+	uintsize						expandedCapacity;
+
+	ImuiToolboxTreeViewRow*			insertRows;
+	uintsize						insertRowCapacity;
+	ImuiToolboxTreeViewStackEntry*	stack;
+	uintsize						stackCapacity;
+
+	ImuiToolboxTreeViewToggle*		toggles;
+	uintsize						toggleCount;
+	uintsize						toggleCapacity;
+
+	bool							hasSelection;
+	uint64							selectedNodeId;
+	uintsize						selectedRow;
+};
+
 struct ImuiToolboxDropDownState
 {
 	bool			isOpen;
 
 	uintsize		selectedIndex;
+
+	ImuiAllocator*	allocator;
+
+	// widest item is only measured again when this key changes
+	const void*		items;
+	uintsize		itemCount;
+	uintsize		itemStride;
+	uint64			itemsVersion;
+	ImuiFont*		font;
+	ImuiSize		maxSize;
+
+	// items sorted case insensitive for type-ahead, built on first key press
+	ImuiToolboxDropDownSearchItem*	searchItems;
+	uintsize		searchItemsCapacity;
+	bool			hasSearchItems;
+
+	char			search[ 32u ];
+	uintsize		searchLength;
+	double			searchTime;
 };
 
 struct ImuiToolboxTabViewState
@@ -79,6 +290,9 @@ struct ImuiToolboxTabViewState
 };
 
 static void imuiToolboxListItemEndInternal( ImuiToolboxListContext* list );
+static void imuiToolboxListBeginInternal( ImuiToolboxListContext* list, ImuiWindow* window, float itemSize, bool selection );
+static void imuiToolboxListSetItemCountInternal( ImuiToolboxListContext* list, size_t itemCount );
+static void imuiToolboxListUpdateInputInternal( ImuiToolboxListContext* list );
 
 static const ImuiToolboxThemeReflectionField s_themeReflectionFields[] =
 {
@@ -172,6 +386,7 @@ static const ImuiToolboxThemeReflectionField s_themeReflectionFields[] =
 
 	{ "Progress Bar/Height",				ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, progressBar.height ) },
 	{ "Progress Bar/Padding",				ImuiToolboxThemeReflectionType_Border,	offsetof( ImuiToolboxTheme, progressBar.padding ) },
+	{ "Progress Bar/Animation Interval",	ImuiToolboxThemeReflectionType_Double,	offsetof( ImuiToolboxTheme, progressBar.animationInterval ) },
 
 	{ "Scroll Area/Bar Size",				ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, scrollArea.barSize ) },
 	{ "Scroll Area/Bar Spacing",			ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, scrollArea.barSpacing ) },
@@ -187,6 +402,7 @@ static const ImuiToolboxThemeReflectionField s_themeReflectionFields[] =
 	{ "Drop Down/Item/Padding",				ImuiToolboxThemeReflectionType_Border,	offsetof( ImuiToolboxTheme, dropDown.itemPadding ) },
 	{ "Drop Down/Item/Size",				ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, dropDown.itemSize ) },
 	{ "Drop Down/Item/Spacing",				ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, dropDown.itemSpacing ) },
+	{ "Drop Down/Search Time",				ImuiToolboxThemeReflectionType_Double,	offsetof( ImuiToolboxTheme, dropDown.searchTime ) },
 
 	{ "Popup/Z Order",						ImuiToolboxThemeReflectionType_UInt32,	offsetof( ImuiToolboxTheme, popup.zOrder ) },
 	{ "Popup/Padding",						ImuiToolboxThemeReflectionType_Border,	offsetof( ImuiToolboxTheme, popup.padding ) },
@@ -197,11 +413,14 @@ static const ImuiToolboxThemeReflectionField s_themeReflectionFields[] =
 	{ "Tab View/Header Cut Extend Right",	ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, tabView.headerCutRight ) },
 	{ "Tab View/Header Padding",			ImuiToolboxThemeReflectionType_Border,	offsetof( ImuiToolboxTheme, tabView.headerPadding ) },
 	{ "Tab View/Body Padding",				ImuiToolboxThemeReflectionType_Border,	offsetof( ImuiToolboxTheme, tabView.bodyPadding ) },
+
+	{ "Tree View/Indent",					ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, treeView.indent ) },
+	{ "Tree View/Expander Spacing",			ImuiToolboxThemeReflectionType_Float,	offsetof( ImuiToolboxTheme, treeView.expanderSpacing ) },
 };
 static_assert( ImuiToolboxColor_MAX == 42, "more colors" );
 static_assert( ImuiToolboxSkin_MAX == 22, "more skins" );
 static_assert( ImuiToolboxIcon_MAX == 4, "more icons" );
-static_assert( sizeof( ImuiToolboxTheme ) == 1640u, "theme changed" );
+static_assert( sizeof( ImuiToolboxTheme ) == 1672u, "theme changed" );
 
 ImuiToolboxThemeReflection imuiToolboxThemeReflectionGet()
 {
@@ -322,6 +541,7 @@ void imuiToolboxThemeFillDefault( ImuiToolboxTheme* theme, ImuiFont* font )
 
 	theme->progressBar.height		= 25.0f;
 	theme->progressBar.padding		= imuiBorderCreateAll( 2.0f );
+	theme->progressBar.animationInterval = 1.0 / 30.0;
 
 	theme->scrollArea.barSize		= 8.0f;
 	theme->scrollArea.barSpacing	= 8.0f;
@@ -337,6 +557,7 @@ void imuiToolboxThemeFillDefault( ImuiToolboxTheme* theme, ImuiFont* font )
 	theme->dropDown.itemPadding		= imuiBorderCreate( 0.0f, 4.0f, 0.0f, 0.0f );
 	theme->dropDown.itemSize		= 25.0f;
 	theme->dropDown.itemSpacing		= 8.0f;
+	theme->dropDown.searchTime		= 1.0;
 
 	theme->popup.zOrder				= 10u;
 	theme->popup.padding			= imuiBorderCreateAll( 8.0f );
@@ -347,11 +568,126 @@ void imuiToolboxThemeFillDefault( ImuiToolboxTheme* theme, ImuiFont* font )
 	theme->tabView.headerCutRight	= 0.0f;
 	theme->tabView.headerPadding	= imuiBorderCreateAll( 8.0f );
 	theme->tabView.bodyPadding		= imuiBorderCreateAll( 8.0f );
+
+	theme->treeView.indent			= 16.0f;
+	theme->treeView.expanderSpacing	= 4.0f;
 }
 
 void imuiToolboxThemeSet( const ImuiToolboxTheme* theme )
 {
-	s_theme = *theme;
+	IMUI_ASSERT( s_themeOverrideCount == 0u && "Theme must not be replaced while overrides are pushed" );
+	if( theme != &s_theme )
+	{
+		s_theme = *theme;
+	}
+
+	memset( s_skinDescriptorsValid, 0, sizeof( s_skinDescriptorsValid ) );
+}
+
+static void imuiToolboxThemeInvalidateSkins( uintsize offset, uintsize size )
+{
+	// only skins overlapping the changed bytes, e.g. a single skin or the border of one
+	const uintsize skinsOffset	= offsetof( ImuiToolboxTheme, skins );
+	const uintsize skinsEnd		= skinsOffset + sizeof( s_theme.skins );
+	if( offset + size <= skinsOffset || offset >= skinsEnd )
+	{
+		return;
+	}
+
+	const uintsize firstSkin	= (IMUI_MAX( offset, skinsOffset ) - skinsOffset) / sizeof( ImuiSkin );
+	const uintsize lastSkin		= (IMUI_MIN( offset + size, skinsEnd ) - skinsOffset - 1u) / sizeof( ImuiSkin );
+	for( uintsize i = firstSkin; i <= lastSkin; ++i )
+	{
+		s_skinDescriptorsValid[ i ] = false;
+	}
+}
+
+static void imuiToolboxThemePushInternal( void* themeValue, const void* value, uintsize size )
+{
+	const uint8* themeData = (const uint8*)&s_theme;
+	IMUI_ASSERT( (const uint8*)themeValue >= themeData && (const uint8*)themeValue + size <= themeData + sizeof( s_theme ) );
+
+	if( s_themeOverrideCount == IMUI_ARRAY_COUNT( s_themeOverrides ) )
+	{
+		IMUI_ASSERT( false && "Theme override stack overflow" );
+		s_themeOverrideOverflowCount++;
+		return;
+	}
+
+	ImuiToolboxThemeOverride* themeOverride = &s_themeOverrides[ s_themeOverrideCount++ ];
+	themeOverride->offset	= (uint16)((const uint8*)themeValue - themeData);
+	themeOverride->size		= (uint16)size;
+	memcpy( &themeOverride->oldValue, themeValue, size );
+	memcpy( themeValue, value, size );
+
+	imuiToolboxThemeInvalidateSkins( themeOverride->offset, themeOverride->size );
+}
+
+void imuiToolboxThemePushColor( ImuiToolboxColor color, ImuiColor value )
+{
+	imuiToolboxThemePushInternal( &s_theme.colors[ color ], &value, sizeof( value ) );
+}
+
+void imuiToolboxThemePushSkin( ImuiToolboxSkin skin, const ImuiSkin* value )
+{
+	imuiToolboxThemePushInternal( &s_theme.skins[ skin ], value, sizeof( *value ) );
+}
+
+void imuiToolboxThemePushIcon( ImuiToolboxIcon icon, const ImuiImage* value )
+{
+	imuiToolboxThemePushInternal( &s_theme.icons[ icon ], value, sizeof( *value ) );
+}
+
+void imuiToolboxThemePushFloat( float* themeValue, float value )
+{
+	imuiToolboxThemePushInternal( themeValue, &value, sizeof( value ) );
+}
+
+void imuiToolboxThemePushBorder( ImuiBorder* themeValue, ImuiBorder value )
+{
+	imuiToolboxThemePushInternal( themeValue, &value, sizeof( value ) );
+}
+
+void imuiToolboxThemePop( size_t count )
+{
+	for( ; count > 0u && s_themeOverrideOverflowCount > 0u; --count )
+	{
+		s_themeOverrideOverflowCount--;
+	}
+
+	IMUI_ASSERT( count <= s_themeOverrideCount );
+	count = IMUI_MIN( count, s_themeOverrideCount );
+
+	for( ; count > 0u; --count )
+	{
+		const ImuiToolboxThemeOverride* themeOverride = &s_themeOverrides[ --s_themeOverrideCount ];
+		memcpy( (uint8*)&s_theme + themeOverride->offset, &themeOverride->oldValue, themeOverride->size );
+
+		imuiToolboxThemeInvalidateSkins( themeOverride->offset, themeOverride->size );
+	}
+}
+
+static char imuiToolboxToLower( char c )		// ascii only
+{
+	return c >= 'A' && c <= 'Z' ? (char)(c + ('a' - 'A')) : c;
+}
+
+static double imuiToolboxGetBlinkUpdateTime( double time )
+{
+	// the cursor only changes when the blink phase flips
+	const double blinkTime = s_theme.textEdit.blinkTime;
+	return time + (blinkTime - fmod( time, blinkTime ));
+}
+
+static const ImuiSkinDescriptor* imuiToolboxGetSkinDescriptor( ImuiToolboxSkin skin )
+{
+	if( !s_skinDescriptorsValid[ skin ] )
+	{
+		s_skinDescriptors[ skin ]		= imuiSkinDescriptorCreate( &s_theme.skins[ skin ] );
+		s_skinDescriptorsValid[ skin ]	= true;
+	}
+
+	return &s_skinDescriptors[ skin ];
 }
 
 void imuiToolboxSpacer( ImuiWindow* window, float width, float height )
@@ -379,19 +715,19 @@ ImuiWidget* imuiToolboxButtonBegin( ImuiWindow* window )
 	imuiWidgetGetInputState( button, &inputState );
 
 	ImuiColor color = s_theme.colors[ ImuiToolboxColor_Button ];
-	const ImuiSkin* skin = &s_theme.skins[ ImuiToolboxSkin_Button ];
+	const ImuiSkinDescriptor* skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_Button );
 	if( inputState.wasPressed && inputState.isMouseDown )
 	{
 		color = s_theme.colors[ ImuiToolboxColor_ButtonClicked ];
-		skin = &s_theme.skins[ ImuiToolboxSkin_ButtonClicked ];
+		skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ButtonClicked );
 	}
 	else if( inputState.isMouseOver || inputState.hasFocus )
 	{
 		color = s_theme.colors[ ImuiToolboxColor_ButtonHover ];
-		skin = &s_theme.skins[ ImuiToolboxSkin_ButtonHover ];
+		skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ButtonHover );
 	}
 
-	imuiWidgetDrawSkin( button, skin, color );
+	imuiWidgetDrawSkinDescriptor( button, skin, color );
 
 	return button;
 }
@@ -407,12 +743,17 @@ bool imuiToolboxButtonEnd( ImuiWidget* button )
 }
 
 ImuiWidget* imuiToolboxButtonLabelBegin( ImuiWindow* window, const char* text )
+{
+	return imuiToolboxButtonLabelBeginLength( window, text, strlen( text ) );
+}
+
+ImuiWidget* imuiToolboxButtonLabelBeginLength( ImuiWindow* window, const char* text, size_t length )
 {
 	ImuiWidget* buttonFrame = imuiToolboxButtonBegin( window );
 
 	ImuiWidget* buttonText = imuiWidgetBegin( window );
 
-	ImuiTextLayout* layout = imuiTextLayoutCreateWidget( buttonText, s_theme.font, text );
+	ImuiTextLayout* layout = imuiTextLayoutCreateWidgetLength( buttonText, s_theme.font, text, length );
 	const ImuiSize textSize = imuiTextLayoutGetSize( layout );
 	imuiWidgetSetAlign( buttonText, 0.5f, 0.5f );
 	imuiWidgetSetFixedSize( buttonText, textSize );
@@ -439,30 +780,8 @@ ImuiWidget* imuiToolboxButtonLabelBeginFormat( ImuiWindow* window, const char* f
 
 ImuiWidget* imuiToolboxButtonLabelBeginFormatArgs( ImuiWindow* window, const char* format, va_list args )
 {
-	char buffer[ 256u ];
-
-	int length = vsnprintf( buffer, sizeof( buffer ), format, args );
-	if( length < 0 )
-	{
-		return false;
-	}
-	else if( length >= sizeof( buffer ) )
-	{
-		char* headBuffer = (char*)imuiMemoryAlloc( &window->context->allocator, length + 1u );
-		if( !headBuffer )
-		{
-			return false;
-		}
-
-		length = vsnprintf( headBuffer, length + 1u, format, args );
-
-		ImuiWidget* button = imuiToolboxButtonLabelBegin( window, headBuffer );
-
-		imuiMemoryFree( &window->context->allocator, headBuffer );
-		return button;
-	}
-
-	return imuiToolboxButtonLabelBegin( window, buffer );
+	const ImuiStringView text = imuiStringArenaFormatArgs( &window->context->frameStrings, format, args );
+	return imuiToolboxButtonLabelBeginLength( window, text.data, text.length );
 }
 
 bool imuiToolboxButtonLabel( ImuiWindow* window, const char* text )
@@ -543,7 +862,7 @@ bool imuiToolboxCheckBoxEnd( ImuiWidget* checkBox, bool* checked, const char* te
 	const float dpiScale = imuiWidgetGetDpiScale( checkBox );
 	const float checkBackgroundY = (imuiWidgetGetSizeHeight( checkBox ) / 2.0f) - (s_theme.checkBox.size.height * dpiScale / 2.0f);
 	const ImuiRect checkBackgroundRect = imuiRectCreatePosSize( imuiPosCreate( 0.0f, checkBackgroundY ), imuiSizeScale( s_theme.checkBox.size, dpiScale ) );
-	imuiWidgetDrawPartialSkin( checkBox, checkBackgroundRect, &s_theme.skins[ ImuiToolboxSkin_CheckBox ], color );
+	imuiWidgetDrawPartialSkinDescriptor( checkBox, checkBackgroundRect, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_CheckBox ), color );
 
 	const ImuiImage* icon = &s_theme.icons[ *checked ? ImuiToolboxIcon_CheckBoxChecked : ImuiToolboxIcon_CheckBoxUnchecked ];
 	const ImuiRect checkIconRect = imuiRectCreateCenterPosSize( imuiRectGetCenter( checkBackgroundRect ), imuiSizeScale( imuiSizeCreateImage( icon ), dpiScale ) );
@@ -648,30 +967,26 @@ ImuiWidget* imuiToolboxLabelBeginFormat( ImuiWindow* window, const char* format,
 
 ImuiWidget* imuiToolboxLabelBeginFormatArgs( ImuiWindow* window, const char* format, va_list args )
 {
-	char buffer[ 256u ];
-
-	int length = vsnprintf( buffer, sizeof( buffer ), format, args );
-	if( length < 0 )
-	{
-		return NULL;
-	}
-	else if( length >= sizeof( buffer ) )
-	{
-		char* headBuffer = (char*)imuiMemoryAlloc( &window->context->allocator, length + 1u );
-		if( !headBuffer )
-		{
-			return NULL;
-		}
-
-		length = vsnprintf( headBuffer, length + 1u, format, args );
+	const ImuiStringView text = imuiStringArenaFormatArgs( &window->context->frameStrings, format, args );
+	return imuiToolboxLabelBeginLength( window, text.data, text.length );
+}
 
-		ImuiWidget* label = imuiToolboxLabelBegin( window, headBuffer );
+ImuiWidget* imuiToolboxLabelBeginInt( ImuiWindow* window, int64_t value )
+{
+	const ImuiStringView text = imuiStringArenaFormatInt( &window->context->frameStrings, value );
+	return imuiToolboxLabelBeginLength( window, text.data, text.length );
+}
 
-		imuiMemoryFree( &window->context->allocator, headBuffer );
-		return label;
-	}
+ImuiWidget* imuiToolboxLabelBeginUInt( ImuiWindow* window, uint64_t value )
+{
+	const ImuiStringView text = imuiStringArenaFormatUInt( &window->context->frameStrings, value );
+	return imuiToolboxLabelBeginLength( window, text.data, text.length );
+}
 
-	return imuiToolboxLabelBegin( window, buffer );
+ImuiWidget* imuiToolboxLabelBeginFloat( ImuiWindow* window, double value, uint32_t decimals )
+{
+	const ImuiStringView text = imuiStringArenaFormatFloat( &window->context->frameStrings, value, decimals );
+	return imuiToolboxLabelBeginLength( window, text.data, text.length );
 }
 
 void imuiToolboxLabelEnd( ImuiWidget* label )
@@ -711,6 +1026,24 @@ void imuiToolboxLabelFormatArgs( ImuiWindow* window, const char* format, va_list
 	imuiToolboxLabelEnd( label );
 }
 
+void imuiToolboxLabelInt( ImuiWindow* window, int64_t value )
+{
+	ImuiWidget* label = imuiToolboxLabelBeginInt( window, value );
+	imuiToolboxLabelEnd( label );
+}
+
+void imuiToolboxLabelUInt( ImuiWindow* window, uint64_t value )
+{
+	ImuiWidget* label = imuiToolboxLabelBeginUInt( window, value );
+	imuiToolboxLabelEnd( label );
+}
+
+void imuiToolboxLabelFloat( ImuiWindow* window, double value, uint32_t decimals )
+{
+	ImuiWidget* label = imuiToolboxLabelBeginFloat( window, value, decimals );
+	imuiToolboxLabelEnd( label );
+}
+
 ImuiWidget* imuiToolboxImageBegin( ImuiWindow* window, ImuiSize imgSize )
 {
 	ImuiWidget* imgWidget = imuiWidgetBegin( window );
@@ -752,7 +1085,7 @@ bool imuiToolboxSliderEnd( ImuiWidget* slider, float* value, float min, float ma
 	ImuiWidgetInputState frameInputState;
 	imuiWidgetGetInputState( slider, &frameInputState );
 
-	imuiWidgetDrawSkin( slider, &s_theme.skins[ ImuiToolboxSkin_SliderBackground ], s_theme.colors[ ImuiToolboxColor_SliderBackground ] );
+	imuiWidgetDrawSkinDescriptor( slider, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_SliderBackground ), s_theme.colors[ ImuiToolboxColor_SliderBackground ] );
 
 	ImuiWidget* sliderPivot = imuiWidgetBegin( imuiWidgetGetWindow( slider ) );
 	imuiWidgetSetFixedSize( sliderPivot, s_theme.slider.pivotSize );
@@ -789,7 +1122,7 @@ bool imuiToolboxSliderEnd( ImuiWidget* slider, float* value, float min, float ma
 		changed = true;
 	}
 
-	imuiWidgetDrawSkin( sliderPivot, &s_theme.skins[ ImuiToolboxSkin_SliderPivot ], color );
+	imuiWidgetDrawSkinDescriptor( sliderPivot, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_SliderPivot ), color );
 
 	imuiWidgetEnd( sliderPivot );
 
@@ -861,6 +1194,20 @@ ImuiToolboxTextBuffer* imuiToolboxTextBufferCreateText( ImuiContext* imui, const
 	return textBuffer;
 }
 
+ImuiToolboxTextBuffer* imuiToolboxTextBufferCreateRing( ImuiContext* imui, size_t maxLength, size_t maxLineCount )
+{
+	ImuiToolboxTextBuffer* textBuffer = imuiToolboxTextBufferCreate( imui );
+	if( !textBuffer )
+	{
+		return NULL;
+	}
+
+	textBuffer->maxDataLength	= maxLength;
+	textBuffer->maxLinesLength	= maxLineCount;
+
+	return textBuffer;
+}
+
 void imuiToolboxTextBufferFree( ImuiToolboxTextBuffer* textBuffer )
 {
 	if( !textBuffer )
@@ -875,8 +1222,11 @@ void imuiToolboxTextBufferFree( ImuiToolboxTextBuffer* textBuffer )
 
 void imuiToolboxTextBufferSet( ImuiToolboxTextBuffer* textBuffer, const char* text )
 {
-	textBuffer->dataLength	= 0;
-	textBuffer->linesLength	= 0;
+	textBuffer->evictedLineCount	+= textBuffer->linesLength - textBuffer->linesOffset;
+	textBuffer->dataOffset			= 0;
+	textBuffer->dataLength			= 0;
+	textBuffer->linesOffset			= 0;
+	textBuffer->linesLength			= 0;
 
 	imuiToolboxTextBufferAppend( textBuffer, text );
 }
@@ -887,6 +1237,114 @@ void imuiToolboxTextBufferAppend( ImuiToolboxTextBuffer* textBuffer, const char*
 	imuiToolboxTextBufferAppendLength( textBuffer, text, textLength );
 }
 
+static void imuiToolboxTextBufferRingEvictLine( ImuiToolboxTextBuffer* textBuffer )
+{
+	IMUI_ASSERT( textBuffer->linesOffset < textBuffer->linesLength );
+
+	textBuffer->linesOffset++;
+	textBuffer->dataOffset = textBuffer->linesOffset < textBuffer->linesLength ? textBuffer->lines[ textBuffer->linesOffset ] : textBuffer->dataLength;
+	textBuffer->evictedLineCount++;
+}
+
+// the line after a trailing '\n' is only added once it gets content
+static bool imuiToolboxTextBufferRingIsLastLineComplete( const ImuiToolboxTextBuffer* textBuffer )
+{
+	if( textBuffer->linesOffset == textBuffer->linesLength )
+	{
+		return false;
+	}
+
+	return textBuffer->dataLength > textBuffer->lines[ textBuffer->linesLength - 1u ] &&
+		textBuffer->data[ textBuffer->dataLength - 1u ] == '\n';
+}
+
+static bool imuiToolboxTextBufferRingPushLine( ImuiToolboxTextBuffer* textBuffer, uintsize lineOffset )
+{
+	// compact only when at least half of the array is evicted to keep appends amortized O(1)
+	const uintsize lineCount = textBuffer->linesLength - textBuffer->linesOffset;
+	if( textBuffer->linesOffset > 0u &&
+		textBuffer->linesLength == textBuffer->linesCapacity &&
+		textBuffer->linesOffset >= lineCount )
+	{
+		memmove( textBuffer->lines, textBuffer->lines + textBuffer->linesOffset, sizeof( *textBuffer->lines ) * lineCount );
+		textBuffer->linesOffset = 0u;
+		textBuffer->linesLength = lineCount;
+	}
+
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( textBuffer->allocator, textBuffer->lines, textBuffer->linesCapacity, textBuffer->linesLength + 1u ) )
+	{
+		return false;
+	}
+
+	textBuffer->lines[ textBuffer->linesLength ] = lineOffset;
+	textBuffer->linesLength++;
+	return true;
+}
+
+// text contains at most one '\n' at the end
+static void imuiToolboxTextBufferRingAppendLine( ImuiToolboxTextBuffer* textBuffer, const char* text, uintsize textLength )
+{
+	if( textBuffer->maxDataLength > 0u )
+	{
+		if( textLength > textBuffer->maxDataLength )
+		{
+			text += textLength - textBuffer->maxDataLength;
+			textLength = textBuffer->maxDataLength;
+		}
+
+		while( (textBuffer->dataLength - textBuffer->dataOffset) + textLength > textBuffer->maxDataLength &&
+			(textBuffer->linesOffset + 1u < textBuffer->linesLength || imuiToolboxTextBufferRingIsLastLineComplete( textBuffer )) )
+		{
+			imuiToolboxTextBufferRingEvictLine( textBuffer );
+		}
+
+		if( (textBuffer->dataLength - textBuffer->dataOffset) + textLength > textBuffer->maxDataLength )
+		{
+			// last line alone is too long, drop its beginning
+			textBuffer->dataOffset = textBuffer->dataLength;
+			if( textBuffer->linesOffset < textBuffer->linesLength )
+			{
+				textBuffer->lines[ textBuffer->linesOffset ] = textBuffer->dataLength;
+			}
+		}
+	}
+
+	const uintsize dataLength = textBuffer->dataLength - textBuffer->dataOffset;
+	if( textBuffer->dataOffset > 0u &&
+		textBuffer->dataLength + textLength > textBuffer->dataCapacity &&
+		textBuffer->dataOffset >= dataLength )
+	{
+		memmove( textBuffer->data, textBuffer->data + textBuffer->dataOffset, dataLength );
+		for( uintsize i = textBuffer->linesOffset; i < textBuffer->linesLength; ++i )
+		{
+			textBuffer->lines[ i ] -= textBuffer->dataOffset;
+		}
+
+		textBuffer->dataOffset = 0u;
+		textBuffer->dataLength = dataLength;
+	}
+
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( textBuffer->allocator, textBuffer->data, textBuffer->dataCapacity, textBuffer->dataLength + textLength ) )
+	{
+		return;
+	}
+
+	if( (textBuffer->linesOffset == textBuffer->linesLength || imuiToolboxTextBufferRingIsLastLineComplete( textBuffer )) &&
+		!imuiToolboxTextBufferRingPushLine( textBuffer, textBuffer->dataLength ) )
+	{
+		return;
+	}
+
+	memcpy( textBuffer->data + textBuffer->dataLength, text, textLength );
+	textBuffer->dataLength += textLength;
+
+	while( textBuffer->maxLinesLength > 0u &&
+		textBuffer->linesLength - textBuffer->linesOffset > textBuffer->maxLinesLength )
+	{
+		imuiToolboxTextBufferRingEvictLine( textBuffer );
+	}
+}
+
 void imuiToolboxTextBufferAppendLength( ImuiToolboxTextBuffer* textBuffer, const char* text, size_t textLength )
 {
 	if( !text || textLength == 0u )
@@ -894,6 +1352,22 @@ void imuiToolboxTextBufferAppendLength( ImuiToolboxTextBuffer* textBuffer, const
 		return;
 	}
 
+	if( textBuffer->maxDataLength > 0u || textBuffer->maxLinesLength > 0u )
+	{
+		while( textLength > 0u )
+		{
+			const char* lineEnd = (const char*)memchr( text, '\n', textLength );
+			const uintsize lineLength = lineEnd ? (uintsize)(lineEnd - text) + 1u : textLength;
+
+			imuiToolboxTextBufferRingAppendLine( textBuffer, text, lineLength );
+
+			text		+= lineLength;
+			textLength	-= lineLength;
+		}
+
+		return;
+	}
+
 	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( textBuffer->allocator, textBuffer->data, textBuffer->dataCapacity, textBuffer->dataLength + textLength ) )
 	{
 		return;
@@ -943,12 +1417,12 @@ void imuiToolboxTextBufferAppendLength( ImuiToolboxTextBuffer* textBuffer, const
 
 const char* imuiToolboxTextBufferGetData( const ImuiToolboxTextBuffer* textBuffer )
 {
-	if( !textBuffer )
+	if( !textBuffer || !textBuffer->data )
 	{
 		return NULL;
 	}
 
-	return textBuffer->data;
+	return textBuffer->data + textBuffer->dataOffset;
 }
 
 size_t imuiToolboxTextBufferGetLength( const ImuiToolboxTextBuffer* textBuffer )
@@ -958,43 +1432,504 @@ size_t imuiToolboxTextBufferGetLength( const ImuiToolboxTextBuffer* textBuffer )
 		return 0;
 	}
 
-	return textBuffer->dataLength;
+	return textBuffer->dataLength - textBuffer->dataOffset;
 }
 
-ImuiWidget* imuiToolboxTextEditBegin( ImuiWindow* window )
+size_t imuiToolboxTextBufferGetLineCount( const ImuiToolboxTextBuffer* textBuffer )
 {
-	ImuiWidget* textEditFrame = imuiWidgetBegin( window );
-	imuiWidgetSetHStretch( textEditFrame, 1.0f );
-	imuiWidgetSetPadding( textEditFrame, s_theme.textEdit.padding );
-	imuiWidgetSetFixedHeight( textEditFrame, s_theme.textEdit.height );
-
-	imuiWidgetDrawSkin( textEditFrame, &s_theme.skins[ ImuiToolboxSkin_TextEditBackground ], s_theme.colors[ ImuiToolboxColor_TextEditBackground ] );
+	if( !textBuffer )
+	{
+		return 0;
+	}
 
-	return textEditFrame;
+	return textBuffer->linesLength - textBuffer->linesOffset;
 }
 
-bool imuiToolboxTextEditEnd( ImuiWidget* textEdit, char* buffer, size_t bufferSize, size_t* textLength )
+static uintsize imuiToolboxTextDocumentGetLengthInternal( const ImuiToolboxTextDocument* document )
 {
-	IMUI_ASSERT( buffer );
-	IMUI_ASSERT( bufferSize > 0u );
+	return document->dataCapacity - (document->gapEnd - document->gapStart);
+}
 
-	ImuiContext* imui = imuiWidgetGetContext( textEdit );
-	const ImuiInputState* input = imuiWidgetGetInput( textEdit );
+static char imuiToolboxTextDocumentGetChar( const ImuiToolboxTextDocument* document, uintsize offset )
+{
+	return offset < document->gapStart ? document->data[ offset ] : document->data[ offset + (document->gapEnd - document->gapStart) ];
+}
 
-	uintsize textLengthInternal;
-	if( textLength )
+static void imuiToolboxTextDocumentMoveGap( ImuiToolboxTextDocument* document, uintsize offset )
+{
+	if( offset < document->gapStart )
 	{
-		textLengthInternal = *textLength;
+		const uintsize moveLength = document->gapStart - offset;
+		memmove( document->data + document->gapEnd - moveLength, document->data + offset, moveLength );
+		document->gapStart	-= moveLength;
+		document->gapEnd	-= moveLength;
 	}
-	else
+	else if( offset > document->gapStart )
 	{
-		textLengthInternal = strlen( buffer );
+		const uintsize moveLength = offset - document->gapStart;
+		memmove( document->data + document->gapStart, document->data + document->gapEnd, moveLength );
+		document->gapStart	+= moveLength;
+		document->gapEnd	+= moveLength;
 	}
+}
 
-	ImuiWidgetInputState inputState;
-	imuiWidgetGetInputState( textEdit, &inputState );
-
-	if( inputState.isMouseOver )
+static bool imuiToolboxTextDocumentCheckGap( ImuiToolboxTextDocument* document, uintsize length )
+{
+	if( document->gapEnd - document->gapStart >= length )
+	{
+		return true;
+	}
+
+	const uintsize textLength	= imuiToolboxTextDocumentGetLengthInternal( document );
+	const uintsize tailLength	= document->dataCapacity - document->gapEnd;
+	uintsize newCapacity		= IMUI_MAX( document->dataCapacity * 2u, 256u );
+	while( newCapacity < textLength + length )
+	{
+		newCapacity *= 2u;
+	}
+
+	char* newData = (char*)imuiMemoryAlloc( document->allocator, newCapacity );
+	if( !newData )
+	{
+		return false;
+	}
+
+	if( document->data )
+	{
+		memcpy( newData, document->data, document->gapStart );
+		memcpy( newData + newCapacity - tailLength, document->data + document->gapEnd, tailLength );
+		imuiMemoryFree( document->allocator, document->data );
+	}
+
+	document->data			= newData;
+	document->dataCapacity	= newCapacity;
+	document->gapEnd		= newCapacity - tailLength;
+	return true;
+}
+
+static uintsize imuiToolboxTextDocumentGetLineCountInternal( const ImuiToolboxTextDocument* document )
+{
+	return document->linesGapStart + (document->linesCapacity - document->linesGapEnd);
+}
+
+static uintsize imuiToolboxTextDocumentGetLineStart( const ImuiToolboxTextDocument* document, uintsize lineIndex )
+{
+	if( lineIndex < document->linesGapStart )
+	{
+		return document->lines[ lineIndex ];
+	}
+
+	return imuiToolboxTextDocumentGetLengthInternal( document ) - document->lines[ document->linesGapEnd + (lineIndex - document->linesGapStart) ];
+}
+
+static uintsize imuiToolboxTextDocumentFindLine( const ImuiToolboxTextDocument* document, uintsize offset )
+{
+	// last line starting at or before offset
+	uintsize first	= 0u;
+	uintsize count	= imuiToolboxTextDocumentGetLineCountInternal( document );
+	while( count > 1u )
+	{
+		const uintsize half = count / 2u;
+		if( imuiToolboxTextDocumentGetLineStart( document, first + half ) <= offset )
+		{
+			first += half;
+			count -= half;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+
+	return first;
+}
+
+static void imuiToolboxTextDocumentMoveLinesGap( ImuiToolboxTextDocument* document, uintsize lineIndex )
+{
+	const uintsize textLength = imuiToolboxTextDocumentGetLengthInternal( document );
+	while( document->linesGapStart > lineIndex )
+	{
+		document->linesGapStart--;
+		document->linesGapEnd--;
+		document->lines[ document->linesGapEnd ] = textLength - document->lines[ document->linesGapStart ];
+	}
+
+	while( document->linesGapStart < lineIndex )
+	{
+		document->lines[ document->linesGapStart ] = textLength - document->lines[ document->linesGapEnd ];
+		document->linesGapStart++;
+		document->linesGapEnd++;
+	}
+}
+
+static bool imuiToolboxTextDocumentCheckLinesGap( ImuiToolboxTextDocument* document, uintsize count )
+{
+	if( document->linesGapEnd - document->linesGapStart >= count )
+	{
+		return true;
+	}
+
+	const uintsize lineCount	= imuiToolboxTextDocumentGetLineCountInternal( document );
+	const uintsize tailCount	= document->linesCapacity - document->linesGapEnd;
+	uintsize newCapacity		= IMUI_MAX( document->linesCapacity * 2u, IMUI_DEFAULT_ARRAY_CAPACITY );
+	while( newCapacity < lineCount + count )
+	{
+		newCapacity *= 2u;
+	}
+
+	uintsize* newLines = IMUI_MEMORY_ARRAY_NEW( document->allocator, uintsize, newCapacity );
+	if( !newLines )
+	{
+		return false;
+	}
+
+	if( document->lines )
+	{
+		memcpy( newLines, document->lines, sizeof( *newLines ) * document->linesGapStart );
+		memcpy( newLines + newCapacity - tailCount, document->lines + document->linesGapEnd, sizeof( *newLines ) * tailCount );
+		imuiMemoryFree( document->allocator, document->lines );
+	}
+
+	document->lines			= newLines;
+	document->linesCapacity	= newCapacity;
+	document->linesGapEnd	= newCapacity - tailCount;
+	return true;
+}
+
+static bool imuiToolboxTextDocumentInsertInternal( ImuiToolboxTextDocument* document, uintsize offset, const char* text, uintsize textLength )
+{
+	uintsize newLineCount = 0u;
+	for( const char* newLine = (const char*)memchr( text, '\n', textLength ); newLine; newLine = (const char*)memchr( newLine + 1, '\n', textLength - (newLine + 1 - text) ) )
+	{
+		newLineCount++;
+	}
+
+	if( !imuiToolboxTextDocumentCheckGap( document, textLength ) ||
+		!imuiToolboxTextDocumentCheckLinesGap( document, newLineCount ) )
+	{
+		return false;
+	}
+
+	// following lines are stored relative to the end and don't need to be touched
+	imuiToolboxTextDocumentMoveLinesGap( document, imuiToolboxTextDocumentFindLine( document, offset ) + 1u );
+	imuiToolboxTextDocumentMoveGap( document, offset );
+
+	memcpy( document->data + document->gapStart, text, textLength );
+	document->gapStart += textLength;
+
+	for( uintsize i = 0u; i < textLength; ++i )
+	{
+		if( text[ i ] == '\n' )
+		{
+			document->lines[ document->linesGapStart ] = offset + i + 1u;
+			document->linesGapStart++;
+		}
+	}
+
+	document->version++;
+	return true;
+}
+
+static void imuiToolboxTextDocumentRemoveInternal( ImuiToolboxTextDocument* document, uintsize offset, uintsize length )
+{
+	const uintsize textLength	= imuiToolboxTextDocumentGetLengthInternal( document );
+	const uintsize removeEnd	= offset + length;
+
+	imuiToolboxTextDocumentMoveLinesGap( document, imuiToolboxTextDocumentFindLine( document, offset ) + 1u );
+	while( document->linesGapEnd < document->linesCapacity &&
+		textLength - document->lines[ document->linesGapEnd ] <= removeEnd )
+	{
+		document->linesGapEnd++;
+	}
+
+	imuiToolboxTextDocumentMoveGap( document, offset );
+	document->gapEnd += length;
+
+	document->version++;
+}
+
+static void imuiToolboxTextDocumentPushEdit( ImuiToolboxTextDocument* document, bool isInsert, uintsize offset, const char* text, uintsize textLength )
+{
+	// drop redo history
+	document->editsCount		= document->editsLength;
+	document->editDataLength	= 0u;
+	if( document->editsLength > 0u )
+	{
+		const ImuiToolboxTextDocumentEdit* lastEdit = &document->edits[ document->editsLength - 1u ];
+		document->editDataLength = lastEdit->dataOffset + lastEdit->length;
+	}
+
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( document->allocator, document->editData, document->editDataCapacity, document->editDataLength + textLength ) )
+	{
+		return;
+	}
+
+	// typing and deleting single characters is merged into one edit
+	ImuiToolboxTextDocumentEdit* lastEdit = document->editsLength > 0u ? &document->edits[ document->editsLength - 1u ] : NULL;
+	const bool canMerge = lastEdit && document->editCanMerge && lastEdit->isInsert == isInsert && textLength <= 4u && !memchr( text, '\n', textLength );
+	if( canMerge && isInsert && lastEdit->offset + lastEdit->length == offset )
+	{
+		memcpy( document->editData + document->editDataLength, text, textLength );
+		lastEdit->length += textLength;
+	}
+	else if( canMerge && !isInsert && lastEdit->offset == offset )
+	{
+		memcpy( document->editData + document->editDataLength, text, textLength );
+		lastEdit->length += textLength;
+	}
+	else if( canMerge && !isInsert && offset + textLength == lastEdit->offset )
+	{
+		char* lastData = document->editData + lastEdit->dataOffset;
+		memmove( lastData + textLength, lastData, lastEdit->length );
+		memcpy( lastData, text, textLength );
+		lastEdit->offset	= offset;
+		lastEdit->length	+= textLength;
+	}
+	else
+	{
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( document->allocator, document->edits, document->editsCapacity, document->editsLength + 1u ) )
+		{
+			return;
+		}
+
+		ImuiToolboxTextDocumentEdit* edit = &document->edits[ document->editsLength ];
+		edit->offset		= offset;
+		edit->length		= textLength;
+		edit->dataOffset	= document->editDataLength;
+		edit->isInsert		= isInsert;
+
+		memcpy( document->editData + document->editDataLength, text, textLength );
+		document->editsLength++;
+	}
+
+	document->editsCount		= document->editsLength;
+	document->editDataLength	+= textLength;
+	document->editCanMerge		= true;
+}
+
+ImuiToolboxTextDocument* imuiToolboxTextDocumentCreate( ImuiContext* imui )
+{
+	ImuiToolboxTextDocument* document = IMUI_MEMORY_NEW_ZERO( &imui->allocator, ImuiToolboxTextDocument );
+	if( !document )
+	{
+		return NULL;
+	}
+
+	document->allocator = &imui->allocator;
+
+	if( !imuiToolboxTextDocumentCheckLinesGap( document, 1u ) )
+	{
+		imuiToolboxTextDocumentFree( document );
+		return NULL;
+	}
+
+	document->lines[ 0u ]		= 0u;
+	document->linesGapStart		= 1u;
+
+	return document;
+}
+
+ImuiToolboxTextDocument* imuiToolboxTextDocumentCreateText( ImuiContext* imui, const char* text, size_t textLength )
+{
+	ImuiToolboxTextDocument* document = imuiToolboxTextDocumentCreate( imui );
+	if( !document )
+	{
+		return NULL;
+	}
+
+	imuiToolboxTextDocumentSet( document, text, textLength );
+	return document;
+}
+
+void imuiToolboxTextDocumentFree( ImuiToolboxTextDocument* document )
+{
+	if( !document )
+	{
+		return;
+	}
+
+	imuiMemoryFree( document->allocator, document->data );
+	imuiMemoryFree( document->allocator, document->lines );
+	imuiMemoryFree( document->allocator, document->edits );
+	imuiMemoryFree( document->allocator, document->editData );
+	imuiMemoryFree( document->allocator, document );
+}
+
+void imuiToolboxTextDocumentSet( ImuiToolboxTextDocument* document, const char* text, size_t textLength )
+{
+	document->gapStart			= 0u;
+	document->gapEnd			= document->dataCapacity;
+	document->linesGapStart		= 1u;
+	document->linesGapEnd		= document->linesCapacity;
+	document->editsLength		= 0u;
+	document->editsCount		= 0u;
+	document->editDataLength	= 0u;
+	document->editCanMerge		= false;
+
+	if( text && textLength > 0u )
+	{
+		imuiToolboxTextDocumentInsertInternal( document, 0u, text, textLength );
+	}
+
+	document->version++;
+}
+
+void imuiToolboxTextDocumentInsert( ImuiToolboxTextDocument* document, size_t offset, const char* text, size_t textLength )
+{
+	if( !text || textLength == 0u )
+	{
+		return;
+	}
+
+	offset = IMUI_MIN( offset, imuiToolboxTextDocumentGetLengthInternal( document ) );
+	if( imuiToolboxTextDocumentInsertInternal( document, offset, text, textLength ) )
+	{
+		imuiToolboxTextDocumentPushEdit( document, true, offset, text, textLength );
+	}
+}
+
+void imuiToolboxTextDocumentRemove( ImuiToolboxTextDocument* document, size_t offset, size_t length )
+{
+	const uintsize textLength = imuiToolboxTextDocumentGetLengthInternal( document );
+	offset = IMUI_MIN( offset, textLength );
+	length = IMUI_MIN( length, textLength - offset );
+	if( length == 0u )
+	{
+		return;
+	}
+
+	imuiToolboxTextDocumentPushEdit( document, false, offset, imuiToolboxTextDocumentGetText( document, offset, length ), length );
+	imuiToolboxTextDocumentRemoveInternal( document, offset, length );
+}
+
+bool imuiToolboxTextDocumentUndo( ImuiToolboxTextDocument* document )
+{
+	if( document->editsLength == 0u )
+	{
+		return false;
+	}
+
+	document->editsLength--;
+	const ImuiToolboxTextDocumentEdit* edit = &document->edits[ document->editsLength ];
+	if( edit->isInsert )
+	{
+		imuiToolboxTextDocumentRemoveInternal( document, edit->offset, edit->length );
+	}
+	else
+	{
+		imuiToolboxTextDocumentInsertInternal( document, edit->offset, document->editData + edit->dataOffset, edit->length );
+	}
+
+	document->editCanMerge = false;
+	return true;
+}
+
+bool imuiToolboxTextDocumentRedo( ImuiToolboxTextDocument* document )
+{
+	if( document->editsLength == document->editsCount )
+	{
+		return false;
+	}
+
+	const ImuiToolboxTextDocumentEdit* edit = &document->edits[ document->editsLength ];
+	if( edit->isInsert )
+	{
+		imuiToolboxTextDocumentInsertInternal( document, edit->offset, document->editData + edit->dataOffset, edit->length );
+	}
+	else
+	{
+		imuiToolboxTextDocumentRemoveInternal( document, edit->offset, edit->length );
+	}
+
+	document->editsLength++;
+	document->editCanMerge = false;
+	return true;
+}
+
+const char* imuiToolboxTextDocumentGetText( ImuiToolboxTextDocument* document, size_t offset, size_t length )
+{
+	const uintsize textLength = imuiToolboxTextDocumentGetLengthInternal( document );
+	if( !document->data || offset >= textLength )
+	{
+		return "";
+	}
+
+	length = IMUI_MIN( length, textLength - offset );
+	if( offset < document->gapStart &&
+		offset + length > document->gapStart )
+	{
+		// move the smaller side of the range over the gap
+		const uintsize frontLength = document->gapStart - offset;
+		imuiToolboxTextDocumentMoveGap( document, frontLength < length - frontLength ? offset : offset + length );
+	}
+
+	if( offset < document->gapStart )
+	{
+		return document->data + offset;
+	}
+
+	return document->data + offset + (document->gapEnd - document->gapStart);
+}
+
+size_t imuiToolboxTextDocumentGetLength( const ImuiToolboxTextDocument* document )
+{
+	return imuiToolboxTextDocumentGetLengthInternal( document );
+}
+
+size_t imuiToolboxTextDocumentGetLineCount( const ImuiToolboxTextDocument* document )
+{
+	return imuiToolboxTextDocumentGetLineCountInternal( document );
+}
+
+size_t imuiToolboxTextDocumentGetLineOffset( const ImuiToolboxTextDocument* document, size_t lineIndex )
+{
+	if( lineIndex >= imuiToolboxTextDocumentGetLineCountInternal( document ) )
+	{
+		return imuiToolboxTextDocumentGetLengthInternal( document );
+	}
+
+	return imuiToolboxTextDocumentGetLineStart( document, lineIndex );
+}
+
+uint64_t imuiToolboxTextDocumentGetVersion( const ImuiToolboxTextDocument* document )
+{
+	return document->version;
+}
+
+ImuiWidget* imuiToolboxTextEditBegin( ImuiWindow* window )
+{
+	ImuiWidget* textEditFrame = imuiWidgetBegin( window );
+	imuiWidgetSetHStretch( textEditFrame, 1.0f );
+	imuiWidgetSetPadding( textEditFrame, s_theme.textEdit.padding );
+	imuiWidgetSetFixedHeight( textEditFrame, s_theme.textEdit.height );
+
+	imuiWidgetDrawSkinDescriptor( textEditFrame, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_TextEditBackground ), s_theme.colors[ ImuiToolboxColor_TextEditBackground ] );
+
+	return textEditFrame;
+}
+
+bool imuiToolboxTextEditEnd( ImuiWidget* textEdit, char* buffer, size_t bufferSize, size_t* textLength )
+{
+	IMUI_ASSERT( buffer );
+	IMUI_ASSERT( bufferSize > 0u );
+
+	ImuiContext* imui = imuiWidgetGetContext( textEdit );
+	const ImuiInputState* input = imuiWidgetGetInput( textEdit );
+
+	uintsize textLengthInternal;
+	if( textLength )
+	{
+		textLengthInternal = *textLength;
+	}
+	else
+	{
+		textLengthInternal = strlen( buffer );
+	}
+
+	ImuiWidgetInputState inputState;
+	imuiWidgetGetInputState( textEdit, &inputState );
+
+	if( inputState.isMouseOver )
 	{
 		imuiInputSetMouseCursor( imui, ImuiInputMouseCursor_IBeam );
 	}
@@ -1270,8 +2205,11 @@ bool imuiToolboxTextEditEnd( ImuiWidget* textEdit, char* buffer, size_t bufferSi
 
 	if( state->hasFocus )
 	{
-		const double blinkValue	= fmod( imuiWidgetGetTime( textEdit ), s_theme.textEdit.blinkTime * 2.0 );
+		const double time		= imuiWidgetGetTime( textEdit );
+		const double blinkValue	= fmod( time, s_theme.textEdit.blinkTime * 2.0 );
 		const bool blink		= blinkValue > s_theme.textEdit.blinkTime;
+		imuiWidgetRequestUpdate( textEdit, imuiToolboxGetBlinkUpdateTime( time ) );
+
 		if( blink )
 		{
 			//const imuiPos cursorPos			= imuiPosAdd( imuiTextLayoutGetGlyphPos( layout, state->cursorPos ), s_config.textEdit.padding.left, s_config.textEdit.padding.top );
@@ -1322,34 +2260,72 @@ const char* imuiToolboxTextEditStateBufferDefault( ImuiWindow* window, size_t bu
 	return buffer;
 }
 
-ImuiWidget* imuiToolboxTextViewBegin( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text )
+static void imuiToolboxTextViewStateDestruct( void* stateData )
 {
-	ImuiToolboxTextBuffer* textBuffer = imuiToolboxTextBufferCreateText( window->context, text );
-
-	ImuiWidget* textViewWidget = imuiToolboxTextViewBeginBuffer( textView, window, textBuffer );
-	textView->ownsBuffer = true;
-
-	return textViewWidget;
+	ImuiToolboxTextViewState* state = (ImuiToolboxTextViewState*)stateData;
+	if( state->textBuffer.allocator )
+	{
+		imuiMemoryFree( state->textBuffer.allocator, state->textBuffer.lines );
+	}
 }
 
-ImuiWidget* imuiToolboxTextViewBeginBuffer( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const ImuiToolboxTextBuffer* textBuffer )
+static ImuiToolboxTextViewState* imuiToolboxTextViewBeginState( ImuiToolboxTextViewContext* textView, ImuiWindow* window )
 {
-	ImuiWidget* list = imuiToolboxListBegin( &textView->list, window, s_theme.font ? s_theme.font->fontSize : 1.0f, textBuffer->linesLength, false );
-
+	// item count is set once the text is known because the line index lives in the list state
+	ImuiWidget* list = imuiToolboxListBegin( &textView->list, window, s_theme.font ? s_theme.font->fontSize : 1.0f, 0u, false );
 	imuiWidgetSetStretchOne( list );
 
-	//bool isNewState;
-	textView->ownsBuffer	= false;
-	textView->textBuffer	= textBuffer;
-
-	for( uintsize i = imuiToolboxListGetBeginIndex( &textView->list ); i < imuiToolboxListGetEndIndex( &textView->list ); ++i )
+	bool isNewState;
+	ImuiToolboxTextViewState* state = (ImuiToolboxTextViewState*)imuiWidgetAllocStateNewDestruct( list, sizeof( *state ), IMUI_ID_STR( "text view" ), &isNewState, imuiToolboxTextViewStateDestruct );
+	if( isNewState )
 	{
-		imuiToolboxListNextItem( &textView->list );
+		state->textBuffer.allocator = &window->context->allocator;
+	}
+
+	return state;
+}
+
+static ImuiWidget* imuiToolboxTextViewBeginLines( ImuiToolboxTextViewContext* textView, ImuiWindow* window, ImuiToolboxTextViewState* state, const ImuiToolboxTextBuffer* textBuffer )
+{
+	ImuiToolboxListContext* list = &textView->list;
+
+	const uintsize lineCount = textBuffer->linesLength - textBuffer->linesOffset;
+	imuiToolboxListSetItemCountInternal( list, lineCount );
+
+	// keep the visible lines in place when a ring buffer dropped lines since last frame
+	const uint64 evictedLineCount = state->lastTextBuffer == textBuffer ? textBuffer->evictedLineCount - state->evictedLineCount : 0u;
+	state->lastTextBuffer	= textBuffer;
+	state->evictedLineCount	= textBuffer->evictedLineCount;
+	if( evictedLineCount > 0u )
+	{
+		const float totalItemSize = list->itemSize + s_theme.list.itemSpacing;
+		const float scrollOffset = totalItemSize * window->surface->dpiScale * (float)evictedLineCount;
+		const uintsize shift = (uintsize)IMUI_MIN( evictedLineCount, (uint64)list->beginIndex );
+
+		imuiToolboxScrollAreaMoveOffset( &list->scrollArea, 0.0f, -scrollOffset );
+		list->scrollArea.state->offset.y = IMUI_MAX( 0.0f, list->scrollArea.state->offset.y );
+		imuiWidgetSetLayoutScroll( list->scrollArea.content, list->scrollArea.state->offset.x, list->scrollArea.state->offset.y );
+
+		list->beginIndex	-= shift;
+		list->endIndex		= IMUI_MIN( list->endIndex - shift, lineCount );
+		list->itemIndex		= list->beginIndex - 1u;
+	}
 
-		const bool lastLine = i == textBuffer->linesLength - 1u;
-		const uintsize lineOffset = textBuffer->lines[ i ];
-		const uintsize nextLineOffset = lastLine ? textBuffer->dataLength : textBuffer->lines[ i + 1 ];
-		const uintsize lineLength = (nextLineOffset - lineOffset) - (lastLine ? 0 : 1);
+	textView->textBuffer = textBuffer;
+
+	for( uintsize i = imuiToolboxListGetBeginIndex( list ); i < imuiToolboxListGetEndIndex( list ); ++i )
+	{
+		imuiToolboxListNextItem( list );
+
+		const uintsize lineIndex = textBuffer->linesOffset + i;
+		const bool lastLine = lineIndex == textBuffer->linesLength - 1u;
+		const uintsize lineOffset = textBuffer->lines[ lineIndex ];
+		const uintsize nextLineOffset = lastLine ? textBuffer->dataLength : textBuffer->lines[ lineIndex + 1 ];
+		uintsize lineLength = nextLineOffset - lineOffset;
+		if( lineLength > 0u && textBuffer->data[ nextLineOffset - 1u ] == '\n' )
+		{
+			lineLength--;
+		}
 		IMUI_ASSERT( nextLineOffset <= textBuffer->dataLength );
 		IMUI_ASSERT( lineLength <= textBuffer->dataLength );
 
@@ -1357,19 +2333,77 @@ ImuiWidget* imuiToolboxTextViewBeginBuffer( ImuiToolboxTextViewContext* textView
 		imuiToolboxLabelLength( window, line, lineLength );
 	}
 
-	return textView->list.list;
+	return list->list;
 }
 
-void imuiToolboxTextViewEnd( ImuiToolboxTextViewContext* textView )
+static void imuiToolboxTextViewSplitLines( ImuiToolboxTextViewState* state, const char* text, uintsize textLength, uint64 textVersion )
 {
+	ImuiToolboxTextBuffer* textBuffer = &state->textBuffer;
+	textBuffer->data		= (char*)text;
+	textBuffer->dataLength	= textLength;
+	textBuffer->linesLength	= 0u;
+	state->textVersion		= textVersion;
 
-	imuiToolboxListEnd( &textView->list );
+	for( const char* line = text; line; )
+	{
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( textBuffer->allocator, textBuffer->lines, textBuffer->linesCapacity, textBuffer->linesLength + 1u ) )
+		{
+			textBuffer->linesLength = 0u;
+			break;
+		}
+
+		textBuffer->lines[ textBuffer->linesLength ] = line - text;
+		textBuffer->linesLength++;
+
+		line = memchr( line, '\n', textLength - (line - text) );
+		if( line )
+		{
+			line++;
+		}
+	}
+}
+
+ImuiWidget* imuiToolboxTextViewBegin( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text )
+{
+	// keyed by pointer only, strlen on every frame would scan the whole text again
+	ImuiToolboxTextViewState* state = imuiToolboxTextViewBeginState( textView, window );
+	ImuiToolboxTextBuffer* textBuffer = &state->textBuffer;
 
-	if( textView->ownsBuffer )
+	if( textBuffer->data != text ||
+		textBuffer->linesLength == 0u )
 	{
-		imuiToolboxTextBufferFree( (ImuiToolboxTextBuffer*)textView->textBuffer );
-		textView->textBuffer = NULL;
+		imuiToolboxTextViewSplitLines( state, text, text ? strlen( text ) : 0u, 0u );
 	}
+
+	return imuiToolboxTextViewBeginLines( textView, window, state, textBuffer );
+}
+
+ImuiWidget* imuiToolboxTextViewBeginStatic( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const char* text, size_t textLength, uint64_t textVersion )
+{
+	ImuiToolboxTextViewState* state = imuiToolboxTextViewBeginState( textView, window );
+	ImuiToolboxTextBuffer* textBuffer = &state->textBuffer;
+
+	if( textBuffer->data != text ||
+		textBuffer->dataLength != textLength ||
+		state->textVersion != textVersion ||
+		textBuffer->linesLength == 0u )
+	{
+		imuiToolboxTextViewSplitLines( state, text, textLength, textVersion );
+	}
+
+	return imuiToolboxTextViewBeginLines( textView, window, state, textBuffer );
+}
+
+ImuiWidget* imuiToolboxTextViewBeginBuffer( ImuiToolboxTextViewContext* textView, ImuiWindow* window, const ImuiToolboxTextBuffer* textBuffer )
+{
+	ImuiToolboxTextViewState* state = imuiToolboxTextViewBeginState( textView, window );
+	return imuiToolboxTextViewBeginLines( textView, window, state, textBuffer );
+}
+
+void imuiToolboxTextViewEnd( ImuiToolboxTextViewContext* textView )
+{
+	imuiToolboxListEnd( &textView->list );
+	textView->textBuffer = NULL;
 }
 
 void imuiToolboxTextView( ImuiWindow* window, const char* text )
@@ -1386,6 +2420,412 @@ void imuiToolboxTextViewBuffer( ImuiWindow* window, const ImuiToolboxTextBuffer*
 	imuiToolboxTextViewEnd( &textView );
 }
 
+static uintsize imuiToolboxTextEditorGetLineEnd( const ImuiToolboxTextDocument* document, uintsize lineIndex )
+{
+	if( lineIndex + 1u < imuiToolboxTextDocumentGetLineCountInternal( document ) )
+	{
+		return imuiToolboxTextDocumentGetLineStart( document, lineIndex + 1u ) - 1u;
+	}
+
+	return imuiToolboxTextDocumentGetLengthInternal( document );
+}
+
+static uintsize imuiToolboxTextEditorMoveChar( const ImuiToolboxTextDocument* document, uintsize offset, sint32 direction )
+{
+	const uintsize textLength = imuiToolboxTextDocumentGetLengthInternal( document );
+	if( direction < 0 && offset > 0u )
+	{
+		offset--;
+		while( offset > 0u && (imuiToolboxTextDocumentGetChar( document, offset ) & 0xc0) == 0x80 )
+		{
+			offset--;
+		}
+	}
+	else if( direction > 0 && offset < textLength )
+	{
+		offset++;
+		while( offset < textLength && (imuiToolboxTextDocumentGetChar( document, offset ) & 0xc0) == 0x80 )
+		{
+			offset++;
+		}
+	}
+
+	return offset;
+}
+
+static uintsize imuiToolboxTextEditorGetColumnOffset( const ImuiToolboxTextDocument* document, uintsize lineIndex, uintsize column )
+{
+	const uintsize lineEnd = imuiToolboxTextEditorGetLineEnd( document, lineIndex );
+
+	uintsize offset = imuiToolboxTextDocumentGetLineStart( document, lineIndex );
+	for( ; column > 0u && offset < lineEnd; --column )
+	{
+		offset = imuiToolboxTextEditorMoveChar( document, offset, 1 );
+	}
+
+	return offset;
+}
+
+static void imuiToolboxTextEditorRemoveSelection( ImuiToolboxTextDocument* document, ImuiToolboxTextEditorState* state )
+{
+	const uintsize selectionStart	= IMUI_MIN( state->cursorOffset, state->selectionOffset );
+	const uintsize selectionEnd		= IMUI_MAX( state->cursorOffset, state->selectionOffset );
+
+	imuiToolboxTextDocumentRemove( document, selectionStart, selectionEnd - selectionStart );
+	state->cursorOffset		= selectionStart;
+	state->selectionOffset	= selectionStart;
+}
+
+static void imuiToolboxTextEditorInsert( ImuiToolboxTextDocument* document, ImuiToolboxTextEditorState* state, const char* text, uintsize length )
+{
+	if( state->cursorOffset != state->selectionOffset )
+	{
+		imuiToolboxTextEditorRemoveSelection( document, state );
+	}
+
+	imuiToolboxTextDocumentInsert( document, state->cursorOffset, text, length );
+	state->cursorOffset		+= length;
+	state->selectionOffset	= state->cursorOffset;
+}
+
+static bool imuiToolboxTextEditorDelete( ImuiToolboxTextDocument* document, ImuiToolboxTextEditorState* state, bool backspace )
+{
+	if( state->cursorOffset == state->selectionOffset )
+	{
+		state->selectionOffset = imuiToolboxTextEditorMoveChar( document, state->cursorOffset, backspace ? -1 : 1 );
+	}
+
+	if( state->cursorOffset == state->selectionOffset )
+	{
+		return false;
+	}
+
+	imuiToolboxTextEditorRemoveSelection( document, state );
+	return true;
+}
+
+static bool imuiToolboxTextEditorReplayEvents( ImuiToolboxTextDocument* document, ImuiToolboxTextEditorState* state, const ImuiInputState* input )
+{
+	// apply text and deletes in the order they were typed, snapshots can't tell 'ab<backspace>' from 'a<backspace>b'
+	const char* text = imuiInputGetText( input );
+
+	bool changed = false;
+	for( uintsize i = 0u; i < imuiInputGetEventCount( input ); ++i )
+	{
+		const ImuiInputEvent* event = imuiInputGetEvent( input, i );
+		if( event->type == ImuiInputEventType_Text )
+		{
+			imuiToolboxTextEditorInsert( document, state, text + event->code, event->data.textLength );
+			changed = true;
+		}
+		else if( event->type != ImuiInputEventType_KeyDown &&
+			event->type != ImuiInputEventType_KeyRepeat )
+		{
+			continue;
+		}
+		else if( event->code == ImuiInputKey_Enter ||
+			event->code == ImuiInputKey_Numpad_Enter )
+		{
+			imuiToolboxTextEditorInsert( document, state, "\n", 1u );
+			changed = true;
+		}
+		else if( event->code == ImuiInputKey_Backspace ||
+			event->code == ImuiInputKey_Delete )
+		{
+			changed |= imuiToolboxTextEditorDelete( document, state, event->code == ImuiInputKey_Backspace );
+		}
+	}
+
+	return changed;
+}
+
+bool imuiToolboxTextEditor( ImuiWindow* window, ImuiToolboxTextDocument* document )
+{
+	ImuiContext* imui = window->context;
+	const float lineHeight = s_theme.font ? s_theme.font->fontSize : 1.0f;
+	const float scale = window->surface->dpiScale;
+
+	ImuiToolboxListContext list;
+	ImuiWidget* editor = imuiToolboxListBegin( &list, window, lineHeight, imuiToolboxTextDocumentGetLineCountInternal( document ), false );
+	imuiWidgetSetStretchOne( editor );
+	imuiWidgetSetPadding( editor, s_theme.textEdit.padding );
+	imuiWidgetDrawSkinDescriptor( editor, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_TextEditBackground ), s_theme.colors[ ImuiToolboxColor_TextEditBackground ] );
+
+	bool isNew;
+	ImuiToolboxTextEditorState* state = (ImuiToolboxTextEditorState*)imuiWidgetAllocStateNew( editor, sizeof( *state ), IMUI_ID_STR( "text editor" ), &isNew );
+
+	const ImuiInputState* input = imuiWidgetGetInput( editor );
+
+	ImuiWidgetInputState inputState;
+	imuiWidgetGetInputState( editor, &inputState );
+
+	if( inputState.isMouseOver )
+	{
+		imuiInputSetMouseCursor( imui, ImuiInputMouseCursor_IBeam );
+	}
+
+	if( imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left ) )
+	{
+		state->hasFocus = inputState.hasMousePressed;
+	}
+
+	// the document can be changed from outside
+	const uintsize initialLength = imuiToolboxTextDocumentGetLengthInternal( document );
+	state->cursorOffset		= IMUI_MIN( state->cursorOffset, initialLength );
+	state->selectionOffset	= IMUI_MIN( state->selectionOffset, initialLength );
+
+	ImuiWidgetInputState layoutInputState;
+	imuiWidgetGetInputState( list.listLayout, &layoutInputState );
+
+	bool changed = false;
+	bool cursorMoved = false;
+	if( layoutInputState.wasPressed )
+	{
+		const float scaledLineHeight	= (lineHeight + s_theme.list.itemSpacing) * scale;
+		const float mouseLine			= IMUI_MAX( 0.0f, layoutInputState.relativeMousePos.y / scaledLineHeight );
+		const uintsize lineIndex		= IMUI_MIN( (uintsize)mouseLine, imuiToolboxTextDocumentGetLineCountInternal( document ) - 1u );
+		const uintsize lineStart		= imuiToolboxTextDocumentGetLineStart( document, lineIndex );
+		const uintsize lineLength		= imuiToolboxTextEditorGetLineEnd( document, lineIndex ) - lineStart;
+
+		const ImuiTextLayout* layout	= imuiTextLayoutCreateLength( imui, s_theme.font, imuiToolboxTextDocumentGetText( document, lineStart, lineLength ), lineLength );
+		const uintsize glyphIndex		= imuiTextLayoutFindGlyphIndex( layout, imuiPosCreate( layoutInputState.relativeMousePos.x, 0.0f ), scale );
+
+		state->cursorOffset = lineStart + (layout ? imuiTextLayoutGetGlyphCharIndex( layout, glyphIndex ) : 0u);
+		state->cursorColumn = glyphIndex;
+		if( layoutInputState.hasMousePressed )
+		{
+			state->selectionOffset = state->cursorOffset;
+		}
+	}
+
+	if( state->hasFocus )
+	{
+		const ImuiInputShortcut shortcut = imuiInputGetShortcut( input );
+		const uint32 mods = imuiInputGetKeyModifiers( input );
+		const bool shiftPressed = (mods & (ImuiInputModifier_LeftShift | ImuiInputModifier_RightShift)) != 0;
+		const bool hasSelection = state->cursorOffset != state->selectionOffset;
+
+		if( shortcut == ImuiInputShortcut_SelectAll )
+		{
+			state->selectionOffset	= 0u;
+			state->cursorOffset		= imuiToolboxTextDocumentGetLengthInternal( document );
+		}
+		else if( (shortcut == ImuiInputShortcut_Copy || shortcut == ImuiInputShortcut_Cut) && hasSelection )
+		{
+			const uintsize selectionStart	= IMUI_MIN( state->cursorOffset, state->selectionOffset );
+			const uintsize selectionLength	= IMUI_MAX( state->cursorOffset, state->selectionOffset ) - selectionStart;
+			imuiInputSetCopyText( imui, imuiToolboxTextDocumentGetText( document, selectionStart, selectionLength ), selectionLength );
+
+			if( shortcut == ImuiInputShortcut_Cut )
+			{
+				imuiToolboxTextEditorRemoveSelection( document, state );
+				changed = true;
+			}
+		}
+		else if( shortcut == ImuiInputShortcut_Undo || shortcut == ImuiInputShortcut_Redo )
+		{
+			const bool isUndo = shortcut == ImuiInputShortcut_Undo;
+			if( isUndo ? imuiToolboxTextDocumentUndo( document ) : imuiToolboxTextDocumentRedo( document ) )
+			{
+				const ImuiToolboxTextDocumentEdit* edit = &document->edits[ isUndo ? document->editsLength : document->editsLength - 1u ];
+				state->cursorOffset		= edit->offset + (edit->isInsert != isUndo ? edit->length : 0u);
+				state->selectionOffset	= state->cursorOffset;
+				cursorMoved				= true;
+				changed					= true;
+			}
+		}
+
+		if( shortcut != ImuiInputShortcut_Paste &&
+			imuiInputGetEventCount( input ) > 0u &&
+			!imuiInputHasLostEvents( input ) )
+		{
+			if( imuiToolboxTextEditorReplayEvents( document, state, input ) )
+			{
+				cursorMoved	= true;
+				changed		= true;
+			}
+		}
+		else
+		{
+			const char* textInput = imuiInputGetText( input );
+			if( shortcut == ImuiInputShortcut_Paste )
+			{
+				textInput = imuiInputGetPasteText( imui );
+			}
+			else if( imuiInputHasKeyPressed( input, ImuiInputKey_Enter ) ||
+				imuiInputHasKeyPressed( input, ImuiInputKey_Numpad_Enter ) )
+			{
+				textInput = "\n";
+			}
+
+			if( textInput && textInput[ 0u ] != '\0' )
+			{
+				imuiToolboxTextEditorInsert( document, state, textInput, strlen( textInput ) );
+				cursorMoved	= true;
+				changed		= true;
+			}
+
+			const bool backspacePressed = imuiInputHasKeyPressed( input, ImuiInputKey_Backspace );
+			if( backspacePressed ||
+				imuiInputHasKeyPressed( input, ImuiInputKey_Delete ) )
+			{
+				if( imuiToolboxTextEditorDelete( document, state, backspacePressed ) )
+				{
+					cursorMoved	= true;
+					changed		= true;
+				}
+			}
+		}
+
+		const uintsize lineCount		= imuiToolboxTextDocumentGetLineCountInternal( document );
+		const uintsize cursorLine		= imuiToolboxTextDocumentFindLine( document, state->cursorOffset );
+		const uintsize pageLineCount	= list.endIndex > list.beginIndex + 2u ? list.endIndex - list.beginIndex - 2u : 1u;
+
+		uintsize nextCursorOffset	= state->cursorOffset;
+		uintsize nextCursorLine		= cursorLine;
+		const bool leftPressed		= imuiInputHasKeyPressed( input, ImuiInputKey_Left );
+		if( leftPressed ||
+			imuiInputHasKeyPressed( input, ImuiInputKey_Right ) )
+		{
+			if( !shiftPressed && state->cursorOffset != state->selectionOffset )
+			{
+				nextCursorOffset = leftPressed ? IMUI_MIN( state->cursorOffset, state->selectionOffset ) : IMUI_MAX( state->cursorOffset, state->selectionOffset );
+			}
+			else
+			{
+				nextCursorOffset = imuiToolboxTextEditorMoveChar( document, state->cursorOffset, leftPressed ? -1 : 1 );
+			}
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_Up ) && cursorLine > 0u )
+		{
+			nextCursorLine = cursorLine - 1u;
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_Down ) && cursorLine + 1u < lineCount )
+		{
+			nextCursorLine = cursorLine + 1u;
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_PageUp ) )
+		{
+			nextCursorLine = cursorLine > pageLineCount ? cursorLine - pageLineCount : 0u;
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_PageDown ) )
+		{
+			nextCursorLine = IMUI_MIN( cursorLine + pageLineCount, lineCount - 1u );
+		}
+		else if( shortcut == ImuiInputShortcut_Home )
+		{
+			nextCursorOffset = imuiToolboxTextDocumentGetLineStart( document, cursorLine );
+		}
+		else if( shortcut == ImuiInputShortcut_End )
+		{
+			nextCursorOffset = imuiToolboxTextEditorGetLineEnd( document, cursorLine );
+		}
+
+		if( nextCursorLine != cursorLine )
+		{
+			nextCursorOffset = imuiToolboxTextEditorGetColumnOffset( document, nextCursorLine, state->cursorColumn );
+		}
+
+		if( nextCursorOffset != state->cursorOffset )
+		{
+			state->cursorOffset = nextCursorOffset;
+			if( !shiftPressed )
+			{
+				state->selectionOffset = nextCursorOffset;
+			}
+
+			cursorMoved = true;
+		}
+
+		if( cursorMoved )
+		{
+			const uintsize newCursorLine	= imuiToolboxTextDocumentFindLine( document, state->cursorOffset );
+			const uintsize newLineStart		= imuiToolboxTextDocumentGetLineStart( document, newCursorLine );
+			if( nextCursorLine == cursorLine )
+			{
+				state->cursorColumn = imuiTextLayoutCalculateGlyphCount( imuiToolboxTextDocumentGetText( document, newLineStart, state->cursorOffset - newLineStart ), state->cursorOffset - newLineStart );
+			}
+
+			// keep the cursor line visible, takes effect next frame
+			const float scaledLineHeight	= (lineHeight + s_theme.list.itemSpacing) * scale;
+			const float cursorTop			= scaledLineHeight * (float)newCursorLine;
+			const ImuiSize viewSize			= imuiWidgetGetSize( list.scrollArea.area );
+			if( cursorTop < list.scrollArea.state->offset.y )
+			{
+				list.scrollArea.state->offset.y = cursorTop;
+			}
+			else if( cursorTop + scaledLineHeight > list.scrollArea.state->offset.y + viewSize.height )
+			{
+				list.scrollArea.state->offset.y = cursorTop + scaledLineHeight - viewSize.height;
+			}
+		}
+	}
+
+	imuiToolboxListSetItemCountInternal( &list, imuiToolboxTextDocumentGetLineCountInternal( document ) );
+
+	const uintsize selectionStart	= IMUI_MIN( state->cursorOffset, state->selectionOffset );
+	const uintsize selectionEnd		= IMUI_MAX( state->cursorOffset, state->selectionOffset );
+	const double time				= imuiWidgetGetTime( editor );
+	const double blinkValue			= fmod( time, s_theme.textEdit.blinkTime * 2.0 );
+	const bool drawCursor			= state->hasFocus && blinkValue > s_theme.textEdit.blinkTime;
+	if( state->hasFocus )
+	{
+		imuiWidgetRequestUpdate( editor, imuiToolboxGetBlinkUpdateTime( time ) );
+	}
+
+	for( uintsize i = list.beginIndex; i < list.endIndex; ++i )
+	{
+		ImuiWidget* item = imuiToolboxListNextItem( &list );
+
+		const uintsize lineStart	= imuiToolboxTextDocumentGetLineStart( document, i );
+		const uintsize lineEnd		= imuiToolboxTextEditorGetLineEnd( document, i );
+		const char* line			= imuiToolboxTextDocumentGetText( document, lineStart, lineEnd - lineStart );
+
+		ImuiWidget* text = imuiWidgetBegin( window );
+		imuiWidgetSetVAlign( text, 0.5f );
+
+		ImuiTextLayout* layout = imuiTextLayoutCreateWidgetLength( text, s_theme.font, line, lineEnd - lineStart );
+		imuiWidgetSetMinSize( text, imuiTextLayoutGetSize( layout ) );
+
+		if( selectionStart < selectionEnd &&
+			selectionStart <= lineEnd &&
+			selectionEnd >= lineStart &&
+			layout )
+		{
+			const uintsize startGlyph	= selectionStart > lineStart ? imuiTextLayoutCalculateGlyphCount( line, selectionStart - lineStart ) : 0u;
+			const uintsize endGlyph		= imuiTextLayoutCalculateGlyphCount( line, IMUI_MIN( selectionEnd, lineEnd ) - lineStart );
+			const float startX			= imuiTextLayoutGetGlyphPos( layout, startGlyph, scale ).x;
+			float endX					= imuiTextLayoutGetGlyphPos( layout, endGlyph, scale ).x;
+			if( selectionEnd > lineEnd )
+			{
+				// selected line break
+				endX += lineHeight * scale * 0.25f;
+			}
+
+			imuiWidgetDrawPartialColor( item, imuiRectCreate( startX, 0.0f, endX - startX, lineHeight * scale ), s_theme.colors[ ImuiToolboxColor_TextEditSelection ] );
+		}
+
+		if( layout )
+		{
+			imuiWidgetDrawText( text, layout, s_theme.colors[ ImuiToolboxColor_TextEditText ] );
+		}
+
+		if( drawCursor &&
+			state->cursorOffset >= lineStart &&
+			state->cursorOffset <= lineEnd )
+		{
+			const uintsize cursorGlyph	= imuiTextLayoutCalculateGlyphCount( line, state->cursorOffset - lineStart );
+			const float cursorX			= layout ? imuiTextLayoutGetGlyphPos( layout, cursorGlyph, scale ).x : 0.0f;
+			imuiWidgetDrawLine( item, imuiPosCreate( cursorX, 0.0f ), imuiPosCreate( cursorX, lineHeight * scale ), s_theme.colors[ ImuiToolboxColor_TextEditCursor ] );
+		}
+
+		imuiWidgetEnd( text );
+	}
+
+	imuiToolboxListEnd( &list );
+	return changed;
+}
+
 void imuiToolboxProgressBar( ImuiWindow* window, float value )
 {
 	imuiToolboxProgressBarMinMax( window, value, 0.0f, 1.0f );
@@ -1398,7 +2838,7 @@ void imuiToolboxProgressBarMinMax( ImuiWindow* window, float value, float min, f
 	imuiWidgetSetPadding( progressBar, s_theme.progressBar.padding );
 	imuiWidgetSetFixedHeight( progressBar, s_theme.progressBar.height );
 
-	imuiWidgetDrawSkin( progressBar, &s_theme.skins[ ImuiToolboxSkin_ProgressBarBackground ], s_theme.colors[ ImuiToolboxColor_ProgressBarBackground ] );
+	imuiWidgetDrawSkinDescriptor( progressBar, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ProgressBarBackground ), s_theme.colors[ ImuiToolboxColor_ProgressBarBackground ] );
 
 	const ImuiRect barRect = imuiWidgetGetInnerRect( progressBar );
 
@@ -1406,6 +2846,8 @@ void imuiToolboxProgressBarMinMax( ImuiWindow* window, float value, float min, f
 	if( value < min )
 	{
 		const double time		= imuiWindowGetTime( window );
+		imuiWidgetRequestUpdate( progressBar, time + s_theme.progressBar.animationInterval );
+
 		const float cosv		= ((float)cos( time * 8.0 ) * 0.15f) + 0.15f;
 		const float sinv		= ((float)sin( time * 4.0 ) * 0.5f) + 0.5f;
 		const float width		= ceilf( barRect.size.width * (0.1f + cosv) );
@@ -1431,7 +2873,7 @@ void imuiToolboxProgressBarMinMax( ImuiWindow* window, float value, float min, f
 		);
 	}
 
-	imuiWidgetDrawPartialSkin( progressBar, progressRect, &s_theme.skins[ ImuiToolboxSkin_ProgressBarProgress ], s_theme.colors[ ImuiToolboxColor_ProgressBarProgress ] );
+	imuiWidgetDrawPartialSkinDescriptor( progressBar, progressRect, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ProgressBarProgress ), s_theme.colors[ ImuiToolboxColor_ProgressBarProgress ] );
 
 	imuiWidgetEnd( progressBar );
 }
@@ -1577,267 +3019,1295 @@ void imuiToolboxScrollAreaEnd( ImuiToolboxScrollAreaContext* scrollArea )
 			state->wasPressedX = false;
 		}
 
-		imuiWidgetDrawSkin( scrollBar, &s_theme.skins[ ImuiToolboxSkin_ScrollAreaBarBackground ], s_theme.colors[ ImuiToolboxColor_ScrollAreaBarBackground ] );
-		imuiWidgetDrawPartialSkin( scrollBar, barPivotRect, &s_theme.skins[ ImuiToolboxSkin_ScrollAreaBarPivot ], s_theme.colors[ ImuiToolboxColor_ScrollAreaBarPivot ] );
+		imuiWidgetDrawSkinDescriptor( scrollBar, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ScrollAreaBarBackground ), s_theme.colors[ ImuiToolboxColor_ScrollAreaBarBackground ] );
+		imuiWidgetDrawPartialSkinDescriptor( scrollBar, barPivotRect, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ScrollAreaBarPivot ), s_theme.colors[ ImuiToolboxColor_ScrollAreaBarPivot ] );
 
 		imuiWidgetEnd( scrollBar );
 	}
 
-	if( hasVerticalBar )
+	if( hasVerticalBar )
+	{
+		float barHeight = frameRect.size.height - (hasHorizontalBar ? dpiBarSize : 0.0f);
+		barHeight = IMUI_MAX( 0.0f, barHeight );
+
+		ImuiWidget* scrollBar = imuiWidgetBegin( window );
+		imuiWidgetSetHAlign( scrollBar, 1.0f );
+		imuiWidgetSetFixedWidth( scrollBar, s_theme.scrollArea.barSize );
+		imuiWidgetSetVStretch( scrollBar, frameRect.size.height > 0.0f ? barHeight / frameRect.size.height : 1.0f );
+
+		const ImuiRect barRect		= imuiWidgetGetRect( scrollBar );
+		const float pivotSizeFactor	= frameAreaSize.height / areaSize.height;
+		const float pivotSize		= barHeight * pivotSizeFactor;
+		const float pivotSizeFinal	= IMUI_MAX( pivotSize, dpiBarMinSize );
+		const float pivotOffset		= (state->offset.y / areaSize.height) * (barHeight - (pivotSizeFinal - pivotSize));
+
+		const ImuiRect barPivotRect = imuiRectCreate(
+			0.0f,
+			pivotOffset,
+			dpiBarSize,
+			pivotSizeFinal
+		);
+
+		ImuiWidgetInputState inputState;
+		imuiWidgetGetInputState( scrollBar, &inputState );
+
+		if( inputState.wasPressed )
+		{
+			if( !state->wasPressedY &&
+				imuiRectIncludesPos( barPivotRect, inputState.relativeMousePos ) )
+			{
+				state->pressPoint.y	= inputState.relativeMousePos.y;
+				state->pressPoint.y	-= pivotOffset;
+				state->wasPressedY	= true;
+			}
+
+			if( state->wasPressedY )
+			{
+				const float newBarOffset	= inputState.relativeMousePos.y - state->pressPoint.y;
+				const float newOffset		= (newBarOffset / barRect.size.height) * areaSize.height;
+
+				state->offset.y = newOffset;
+			}
+		}
+		else
+		{
+			state->wasPressedY = false;
+		}
+
+		imuiWidgetDrawSkinDescriptor( scrollBar, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ScrollAreaBarBackground ), s_theme.colors[ ImuiToolboxColor_ScrollAreaBarBackground ] );
+		imuiWidgetDrawPartialSkinDescriptor( scrollBar, barPivotRect, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_ScrollAreaBarPivot ), s_theme.colors[ ImuiToolboxColor_ScrollAreaBarPivot ] );
+
+		imuiWidgetEnd( scrollBar );
+	}
+
+	if( areaInputState.isMouseOver )
+	{
+		state->offset = imuiPosSubPos( state->offset, imuiPosScale( imuiInputGetMouseScrollDelta( imuiWindowGetInput( window ) ), 80.0f ) );
+	}
+
+	state->offset = imuiPosMax( imuiPosCreateZero(), imuiPosMin( state->offset, imuiSizeToPos( imuiSizeSubSize( areaSize, frameAreaSize ) ) ) );
+
+	imuiWidgetEnd( scrollArea->area );
+}
+
+static void imuiToolboxListSetItemCountInternal( ImuiToolboxListContext* list, size_t itemCount )
+{
+	const float totalItemSize = list->itemSize + s_theme.list.itemSpacing;
+	if( itemCount > 0u )
+	{
+		imuiWidgetSetFixedHeight( list->listLayout, (totalItemSize * itemCount) - s_theme.list.itemSpacing );
+	}
+
+	const ImuiRect listRect		= imuiWidgetGetRect( list->list );
+	const ImuiRect layoutRect	= imuiWidgetGetRect( list->listLayout );
+	const float scaledItemSize	= totalItemSize * imuiWidgetGetWindow( list->list )->surface->dpiScale;
+
+	list->itemCount		= itemCount;
+	list->beginIndex	= (uintsize)((listRect.pos.y - layoutRect.pos.y) / scaledItemSize);
+	list->endIndex		= list->beginIndex + (uintsize)ceilf( (listRect.size.height + scaledItemSize) / scaledItemSize );
+	list->endIndex		= IMUI_MIN( list->endIndex, itemCount );
+
+	list->item			= NULL;
+	list->itemIndex		= list->beginIndex - 1u;
+}
+
+ImuiWidget* imuiToolboxListBegin( ImuiToolboxListContext* list, ImuiWindow* window, float itemSize, size_t itemCount, bool selection )
+{
+	IMUI_ASSERT( list );
+
+	imuiToolboxListBeginInternal( list, window, itemSize, selection );
+	imuiToolboxListSetItemCountInternal( list, itemCount );
+	imuiToolboxListUpdateInputInternal( list );
+
+	return list->list;
+}
+
+static void imuiToolboxListBeginInternal( ImuiToolboxListContext* list, ImuiWindow* window, float itemSize, bool selection )
+{
+	imuiToolboxScrollAreaBegin( &list->scrollArea, window );
+	list->list = list->scrollArea.area;
+
+	imuiToolboxScrollAreaEnableSpacing( &list->scrollArea, true, false );
+
+	list->listLayout = imuiWidgetBegin( window );
+	imuiWidgetSetHStretch( list->listLayout, 1.0f );
+	imuiWidgetSetLayoutVerticalSpacing( list->listLayout, s_theme.list.itemSpacing );
+
+	bool isNew;
+	list->state = (ImuiToolboxListState*)imuiWidgetAllocStateNew( list->listLayout, sizeof( ImuiToolboxListState ), IMUI_ID_STR( "list" ), &isNew );
+	if( isNew || !selection )
+	{
+		list->state->selectedIndex = (uintsize)-1;
+	}
+
+	list->itemSize		= itemSize;
+	list->selection		= selection;
+	list->changed		= false;
+}
+
+static void imuiToolboxListUpdateInputInternal( ImuiToolboxListContext* list )
+{
+	const uintsize itemCount = list->itemCount;
+
+	ImuiWidgetInputState inputState;
+	imuiWidgetGetInputState( list->list, &inputState );
+
+	const ImuiInputState* input = imuiWidgetGetInput( list->list );
+	if( imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left ) )
+	{
+		list->state->hasFocus = inputState.hasMousePressed;
+	}
+
+	if( list->state->hasFocus )
+	{
+		if( imuiInputHasKeyPressed( input, ImuiInputKey_Up ) )
+		{
+			list->state->selectedIndex--;
+			if( list->state->selectedIndex >= itemCount )
+			{
+				list->state->selectedIndex = 0;
+			}
+			list->changed = true;
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_Down ) )
+		{
+			list->state->selectedIndex++;
+			if( list->state->selectedIndex >= itemCount )
+			{
+				list->state->selectedIndex = itemCount - 1;
+			}
+			list->changed = true;
+		}
+	}
+}
+
+size_t imuiToolboxListGetBeginIndex( const ImuiToolboxListContext* list )
+{
+	return list->beginIndex;
+}
+
+size_t imuiToolboxListGetEndIndex( const ImuiToolboxListContext* list )
+{
+	return list->endIndex;
+}
+
+size_t imuiToolboxListGetSelectedIndex( const ImuiToolboxListContext* list )
+{
+	return list->state->selectedIndex;
+}
+
+void imuiToolboxListSetSelectedIndex( ImuiToolboxListContext* list, size_t index )
+{
+	if( !list->selection )
+	{
+		return;
+	}
+
+	list->state->selectedIndex = index;
+}
+
+static void imuiToolboxListItemEndInternal( ImuiToolboxListContext* list )
+{
+	ImuiWidget* item = imuiWidgetGetLastChild( list->listLayout );
+	if( item )
+	{
+		imuiWidgetEnd( item );
+		list->item = NULL;
+	}
+}
+
+ImuiWidget* imuiToolboxListNextItem( ImuiToolboxListContext* list )
+{
+	return imuiToolboxListNextItemId( list, IMUI_ID_DEFAULT );
+}
+
+ImuiWidget* imuiToolboxListNextItemId( ImuiToolboxListContext* list, ImuiId id )
+{
+	imuiToolboxListItemEndInternal( list );
+
+	list->itemIndex++;
+
+	ImuiWidget* item = imuiWidgetBeginId( imuiWidgetGetWindow( list->list ), id );
+	imuiWidgetSetHStretch( item, 1.0f );
+	imuiWidgetSetFixedHeight( item, list->itemSize );
+
+	if( list->beginIndex > 0 &&
+		list->itemIndex == list->beginIndex )
+	{
+		const float totalItemSize = list->itemSize + s_theme.list.itemSpacing;
+		imuiWidgetSetMargin( item, imuiBorderCreate( totalItemSize * list->beginIndex, 0.0f, 0.0f, 0.0f ) );
+	}
+
+	if( list->selection )
+	{
+		imuiWidgetSetCanHaveFocus( item );
+
+		ImuiWidgetInputState inputState;
+		imuiWidgetGetInputState( item, &inputState );
+
+		const ImuiSkinDescriptor* skin = imuiToolboxGetSkinDescriptor( list->itemIndex == list->state->selectedIndex ? ImuiToolboxSkin_ItemSelected : ImuiToolboxSkin_ListItem );
+		if( inputState.isMouseDown )
+		{
+			imuiWidgetDrawSkinDescriptor( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemClicked ] );
+		}
+		else if( inputState.isMouseOver || inputState.hasFocus )
+		{
+			imuiWidgetDrawSkinDescriptor( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemHover ] );
+		}
+		else if( list->itemIndex == list->state->selectedIndex )
+		{
+			imuiWidgetDrawSkinDescriptor( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemSelected ] );
+		}
+
+		if( inputState.hasMouseReleased )
+		{
+			list->state->selectedIndex = list->itemIndex;
+			list->changed = true;
+		}
+	}
+
+	return item;
+}
+
+bool imuiToolboxListEnd( ImuiToolboxListContext* list )
+{
+	imuiToolboxListItemEndInternal( list );
+
+	imuiWidgetEnd( list->listLayout );
+	imuiToolboxScrollAreaEnd( &list->scrollArea );
+
+	return list->changed;
+}
+
+static void imuiToolboxFilterListStateDestruct( void* stateData )
+{
+	ImuiToolboxFilterListState* state = (ImuiToolboxFilterListState*)stateData;
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->filter, state->filterCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->levels, state->levelCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->matches, state->matchesCapacity );
+}
+
+static bool imuiToolboxFilterListContains( const char* text, const char* filter, uintsize filterLength )
+{
+	const char first = filter[ 0u ];
+	for( ; *text; ++text )
+	{
+		if( imuiToolboxToLower( *text ) != first )
+		{
+			continue;
+		}
+
+		uintsize i = 1u;
+		while( i < filterLength && text[ i ] && imuiToolboxToLower( text[ i ] ) == filter[ i ] )
+		{
+			i++;
+		}
+
+		if( i == filterLength )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool imuiToolboxFilterListPushLevel( ImuiToolboxFilterListState* state, char c )
+{
+	const ImuiToolboxFilterListLevel parent = state->levels[ state->levelCount - 1u ];
+
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->filter, state->filterCapacity, state->levelCount ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->levels, state->levelCapacity, state->levelCount + 1u ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->matches, state->matchesCapacity, state->matchesLength + parent.count ) )
+	{
+		return false;
+	}
+
+	state->filter[ state->levelCount - 1u ] = imuiToolboxToLower( c );
+
+	const char* filter				= state->filter;
+	const uintsize filterLength		= state->levelCount;
+	const uint8* itemsBytes			= (const uint8*)state->items;
+
+	ImuiToolboxFilterListLevel level;
+	level.offset	= state->matchesLength;
+	level.count		= 0u;
+
+	// only the parent matches can still match a longer filter
+	for( uintsize i = 0u; i < parent.count; ++i )
+	{
+		const uintsize itemIndex = parent.offset == (uintsize)-1 ? i : state->matches[ parent.offset + i ];
+		const char* itemText = *(const char**)(itemsBytes + (itemIndex * state->itemStride));
+		if( imuiToolboxFilterListContains( itemText, filter, filterLength ) )
+		{
+			state->matches[ level.offset + level.count++ ] = itemIndex;
+		}
+	}
+
+	if( level.count == parent.count )
+	{
+		// same set, share the parent matches
+		level = parent;
+	}
+	else
+	{
+		state->matchesLength += level.count;
+	}
+
+	state->levels[ state->levelCount++ ] = level;
+	return true;
+}
+
+static void imuiToolboxFilterListUpdate( ImuiToolboxFilterListState* state, const char* filter )
+{
+	uintsize keepCount = 0u;
+	while( keepCount + 1u < state->levelCount &&
+		filter[ keepCount ] &&
+		imuiToolboxToLower( filter[ keepCount ] ) == state->filter[ keepCount ] )
+	{
+		keepCount++;
+	}
+
+	// deleting characters goes back to the cached parent level
+	state->levelCount		= keepCount + 1u;
+	state->matchesLength	= 0u;
+	for( uintsize i = 1u; i < state->levelCount; ++i )
+	{
+		const ImuiToolboxFilterListLevel* level = &state->levels[ i ];
+		if( level->offset != (uintsize)-1 )
+		{
+			state->matchesLength = IMUI_MAX( state->matchesLength, level->offset + level->count );
+		}
+	}
+
+	for( const char* c = filter + keepCount; *c; ++c )
+	{
+		if( !imuiToolboxFilterListPushLevel( state, *c ) )
+		{
+			break;
+		}
+	}
+}
+
+static uintsize imuiToolboxFilterListFindMatch( const ImuiToolboxFilterListState* state, uintsize itemIndex )
+{
+	const ImuiToolboxFilterListLevel level = state->levels[ state->levelCount - 1u ];
+	if( level.offset == (uintsize)-1 )
+	{
+		return itemIndex < level.count ? itemIndex : (uintsize)-1;
+	}
+
+	// matches keep the item order, so they are sorted
+	const uintsize* matches = state->matches + level.offset;
+	uintsize begin	= 0u;
+	uintsize end	= level.count;
+	while( begin < end )
+	{
+		const uintsize middle = begin + ((end - begin) / 2u);
+		if( matches[ middle ] < itemIndex )
+		{
+			begin = middle + 1u;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+
+	return begin < level.count && matches[ begin ] == itemIndex ? begin : (uintsize)-1;
+}
+
+ImuiWidget* imuiToolboxFilterListBegin( ImuiToolboxFilterListContext* filterList, ImuiWindow* window, float itemSize, const char** items, size_t itemCount, size_t itemStride, uint64_t itemsVersion, const char* filter, bool selection )
+{
+	IMUI_ASSERT( filterList );
+
+	if( itemStride == 0u )
+	{
+		itemStride = sizeof( const char* );
+	}
+
+	ImuiToolboxListContext* list = &filterList->list;
+	imuiToolboxListBeginInternal( list, window, itemSize, selection );
+
+	bool isNew;
+	ImuiToolboxFilterListState* state = (ImuiToolboxFilterListState*)imuiWidgetAllocStateNewDestruct( list->list, sizeof( *state ), IMUI_ID_STR( "filter list" ), &isNew, imuiToolboxFilterListStateDestruct );
+	filterList->state = state;
+	if( isNew )
+	{
+		state->allocator		= &window->context->allocator;
+		state->selectedIndex	= (uintsize)-1;
+	}
+
+	if( isNew ||
+		state->items != items ||
+		state->itemCount != itemCount ||
+		state->itemStride != itemStride ||
+		state->itemsVersion != itemsVersion )
+	{
+		state->items		= items;
+		state->itemCount	= itemCount;
+		state->itemStride	= itemStride;
+		state->itemsVersion	= itemsVersion;
+		state->levelCount	= 0u;
+
+		if( IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->levels, state->levelCapacity, 1u ) )
+		{
+			state->levels[ 0u ].offset	= (uintsize)-1;
+			state->levels[ 0u ].count	= itemCount;
+			state->levelCount			= 1u;
+		}
+	}
+
+	if( state->levelCount == 0u )
+	{
+		imuiToolboxListSetItemCountInternal( list, 0u );
+		return list->list;
+	}
+
+	const uintsize lastMatchCount = state->levels[ state->levelCount - 1u ].count;
+	imuiToolboxFilterListUpdate( state, filter ? filter : "" );
+
+	const uintsize matchCount = state->levels[ state->levelCount - 1u ].count;
+	if( matchCount != lastMatchCount )
+	{
+		imuiToolboxScrollAreaSetOffset( &list->scrollArea, 0.0f, 0.0f );
+	}
+
+	if( selection )
+	{
+		list->state->selectedIndex = imuiToolboxFilterListFindMatch( state, state->selectedIndex );
+	}
+
+	imuiToolboxListSetItemCountInternal( list, matchCount );
+	imuiToolboxListUpdateInputInternal( list );
+
+	return list->list;
+}
+
+size_t imuiToolboxFilterListGetMatchCount( const ImuiToolboxFilterListContext* filterList )
+{
+	return filterList->list.itemCount;
+}
+
+size_t imuiToolboxFilterListGetItemIndex( const ImuiToolboxFilterListContext* filterList, size_t matchIndex )
+{
+	const ImuiToolboxFilterListState* state = filterList->state;
+	if( matchIndex >= filterList->list.itemCount )
+	{
+		return (uintsize)-1;
+	}
+
+	const ImuiToolboxFilterListLevel level = state->levels[ state->levelCount - 1u ];
+	return level.offset == (uintsize)-1 ? matchIndex : state->matches[ level.offset + matchIndex ];
+}
+
+size_t imuiToolboxFilterListGetSelectedIndex( const ImuiToolboxFilterListContext* filterList )
+{
+	if( !filterList->list.selection )
+	{
+		return (uintsize)-1;
+	}
+
+	return imuiToolboxFilterListGetItemIndex( filterList, imuiToolboxListGetSelectedIndex( &filterList->list ) );
+}
+
+void imuiToolboxFilterListSetSelectedIndex( ImuiToolboxFilterListContext* filterList, size_t itemIndex )
+{
+	if( !filterList->list.selection )
+	{
+		return;
+	}
+
+	filterList->state->selectedIndex = itemIndex;
+	if( filterList->state->levelCount == 0u )
+	{
+		return;
+	}
+
+	imuiToolboxListSetSelectedIndex( &filterList->list, imuiToolboxFilterListFindMatch( filterList->state, itemIndex ) );
+}
+
+bool imuiToolboxFilterListEnd( ImuiToolboxFilterListContext* filterList )
+{
+	ImuiToolboxFilterListState* state = filterList->state;
+
+	// a selection hidden by the filter is kept for when it matches again
+	const uintsize selectedIndex = imuiToolboxFilterListGetSelectedIndex( filterList );
+	if( selectedIndex != (uintsize)-1 || filterList->list.changed )
+	{
+		state->selectedIndex = selectedIndex;
+	}
+
+	return imuiToolboxListEnd( &filterList->list );
+}
+
+static void imuiToolboxTreeViewStateDestruct( void* stateData )
+{
+	ImuiToolboxTreeViewState* state = (ImuiToolboxTreeViewState*)stateData;
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->rows, state->rowCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->expandedIds, state->expandedCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->insertRows, state->insertRowCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->stack, state->stackCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->toggles, state->toggleCapacity );
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->rowMap, state->rowMapCapacity );
+}
+
+static bool imuiToolboxTreeViewFindExpanded( const ImuiToolboxTreeViewState* state, uint64 nodeId, uintsize* index )
+{
+	uintsize begin	= 0u;
+	uintsize end	= state->expandedCount;
+	while( begin < end )
+	{
+		const uintsize middle = begin + ((end - begin) / 2u);
+		if( state->expandedIds[ middle ] < nodeId )
+		{
+			begin = middle + 1u;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+
+	*index = begin;
+	return begin < state->expandedCount && state->expandedIds[ begin ] == nodeId;
+}
+
+static bool imuiToolboxTreeViewSetExpandedInternal( ImuiToolboxTreeViewState* state, uint64 nodeId, bool expanded )
+{
+	uintsize index;
+	const bool isExpanded = imuiToolboxTreeViewFindExpanded( state, nodeId, &index );
+	if( isExpanded == expanded )
+	{
+		return true;
+	}
+
+	if( expanded )
+	{
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->expandedIds, state->expandedCapacity, state->expandedCount + 1u ) )
+		{
+			return false;
+		}
+
+		memmove( state->expandedIds + index + 1u, state->expandedIds + index, sizeof( *state->expandedIds ) * (state->expandedCount - index) );
+		state->expandedIds[ index ] = nodeId;
+		state->expandedCount++;
+	}
+	else
+	{
+		memmove( state->expandedIds + index, state->expandedIds + index + 1u, sizeof( *state->expandedIds ) * (state->expandedCount - index - 1u) );
+		state->expandedCount--;
+	}
+
+	return true;
+}
+
+// writes the visible descendants of a node to insertRows in display order
+static bool imuiToolboxTreeViewCollectRows( ImuiToolboxTreeViewState* state, const ImuiToolboxTreeViewSource* source, uint64 nodeId, uint32 depth, uintsize* rowCount )
+{
+	*rowCount = 0u;
+
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->stack, state->stackCapacity, 1u ) )
+	{
+		return false;
+	}
+
+	state->stack[ 0u ].nodeId		= nodeId;
+	state->stack[ 0u ].childIndex	= 0u;
+	state->stack[ 0u ].childCount	= source->getChildCount( source->userData, nodeId );
+	state->stack[ 0u ].depth		= depth;
+	uintsize stackCount = 1u;
+
+	while( stackCount > 0u )
+	{
+		ImuiToolboxTreeViewStackEntry* entry = &state->stack[ stackCount - 1u ];
+		if( entry->childIndex == entry->childCount )
+		{
+			stackCount--;
+			continue;
+		}
+
+		const uint32 childDepth	= entry->depth;
+		const uint64 childId	= source->getChild( source->userData, entry->nodeId, entry->childIndex++ );
+		const uintsize childChildCount = source->getChildCount( source->userData, childId );
+
+		uintsize expandedIndex;
+		const bool isExpanded = childChildCount > 0u && imuiToolboxTreeViewFindExpanded( state, childId, &expandedIndex );
+
+		if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->insertRows, state->insertRowCapacity, *rowCount + 1u ) )
+		{
+			return false;
+		}
+
+		ImuiToolboxTreeViewRow* row = &state->insertRows[ (*rowCount)++ ];
+		row->nodeId		= childId;
+		row->childCount	= childChildCount;
+		row->depth		= childDepth;
+		row->isExpanded	= isExpanded;
+
+		if( isExpanded )
+		{
+			if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->stack, state->stackCapacity, stackCount + 1u ) )
+			{
+				return false;
+			}
+
+			ImuiToolboxTreeViewStackEntry* childEntry = &state->stack[ stackCount++ ];
+			childEntry->nodeId		= childId;
+			childEntry->childIndex	= 0u;
+			childEntry->childCount	= childChildCount;
+			childEntry->depth		= childDepth + 1u;
+		}
+	}
+
+	return true;
+}
+
+static uintsize imuiToolboxTreeViewFindRowInRange( const ImuiToolboxTreeViewState* state, uint64 nodeId, uintsize beginRow, uintsize endRow )
+{
+	for( uintsize i = beginRow; i < endRow; ++i )
+	{
+		if( state->rows[ i ].nodeId == nodeId )
+		{
+			return i;
+		}
+	}
+
+	return (uintsize)-1;
+}
+
+static ImuiToolboxTreeViewRowMapEntry* imuiToolboxTreeViewRowMapFindSlot( const ImuiToolboxTreeViewState* state, uint64 nodeId )
+{
+	const uintsize indexMask = state->rowMapCapacity - 1u;
+	for( uintsize index = imuiHashCreate( &nodeId, sizeof( nodeId ) ) & indexMask; ; index = (index + 1u) & indexMask )
+	{
+		ImuiToolboxTreeViewRowMapEntry* entry = &state->rowMap[ index ];
+		if( entry->rowNumber == 0u || entry->nodeId == nodeId )
+		{
+			return entry;
+		}
+	}
+}
+
+static bool imuiToolboxTreeViewRowMapSet( ImuiToolboxTreeViewState* state, uint64 nodeId, uintsize rowIndex )
+{
+	if( (state->rowMapCount + 1u) * 2u > state->rowMapCapacity )
+	{
+		ImuiToolboxTreeViewRowMapEntry* oldEntries = state->rowMap;
+		const uintsize oldCapacity = state->rowMapCapacity;
+
+		const uintsize newCapacity = IMUI_MAX( oldCapacity * 2u, 64u );
+		ImuiToolboxTreeViewRowMapEntry* newEntries = IMUI_MEMORY_ARRAY_NEW_ZERO( state->allocator, ImuiToolboxTreeViewRowMapEntry, newCapacity );
+		if( !newEntries )
+		{
+			return false;
+		}
+
+		state->rowMap			= newEntries;
+		state->rowMapCapacity	= newCapacity;
+		for( uintsize i = 0u; i < oldCapacity; ++i )
+		{
+			if( oldEntries[ i ].rowNumber != 0u )
+			{
+				*imuiToolboxTreeViewRowMapFindSlot( state, oldEntries[ i ].nodeId ) = oldEntries[ i ];
+			}
+		}
+
+		imuiMemoryFree( state->allocator, oldEntries );
+	}
+
+	ImuiToolboxTreeViewRowMapEntry* entry = imuiToolboxTreeViewRowMapFindSlot( state, nodeId );
+	if( entry->rowNumber == 0u )
+	{
+		state->rowMapCount++;
+	}
+
+	entry->nodeId		= nodeId;
+	entry->rowNumber	= rowIndex + 1u;
+	entry->shiftIndex	= state->rowShiftCount;
+	return true;
+}
+
+static void imuiToolboxTreeViewRowMapRemove( ImuiToolboxTreeViewState* state, uint64 nodeId )
+{
+	ImuiToolboxTreeViewRowMapEntry* entry = imuiToolboxTreeViewRowMapFindSlot( state, nodeId );
+	if( entry->rowNumber == 0u )
+	{
+		return;
+	}
+
+	// shift following entries back to keep probe sequences without holes
+	const uintsize indexMask = state->rowMapCapacity - 1u;
+	uintsize holeIndex = (uintsize)(entry - state->rowMap);
+	for( uintsize index = (holeIndex + 1u) & indexMask; state->rowMap[ index ].rowNumber != 0u; index = (index + 1u) & indexMask )
+	{
+		const uintsize homeIndex = imuiHashCreate( &state->rowMap[ index ].nodeId, sizeof( nodeId ) ) & indexMask;
+		if( ((index - homeIndex) & indexMask) >= ((index - holeIndex) & indexMask) )
+		{
+			state->rowMap[ holeIndex ] = state->rowMap[ index ];
+			holeIndex = index;
+		}
+	}
+
+	state->rowMap[ holeIndex ].rowNumber = 0u;
+	state->rowMapCount--;
+}
+
+static void imuiToolboxTreeViewRowMapClear( ImuiToolboxTreeViewState* state )
+{
+	if( state->rowMapCount > 0u )
+	{
+		memset( state->rowMap, 0, sizeof( *state->rowMap ) * state->rowMapCapacity );
+	}
+
+	state->hasRowMap		= false;
+	state->rowMapCount		= 0u;
+	state->rowShiftCount	= 0u;
+}
+
+// rows from rowIndex on moved by offset. returns false when the map has to be rebuilt on the next lookup
+static bool imuiToolboxTreeViewRowMapPushShift( ImuiToolboxTreeViewState* state, uintsize rowIndex, sintsize offset )
+{
+	if( !state->hasRowMap )
+	{
+		return false;
+	}
+	else if( state->rowShiftCount == IMUI_ARRAY_COUNT( state->rowShifts ) )
+	{
+		imuiToolboxTreeViewRowMapClear( state );
+		return false;
+	}
+
+	ImuiToolboxTreeViewRowShift* shift = &state->rowShifts[ state->rowShiftCount++ ];
+	shift->rowIndex	= rowIndex;
+	shift->offset	= offset;
+	return true;
+}
+
+static uintsize imuiToolboxTreeViewFindRow( ImuiToolboxTreeViewState* state, uint64 nodeId )
+{
+	if( !state->hasRowMap )
+	{
+		imuiToolboxTreeViewRowMapClear( state );
+		for( uintsize i = 0u; i < state->rowCount; ++i )
+		{
+			if( !imuiToolboxTreeViewRowMapSet( state, state->rows[ i ].nodeId, i ) )
+			{
+				imuiToolboxTreeViewRowMapClear( state );
+				return imuiToolboxTreeViewFindRowInRange( state, nodeId, 0u, state->rowCount );
+			}
+		}
+
+		state->hasRowMap = true;
+	}
+
+	if( state->rowMapCount == 0u )
+	{
+		return (uintsize)-1;
+	}
+
+	ImuiToolboxTreeViewRowMapEntry* entry = imuiToolboxTreeViewRowMapFindSlot( state, nodeId );
+	if( entry->rowNumber == 0u )
+	{
+		return (uintsize)-1;
+	}
+
+	uintsize rowIndex = entry->rowNumber - 1u;
+	for( uintsize i = entry->shiftIndex; i < state->rowShiftCount; ++i )
+	{
+		const ImuiToolboxTreeViewRowShift* shift = &state->rowShifts[ i ];
+		if( rowIndex >= shift->rowIndex )
+		{
+			rowIndex = (uintsize)((sintsize)rowIndex + shift->offset);
+		}
+	}
+
+	entry->rowNumber	= rowIndex + 1u;
+	entry->shiftIndex	= state->rowShiftCount;
+
+	IMUI_ASSERT( rowIndex < state->rowCount && state->rows[ rowIndex ].nodeId == nodeId );
+	return rowIndex;
+}
+
+static bool imuiToolboxTreeViewRebuildRows( ImuiToolboxTreeViewState* state, const ImuiToolboxTreeViewSource* source )
+{
+	uintsize rowCount;
+	if( !imuiToolboxTreeViewCollectRows( state, source, source->rootId, 0u, &rowCount ) )
+	{
+		return false;
+	}
+
+	ImuiToolboxTreeViewRow* rows	= state->rows;
+	const uintsize rowCapacity		= state->rowCapacity;
+	state->rows						= state->insertRows;
+	state->rowCount					= rowCount;
+	state->rowCapacity				= state->insertRowCapacity;
+	state->insertRows				= rows;
+	state->insertRowCapacity		= rowCapacity;
+
+	imuiToolboxTreeViewRowMapClear( state );
+
+	state->selectedRow = state->hasSelection ? imuiToolboxTreeViewFindRowInRange( state, state->selectedNodeId, 0u, rowCount ) : (uintsize)-1;
+	return true;
+}
+
+static void imuiToolboxTreeViewExpandRow( ImuiToolboxTreeViewState* state, const ImuiToolboxTreeViewSource* source, uintsize rowIndex )
+{
+	ImuiToolboxTreeViewRow* row = &state->rows[ rowIndex ];
+
+	uintsize insertCount;
+	if( !imuiToolboxTreeViewCollectRows( state, source, row->nodeId, row->depth + 1u, &insertCount ) ||
+		!IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->rows, state->rowCapacity, state->rowCount + insertCount ) )
+	{
+		imuiToolboxTreeViewSetExpandedInternal( state, state->rows[ rowIndex ].nodeId, false );
+		return;
+	}
+
+	const uintsize insertIndex = rowIndex + 1u;
+	memmove( state->rows + insertIndex + insertCount, state->rows + insertIndex, sizeof( *state->rows ) * (state->rowCount - insertIndex) );
+	memcpy( state->rows + insertIndex, state->insertRows, sizeof( *state->rows ) * insertCount );
+	state->rows[ rowIndex ].isExpanded = true;
+	state->rowCount += insertCount;
+
+	if( imuiToolboxTreeViewRowMapPushShift( state, insertIndex, (sintsize)insertCount ) )
+	{
+		for( uintsize i = insertIndex; i < insertIndex + insertCount; ++i )
+		{
+			if( !imuiToolboxTreeViewRowMapSet( state, state->rows[ i ].nodeId, i ) )
+			{
+				imuiToolboxTreeViewRowMapClear( state );
+				break;
+			}
+		}
+	}
+
+	if( !state->hasSelection )
+	{
+		return;
+	}
+
+	if( state->selectedRow != (uintsize)-1 && state->selectedRow > rowIndex )
+	{
+		state->selectedRow += insertCount;
+	}
+	else if( state->selectedRow == (uintsize)-1 )
+	{
+		state->selectedRow = imuiToolboxTreeViewFindRowInRange( state, state->selectedNodeId, insertIndex, insertIndex + insertCount );
+	}
+}
+
+static void imuiToolboxTreeViewCollapseRow( ImuiToolboxTreeViewState* state, uintsize rowIndex )
+{
+	const uint32 depth = state->rows[ rowIndex ].depth;
+
+	uintsize endIndex = rowIndex + 1u;
+	while( endIndex < state->rowCount && state->rows[ endIndex ].depth > depth )
+	{
+		endIndex++;
+	}
+
+	const uintsize removeCount = endIndex - (rowIndex + 1u);
+	if( imuiToolboxTreeViewRowMapPushShift( state, endIndex, -(sintsize)removeCount ) )
 	{
-		float barHeight = frameRect.size.height - (hasHorizontalBar ? dpiBarSize : 0.0f);
-		barHeight = IMUI_MAX( 0.0f, barHeight );
+		for( uintsize i = rowIndex + 1u; i < endIndex; ++i )
+		{
+			imuiToolboxTreeViewRowMapRemove( state, state->rows[ i ].nodeId );
+		}
+	}
 
-		ImuiWidget* scrollBar = imuiWidgetBegin( window );
-		imuiWidgetSetHAlign( scrollBar, 1.0f );
-		imuiWidgetSetFixedWidth( scrollBar, s_theme.scrollArea.barSize );
-		imuiWidgetSetVStretch( scrollBar, frameRect.size.height > 0.0f ? barHeight / frameRect.size.height : 1.0f );
+	memmove( state->rows + rowIndex + 1u, state->rows + endIndex, sizeof( *state->rows ) * (state->rowCount - endIndex) );
+	state->rows[ rowIndex ].isExpanded = false;
+	state->rowCount -= removeCount;
 
-		const ImuiRect barRect		= imuiWidgetGetRect( scrollBar );
-		const float pivotSizeFactor	= frameAreaSize.height / areaSize.height;
-		const float pivotSize		= barHeight * pivotSizeFactor;
-		const float pivotSizeFinal	= IMUI_MAX( pivotSize, dpiBarMinSize );
-		const float pivotOffset		= (state->offset.y / areaSize.height) * (barHeight - (pivotSizeFinal - pivotSize));
+	if( state->selectedRow == (uintsize)-1 || state->selectedRow <= rowIndex )
+	{
+		return;
+	}
 
-		const ImuiRect barPivotRect = imuiRectCreate(
-			0.0f,
-			pivotOffset,
-			dpiBarSize,
-			pivotSizeFinal
-		);
+	// selection inside the collapsed rows stays hidden until they get visible again
+	state->selectedRow = state->selectedRow < endIndex ? (uintsize)-1 : state->selectedRow - removeCount;
+}
 
-		ImuiWidgetInputState inputState;
-		imuiWidgetGetInputState( scrollBar, &inputState );
+static void imuiToolboxTreeViewApplyToggles( ImuiToolboxTreeViewState* state, const ImuiToolboxTreeViewSource* source )
+{
+	for( uintsize i = 0u; i < state->toggleCount; ++i )
+	{
+		const ImuiToolboxTreeViewToggle* toggle = &state->toggles[ i ];
+		if( !imuiToolboxTreeViewSetExpandedInternal( state, toggle->nodeId, toggle->expanded ) )
+		{
+			continue;
+		}
 
-		if( inputState.wasPressed )
+		uintsize rowIndex = toggle->rowIndex;
+		if( rowIndex >= state->rowCount || state->rows[ rowIndex ].nodeId != toggle->nodeId )
 		{
-			if( !state->wasPressedY &&
-				imuiRectIncludesPos( barPivotRect, inputState.relativeMousePos ) )
-			{
-				state->pressPoint.y	= inputState.relativeMousePos.y;
-				state->pressPoint.y	-= pivotOffset;
-				state->wasPressedY	= true;
-			}
+			rowIndex = imuiToolboxTreeViewFindRow( state, toggle->nodeId );
+		}
 
-			if( state->wasPressedY )
-			{
-				const float newBarOffset	= inputState.relativeMousePos.y - state->pressPoint.y;
-				const float newOffset		= (newBarOffset / barRect.size.height) * areaSize.height;
+		if( rowIndex == (uintsize)-1 )
+		{
+			continue;
+		}
 
-				state->offset.y = newOffset;
-			}
+		const ImuiToolboxTreeViewRow* row = &state->rows[ rowIndex ];
+		if( toggle->expanded && !row->isExpanded && row->childCount > 0u )
+		{
+			imuiToolboxTreeViewExpandRow( state, source, rowIndex );
 		}
-		else
+		else if( !toggle->expanded && row->isExpanded )
 		{
-			state->wasPressedY = false;
+			imuiToolboxTreeViewCollapseRow( state, rowIndex );
 		}
-
-		imuiWidgetDrawSkin( scrollBar, &s_theme.skins[ ImuiToolboxSkin_ScrollAreaBarBackground ], s_theme.colors[ ImuiToolboxColor_ScrollAreaBarBackground ] );
-		imuiWidgetDrawPartialSkin( scrollBar, barPivotRect, &s_theme.skins[ ImuiToolboxSkin_ScrollAreaBarPivot ], s_theme.colors[ ImuiToolboxColor_ScrollAreaBarPivot ] );
-
-		imuiWidgetEnd( scrollBar );
 	}
 
-	if( areaInputState.isMouseOver )
+	state->toggleCount = 0u;
+}
+
+static void imuiToolboxTreeViewPushToggle( ImuiToolboxTreeViewState* state, uint64 nodeId, uintsize rowIndex, bool expanded )
+{
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->toggles, state->toggleCapacity, state->toggleCount + 1u ) )
 	{
-		state->offset = imuiPosSubPos( state->offset, imuiPosScale( imuiInputGetMouseScrollDelta( imuiWindowGetInput( window ) ), 80.0f ) );
+		return;
 	}
 
-	state->offset = imuiPosMax( imuiPosCreateZero(), imuiPosMin( state->offset, imuiSizeToPos( imuiSizeSubSize( areaSize, frameAreaSize ) ) ) );
-
-	imuiWidgetEnd( scrollArea->area );
+	ImuiToolboxTreeViewToggle* toggle = &state->toggles[ state->toggleCount++ ];
+	toggle->nodeId		= nodeId;
+	toggle->rowIndex	= rowIndex;
+	toggle->expanded	= expanded;
 }
 
-ImuiWidget* imuiToolboxListBegin( ImuiToolboxListContext* list, ImuiWindow* window, float itemSize, size_t itemCount, bool selection )
+ImuiWidget* imuiToolboxTreeViewBegin( ImuiToolboxTreeViewContext* treeView, ImuiWindow* window, float itemSize, const ImuiToolboxTreeViewSource* source, bool selection )
 {
-	IMUI_ASSERT( list );
+	IMUI_ASSERT( treeView );
+	IMUI_ASSERT( source );
 
-	const float totalItemSize = itemSize + s_theme.list.itemSpacing;
+	ImuiToolboxListContext* list = &treeView->list;
+	imuiToolboxListBeginInternal( list, window, itemSize, selection );
 
-	imuiToolboxScrollAreaBegin( &list->scrollArea, window );
-	list->list = list->scrollArea.area;
+	bool isNew;
+	ImuiToolboxTreeViewState* state = (ImuiToolboxTreeViewState*)imuiWidgetAllocStateNewDestruct( list->list, sizeof( *state ), IMUI_ID_STR( "tree view" ), &isNew, imuiToolboxTreeViewStateDestruct );
+	treeView->state		= state;
+	treeView->source	= source;
+	if( isNew )
+	{
+		state->allocator	= &window->context->allocator;
+		state->selectedRow	= (uintsize)-1;
+	}
 
-	imuiToolboxScrollAreaEnableSpacing( &list->scrollArea, true, false );
+	if( !state->hasRows ||
+		state->userData != source->userData ||
+		state->rootId != source->rootId ||
+		state->version != source->version )
+	{
+		state->userData	= source->userData;
+		state->rootId	= source->rootId;
+		state->version	= source->version;
+		state->hasRows	= imuiToolboxTreeViewRebuildRows( state, source );
+	}
 
-	list->listLayout = imuiWidgetBegin( window );
-	imuiWidgetSetHStretch( list->listLayout, 1.0f );
-	imuiWidgetSetLayoutVerticalSpacing( list->listLayout, s_theme.list.itemSpacing );
-	if( itemCount > 0u )
+	if( selection )
 	{
-		imuiWidgetSetFixedHeight( list->listLayout, (totalItemSize * itemCount) - s_theme.list.itemSpacing );
+		list->state->selectedIndex = state->hasSelection ? state->selectedRow : (uintsize)-1;
 	}
 
-	bool isNew;
-	list->state = (ImuiToolboxListState*)imuiWidgetAllocStateNew( list->listLayout, sizeof( ImuiToolboxListState ), IMUI_ID_STR( "list" ), &isNew );
-	if( isNew || !selection )
+	imuiToolboxListSetItemCountInternal( list, state->rowCount );
+	imuiToolboxListUpdateInputInternal( list );
+
+	const uintsize selectedRow = list->state->selectedIndex;
+	if( list->state->hasFocus && selectedRow < state->rowCount )
 	{
-		list->state->selectedIndex = (uintsize)-1;
+		const ImuiInputState* input = imuiWidgetGetInput( list->list );
+		const ImuiToolboxTreeViewRow* row = &state->rows[ selectedRow ];
+		if( imuiInputHasKeyPressed( input, ImuiInputKey_Right ) && !row->isExpanded )
+		{
+			imuiToolboxTreeViewPushToggle( state, row->nodeId, selectedRow, true );
+		}
+		else if( imuiInputHasKeyPressed( input, ImuiInputKey_Left ) && row->isExpanded )
+		{
+			imuiToolboxTreeViewPushToggle( state, row->nodeId, selectedRow, false );
+		}
 	}
 
-	const ImuiRect listRect		= imuiWidgetGetRect( list->list );
-	const ImuiRect layoutRect	= imuiWidgetGetRect( list->listLayout );
-	const float scaledItemSize	= totalItemSize * window->surface->dpiScale;
+	return list->list;
+}
 
-	list->itemSize		= itemSize;
-	list->itemCount		= itemCount;
-	list->beginIndex	= (uintsize)((listRect.pos.y - layoutRect.pos.y) / scaledItemSize);
-	list->endIndex		= list->beginIndex + (uintsize)ceilf( (listRect.size.height + scaledItemSize) / scaledItemSize );
-	list->endIndex		= IMUI_MIN( list->endIndex, itemCount );
+size_t imuiToolboxTreeViewGetRowCount( const ImuiToolboxTreeViewContext* treeView )
+{
+	return treeView->state->rowCount;
+}
 
-	list->item			= NULL;
-	list->itemIndex		= list->beginIndex - 1u;
+uint64_t imuiToolboxTreeViewGetNodeId( const ImuiToolboxTreeViewContext* treeView, size_t rowIndex )
+{
+	IMUI_ASSERT( rowIndex < treeView->state->rowCount );
+	return treeView->state->rows[ rowIndex ].nodeId;
+}
 
-	list->selection		= selection;
-	list->changed		= false;
+ImuiWidget* imuiToolboxTreeViewNextItem( ImuiToolboxTreeViewContext* treeView )
+{
+	ImuiToolboxTreeViewState* state = treeView->state;
+	ImuiToolboxListContext* list = &treeView->list;
 
-	ImuiWidgetInputState inputState;
-	imuiWidgetGetInputState( list->list, &inputState );
+	ImuiWidget* item = imuiToolboxListNextItem( list );
+	imuiWidgetSetLayoutHorizontalSpacing( item, s_theme.treeView.expanderSpacing );
 
-	const ImuiInputState* input = imuiWidgetGetInput( list->list );
-	if( imuiInputHasMouseButtonPressed( input, ImuiInputMouseButton_Left ) )
+	const uintsize rowIndex = list->itemIndex;
+	if( rowIndex >= state->rowCount )
 	{
-		list->state->hasFocus = inputState.hasMousePressed;
+		return item;
 	}
 
-	if( list->state->hasFocus )
+	const ImuiToolboxTreeViewRow* row = &state->rows[ rowIndex ];
+	imuiWidgetSetPadding( item, imuiBorderCreate( 0.0f, s_theme.treeView.indent * (float)row->depth, 0.0f, 0.0f ) );
+
+	ImuiWindow* window = imuiWidgetGetWindow( item );
+	const ImuiImage iconImage = s_theme.icons[ row->isExpanded ? ImuiToolboxIcon_DropDownClose : ImuiToolboxIcon_DropDownOpen ];
+
+	ImuiWidget* expander = imuiWidgetBegin( window );
+	imuiWidgetSetFixedSize( expander, imuiSizeCreateImage( &iconImage ) );
+	imuiWidgetSetVAlign( expander, 0.5f );
+
+	if( row->childCount > 0u )
 	{
-		if( imuiInputHasKeyPressed( input, ImuiInputKey_Up ) )
-		{
-			list->state->selectedIndex--;
-			if( list->state->selectedIndex >= itemCount )
-			{
-				list->state->selectedIndex = 0;
-			}
-			list->changed = true;
-		}
-		else if( imuiInputHasKeyPressed( input, ImuiInputKey_Down ) )
+		imuiWidgetDrawImageColor( expander, &iconImage, s_theme.colors[ ImuiToolboxColor_Text ] );
+
+		ImuiWidgetInputState inputState;
+		imuiWidgetGetInputState( expander, &inputState );
+		if( inputState.hasMouseReleased )
 		{
-			list->state->selectedIndex++;
-			if( list->state->selectedIndex >= itemCount )
-			{
-				list->state->selectedIndex = itemCount - 1;
-			}
-			list->changed = true;
+			imuiToolboxTreeViewPushToggle( state, row->nodeId, rowIndex, !row->isExpanded );
 		}
 	}
 
-	return list->list;
+	imuiWidgetEnd( expander );
+
+	return item;
 }
 
-size_t imuiToolboxListGetBeginIndex( const ImuiToolboxListContext* list )
+bool imuiToolboxTreeViewIsExpanded( const ImuiToolboxTreeViewContext* treeView, uint64_t nodeId )
 {
-	return list->beginIndex;
+	uintsize index;
+	return imuiToolboxTreeViewFindExpanded( treeView->state, nodeId, &index );
 }
 
-size_t imuiToolboxListGetEndIndex( const ImuiToolboxListContext* list )
+void imuiToolboxTreeViewSetExpanded( ImuiToolboxTreeViewContext* treeView, uint64_t nodeId, bool expanded )
 {
-	return list->endIndex;
+	imuiToolboxTreeViewPushToggle( treeView->state, nodeId, (uintsize)-1, expanded );
 }
 
-size_t imuiToolboxListGetSelectedIndex( const ImuiToolboxListContext* list )
+bool imuiToolboxTreeViewGetSelectedNodeId( const ImuiToolboxTreeViewContext* treeView, uint64_t* nodeId )
 {
-	return list->state->selectedIndex;
+	const ImuiToolboxTreeViewState* state = treeView->state;
+	const uintsize selectedRow = imuiToolboxListGetSelectedIndex( &treeView->list );
+	if( treeView->list.selection && selectedRow < state->rowCount )
+	{
+		*nodeId = state->rows[ selectedRow ].nodeId;
+		return true;
+	}
+
+	*nodeId = state->selectedNodeId;
+	return state->hasSelection;
 }
 
-void imuiToolboxListSetSelectedIndex( ImuiToolboxListContext* list, size_t index )
+void imuiToolboxTreeViewSetSelectedNodeId( ImuiToolboxTreeViewContext* treeView, uint64_t nodeId )
 {
-	if( !list->selection )
+	if( !treeView->list.selection )
 	{
 		return;
 	}
 
-	list->state->selectedIndex = index;
+	ImuiToolboxTreeViewState* state = treeView->state;
+	state->hasSelection		= true;
+	state->selectedNodeId	= nodeId;
+	state->selectedRow		= imuiToolboxTreeViewFindRow( state, nodeId );
+
+	imuiToolboxListSetSelectedIndex( &treeView->list, state->selectedRow );
 }
 
-static void imuiToolboxListItemEndInternal( ImuiToolboxListContext* list )
+bool imuiToolboxTreeViewEnd( ImuiToolboxTreeViewContext* treeView )
 {
-	ImuiWidget* item = imuiWidgetGetLastChild( list->listLayout );
-	if( item )
+	ImuiToolboxTreeViewState* state = treeView->state;
+
+	const uintsize selectedRow = imuiToolboxListGetSelectedIndex( &treeView->list );
+	if( treeView->list.selection && selectedRow < state->rowCount )
 	{
-		imuiWidgetEnd( item );
-		list->item = NULL;
+		state->hasSelection		= true;
+		state->selectedNodeId	= state->rows[ selectedRow ].nodeId;
+		state->selectedRow		= selectedRow;
 	}
+
+	const bool changed = imuiToolboxListEnd( &treeView->list );
+
+	imuiToolboxTreeViewApplyToggles( state, treeView->source );
+
+	return changed;
 }
 
-ImuiWidget* imuiToolboxListNextItem( ImuiToolboxListContext* list )
+static void imuiToolboxDropDownStateDestruct( void* stateData )
 {
-	return imuiToolboxListNextItemId( list, IMUI_ID_DEFAULT );
+	ImuiToolboxDropDownState* state = (ImuiToolboxDropDownState*)stateData;
+	IMUI_MEMORY_ARRAY_FREE( state->allocator, state->searchItems, state->searchItemsCapacity );
 }
 
-ImuiWidget* imuiToolboxListNextItemId( ImuiToolboxListContext* list, ImuiId id )
+static int imuiToolboxDropDownCompareSearchText( const char* text, const char* search, uintsize searchLength )
 {
-	imuiToolboxListItemEndInternal( list );
+	for( uintsize i = 0u; i < searchLength; ++i )
+	{
+		const uint8 textChar	= (uint8)imuiToolboxToLower( text[ i ] );
+		const uint8 searchChar	= (uint8)imuiToolboxToLower( search[ i ] );
+		if( textChar != searchChar || textChar == 0u )
+		{
+			return (int)textChar - (int)searchChar;
+		}
+	}
 
-	list->itemIndex++;
+	return 0;
+}
 
-	ImuiWidget* item = imuiWidgetBeginId( imuiWidgetGetWindow( list->list ), id );
-	imuiWidgetSetHStretch( item, 1.0f );
-	imuiWidgetSetFixedHeight( item, list->itemSize );
+static int imuiToolboxDropDownCompareSearchItems( const void* lhs, const void* rhs )
+{
+	const ImuiToolboxDropDownSearchItem* lhsItem = (const ImuiToolboxDropDownSearchItem*)lhs;
+	const ImuiToolboxDropDownSearchItem* rhsItem = (const ImuiToolboxDropDownSearchItem*)rhs;
 
-	if( list->beginIndex > 0 &&
-		list->itemIndex == list->beginIndex )
+	const int result = imuiToolboxDropDownCompareSearchText( lhsItem->text, rhsItem->text, (uintsize)-1 );
+	if( result != 0 )
 	{
-		const float totalItemSize = list->itemSize + s_theme.list.itemSpacing;
-		imuiWidgetSetMargin( item, imuiBorderCreate( totalItemSize * list->beginIndex, 0.0f, 0.0f, 0.0f ) );
+		return result;
 	}
 
-	if( list->selection )
+	return lhsItem->index < rhsItem->index ? -1 : (lhsItem->index > rhsItem->index ? 1 : 0);
+}
+
+static bool imuiToolboxDropDownBuildSearchItems( ImuiToolboxDropDownState* state )
+{
+	if( !IMUI_MEMORY_ARRAY_CHECK_CAPACITY( state->allocator, state->searchItems, state->searchItemsCapacity, state->itemCount ) )
 	{
-		imuiWidgetSetCanHaveFocus( item );
+		return false;
+	}
 
-		ImuiWidgetInputState inputState;
-		imuiWidgetGetInputState( item, &inputState );
+	const uint8* itemsBytes = (const uint8*)state->items;
+	for( uintsize i = 0u; i < state->itemCount; ++i )
+	{
+		state->searchItems[ i ].text	= *(const char**)(itemsBytes + (i * state->itemStride));
+		state->searchItems[ i ].index	= i;
+	}
 
-		const ImuiSkin* skin = &s_theme.skins[ list->itemIndex == list->state->selectedIndex ? ImuiToolboxSkin_ItemSelected : ImuiToolboxSkin_ListItem ];
-		if( inputState.isMouseDown )
-		{
-			imuiWidgetDrawSkin( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemClicked ] );
-		}
-		else if( inputState.isMouseOver || inputState.hasFocus )
+	qsort( state->searchItems, state->itemCount, sizeof( *state->searchItems ), imuiToolboxDropDownCompareSearchItems );
+	state->hasSearchItems = true;
+	return true;
+}
+
+static uintsize imuiToolboxDropDownFindSearchItem( const ImuiToolboxDropDownState* state )
+{
+	uintsize begin	= 0u;
+	uintsize end	= state->itemCount;
+	while( begin < end )
+	{
+		const uintsize middle = begin + ((end - begin) / 2u);
+		if( imuiToolboxDropDownCompareSearchText( state->searchItems[ middle ].text, state->search, state->searchLength ) < 0 )
 		{
-			imuiWidgetDrawSkin( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemHover ] );
+			begin = middle + 1u;
 		}
-		else if( list->itemIndex == list->state->selectedIndex )
+		else
 		{
-			imuiWidgetDrawSkin( item, skin, s_theme.colors[ ImuiToolboxColor_ListItemSelected ] );
+			end = middle;
 		}
+	}
 
-		if( inputState.hasMouseReleased )
-		{
-			list->state->selectedIndex = list->itemIndex;
-			list->changed = true;
-		}
+	if( begin == state->itemCount ||
+		imuiToolboxDropDownCompareSearchText( state->searchItems[ begin ].text, state->search, state->searchLength ) != 0 )
+	{
+		return (uintsize)-1;
 	}
 
-	return item;
+	return state->searchItems[ begin ].index;
 }
 
-bool imuiToolboxListEnd( ImuiToolboxListContext* list )
+static bool imuiToolboxDropDownUpdateSearch( ImuiToolboxDropDownState* state, ImuiWindow* window )
 {
-	imuiToolboxListItemEndInternal( list );
+	const ImuiInputState* input = imuiWindowGetInput( window );
+	const char* textInput = imuiInputGetText( input );
+	if( !textInput || !*textInput )
+	{
+		return false;
+	}
 
-	imuiWidgetEnd( list->listLayout );
-	imuiToolboxScrollAreaEnd( &list->scrollArea );
+	const double time = imuiWindowGetTime( window );
+	if( time - state->searchTime > s_theme.dropDown.searchTime )
+	{
+		state->searchLength = 0u;
+	}
+	state->searchTime = time;
 
-	return list->changed;
+	while( *textInput && state->searchLength < sizeof( state->search ) )
+	{
+		state->search[ state->searchLength++ ] = *textInput++;
+	}
+
+	if( !state->hasSearchItems &&
+		!imuiToolboxDropDownBuildSearchItems( state ) )
+	{
+		return false;
+	}
+
+	const uintsize index = imuiToolboxDropDownFindSearchItem( state );
+	if( index == (uintsize)-1 || index == state->selectedIndex )
+	{
+		return false;
+	}
+
+	state->selectedIndex = index;
+	return true;
 }
 
 ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, ImuiWindow* window, const char** items, size_t itemCount, size_t itemStride )
+{
+	return imuiToolboxDropDownBeginVersion( dropDown, window, items, itemCount, itemStride, 0u );
+}
+
+ImuiWidget* imuiToolboxDropDownBeginVersion( ImuiToolboxDropDownContext* dropDown, ImuiWindow* window, const char** items, size_t itemCount, size_t itemStride, uint64_t itemsVersion )
 {
 	if( itemStride == 0u )
 	{
 		itemStride = sizeof( const char* );
 	}
 
-	dropDown->dropDown = imuiWidgetBegin( window );
+	dropDown->dropDown	= imuiWidgetBegin( window );
+	dropDown->changed	= false;
 	imuiWidgetSetPadding( dropDown->dropDown, s_theme.dropDown.padding );
 	imuiWidgetSetFixedHeight( dropDown->dropDown, s_theme.dropDown.height );
 
 	bool isNew;
-	dropDown->state = (ImuiToolboxDropDownState*)imuiWidgetAllocStateNew( dropDown->dropDown, sizeof( *dropDown->state ), IMUI_ID_STR( "drop down" ), &isNew );
+	dropDown->state = (ImuiToolboxDropDownState*)imuiWidgetAllocStateNewDestruct( dropDown->dropDown, sizeof( *dropDown->state ), IMUI_ID_STR( "drop down" ), &isNew, imuiToolboxDropDownStateDestruct );
+	ImuiToolboxDropDownState* state = dropDown->state;
 	if( isNew )
 	{
-		dropDown->state->selectedIndex = (uintsize)-1;
+		state->selectedIndex	= (uintsize)-1;
+		state->allocator		= &window->context->allocator;
+	}
+
+	if( isNew ||
+		state->items != items ||
+		state->itemCount != itemCount ||
+		state->itemStride != itemStride ||
+		state->itemsVersion != itemsVersion ||
+		state->font != s_theme.font )
+	{
+		state->items			= items;
+		state->itemCount		= itemCount;
+		state->itemStride		= itemStride;
+		state->itemsVersion		= itemsVersion;
+		state->font				= s_theme.font;
+		state->hasSearchItems	= false;
+
+		state->maxSize = imuiSizeCreateZero();
+		const uint8* itemsBytes = (const uint8*)items;
+		for( uintsize i = 0; i < itemCount; ++i )
+		{
+			const char* itemText = *(const char**)itemsBytes;
+			state->maxSize = imuiSizeMax( state->maxSize, imuiTextLayoutCalculateSize( window->context, s_theme.font, itemText, strlen( itemText ) ) );
+
+			itemsBytes += itemStride;
+		}
 	}
 
 	ImuiWidgetInputState inputState;
@@ -1857,7 +4327,7 @@ ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, Imui
 		color = s_theme.colors[ ImuiToolboxColor_DropDownHover ];
 	}
 
-	imuiWidgetDrawSkin( dropDown->dropDown, &s_theme.skins[ ImuiToolboxSkin_DropDown ], color );
+	imuiWidgetDrawSkinDescriptor( dropDown->dropDown, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_DropDown ), color );
 
 	ImuiWidget* icon = imuiWidgetBegin( window );
 	const ImuiImage iconImage = s_theme.icons[ dropDown->state->isOpen ? ImuiToolboxIcon_DropDownClose : ImuiToolboxIcon_DropDownOpen ];
@@ -1867,32 +4337,17 @@ ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, Imui
 	imuiWidgetDrawImageColor( icon, &iconImage, s_theme.colors[ ImuiToolboxColor_DropDownIcon ] );
 	imuiWidgetEnd( icon );
 
-	ImuiSize maxSize = imuiSizeCreateZero();
-	ImuiTextLayout* selectedTextLayout = NULL;
-	const uint8* itemsBytes = (const byte*)items;
-	for( uintsize i = 0; i < itemCount; ++i )
-	{
-		const char* itemText = *(const char**)itemsBytes;
-		ImuiTextLayout* textLayout = imuiTextLayoutCreateWidget( dropDown->dropDown, s_theme.font, itemText );
-
-		maxSize = imuiSizeMax( maxSize, imuiTextLayoutGetSize( textLayout ) );
-
-		if( i == dropDown->state->selectedIndex )
-		{
-			selectedTextLayout = textLayout;
-		}
-
-		itemsBytes += itemStride;
-	}
-
+	const ImuiSize maxSize = state->maxSize;
 	imuiWidgetSetMinWidth( dropDown->dropDown, maxSize.width + imuiBorderGetMinSize( s_theme.dropDown.padding ).width + s_theme.dropDown.padding.left + imuiWidgetGetSize( icon ).width );
 
 	ImuiWidget* text = imuiWidgetBegin( window );
 	imuiWidgetSetFixedSize( text, maxSize );
 	imuiWidgetSetVAlign( text, 0.5f );
 
-	if( selectedTextLayout )
+	if( state->selectedIndex < itemCount )
 	{
+		const char* selectedText = *(const char**)((const uint8*)items + (state->selectedIndex * itemStride));
+		ImuiTextLayout* selectedTextLayout = imuiTextLayoutCreateWidget( dropDown->dropDown, s_theme.font, selectedText );
 		imuiWidgetDrawText( text, selectedTextLayout, s_theme.colors[ ImuiToolboxColor_DropDownText ] );
 	}
 
@@ -1903,6 +4358,12 @@ ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, Imui
 		dropDown->state->isOpen = !dropDown->state->isOpen;
 	}
 
+	bool searchChanged = false;
+	if( dropDown->state->isOpen && itemCount > 0u )
+	{
+		searchChanged = imuiToolboxDropDownUpdateSearch( state, window );
+	}
+
 	if( dropDown->state->isOpen && itemCount > 0u )
 	{
 		ImuiSurface* surface = imuiWindowGetSurface( window );
@@ -1951,11 +4412,18 @@ ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, Imui
 		ImuiWidgetInputState listInputState;
 		imuiWidgetGetInputState( list.list, &listInputState );
 
-		imuiWidgetDrawSkin( listWindow->rootWidget, &s_theme.skins[ ImuiToolboxSkin_DropDownList ], s_theme.colors[ ImuiToolboxColor_DropDownList ] );
+		imuiWidgetDrawSkinDescriptor( listWindow->rootWidget, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_DropDownList ), s_theme.colors[ ImuiToolboxColor_DropDownList ] );
 
 		imuiToolboxListSetSelectedIndex( &list, dropDown->state->selectedIndex );
 
-		itemsBytes = (const byte*)items;
+		if( searchChanged )
+		{
+			// scroll the found item to the top, takes effect next frame
+			const float scaledItemSize = (s_theme.dropDown.itemSize + s_theme.dropDown.itemSpacing) * imuiWindowGetDpiScale( listWindow );
+			list.scrollArea.state->offset.y = scaledItemSize * (float)dropDown->state->selectedIndex;
+		}
+
+		const uint8* itemsBytes = (const uint8*)items;
 		for( uintsize i = imuiToolboxListGetBeginIndex( &list ); i < imuiToolboxListGetEndIndex( &list ); ++i )
 		{
 			const char* itemText = *(const char**)(itemsBytes + (i * itemStride));
@@ -1977,7 +4445,7 @@ ImuiWidget* imuiToolboxDropDownBegin( ImuiToolboxDropDownContext* dropDown, Imui
 		}
 		else
 		{
-			dropDown->changed = false;
+			dropDown->changed = searchChanged;
 		}
 
 		s_theme.list.itemSpacing = oldItemSpacing;
@@ -2041,7 +4509,7 @@ ImuiWindow* imuiToolboxPopupBeginSurface( ImuiSurface* surface )
 	imuiWidgetSetPadding( popup, s_theme.popup.padding );
 	imuiWidgetSetLayoutVertical( popup );
 
-	imuiWidgetDrawSkin( popup, &s_theme.skins[ ImuiToolboxSkin_Popup ], s_theme.colors[ ImuiToolboxColor_Popup ] );
+	imuiWidgetDrawSkinDescriptor( popup, imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_Popup ), s_theme.colors[ ImuiToolboxColor_Popup ] );
 
 	return popupWindow;
 }
@@ -2119,18 +4587,18 @@ ImuiWidget* imuiToolboxTabViewHeaderBegin( ImuiToolboxTabViewContext* tabView )
 	imuiWidgetSetPadding( tabHeader, s_theme.tabView.headerPadding );
 
 	ImuiColor color = s_theme.colors[ ImuiToolboxColor_TabViewHeaderInactive ];
-	const ImuiSkin* skin = &s_theme.skins[ ImuiToolboxSkin_TabViewHeaderInactive ];
+	const ImuiSkinDescriptor* skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_TabViewHeaderInactive );
 
 	if( tabView->state->selectedTab == tabView->headerCount )
 	{
 		color = s_theme.colors[ ImuiToolboxColor_TabViewHeaderActive ];
-		skin = &s_theme.skins[ ImuiToolboxSkin_TabViewHeaderActive ];
+		skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_TabViewHeaderActive );
 
 		tabView->selectedHeaderOffset	= imuiWidgetGetPosX( tabHeader ) - imuiWidgetGetPosX( tabView->head );
 		tabView->selectedHeaderWidth	= imuiWidgetGetSizeWidth( tabHeader );
 	}
 
-	imuiWidgetDrawSkin( tabHeader, skin, color );
+	imuiWidgetDrawSkinDescriptor( tabHeader, skin, color );
 
 	return tabHeader;
 }
@@ -2163,21 +4631,12 @@ ImuiWidget* imuiToolboxTabViewBodyBegin( ImuiToolboxTabViewContext* tabView )
 	imuiWidgetSetStretchOne( tabView->body );
 	imuiWidgetSetPadding( tabView->body, s_theme.tabView.bodyPadding );
 
-	const ImuiSkin* skin = &s_theme.skins[ ImuiToolboxSkin_TabViewBody ];
-
-	const float uScale = skin->width ? (skin->uv.u1 - skin->uv.u0) / skin->width : 0.0f;
-	const float vScale = skin->height ? (skin->uv.v1 - skin->uv.v0) / skin->height : 0.0f;
-
-	ImuiBorder uvBorder = skin->border;
-	uvBorder.top	*= vScale;
-	uvBorder.left	*= uScale;
-	uvBorder.bottom	*= vScale;
-	uvBorder.right	*= uScale;
+	const ImuiSkinDescriptor* skin = imuiToolboxGetSkinDescriptor( ImuiToolboxSkin_TabViewBody );
 
 	ImuiImage image;
 	image.textureHandle	= skin->textureHandle;
-	image.width			= skin->width;
-	image.height		= skin->height;
+	image.width			= 0u;
+	image.height		= 0u;
 	image.uv			= skin->uv;
 
 	ImuiRect rect = imuiWidgetGetRect( tabView->body );
@@ -2198,13 +4657,13 @@ ImuiWidget* imuiToolboxTabViewBodyBegin( ImuiToolboxTabViewContext* tabView )
 	const float yCenterBottom	= yBottom - (skin->border.bottom * yScale);
 
 	const float uLeft			= skin->uv.u0;
-	const float uCenterLeft		= uLeft + uvBorder.left;
+	const float uCenterLeft		= skin->centerUv.u0;
 	const float uRight			= skin->uv.u1;
-	const float uCenterRight	= uRight - uvBorder.right;
+	const float uCenterRight	= skin->centerUv.u1;
 	const float vTop			= skin->uv.v0;
-	const float vCenterTop		= vTop + uvBorder.top;
+	const float vCenterTop		= skin->centerUv.v0;
 	const float vBottom			= skin->uv.v1;
-	const float vCenterBottom	= vBottom - uvBorder.bottom;
+	const float vCenterBottom	= skin->centerUv.v1;
 
 	const float xPositions[] =
 	{
@@ -2245,8 +4704,8 @@ ImuiWidget* imuiToolboxTabViewBodyBegin( ImuiToolboxTabViewContext* tabView )
 
 		uintsize uvX = x;
 		uintsize uvY = 0u;
-		float posX = xPositions[ x ];
-		float nextPosX = xPositions[ nextX ];
+		float posX = x < 3u ? xPositions[ x ] : 0.0f;
+		float nextPosX = x < 3u ? xPositions[ nextX ] : 0.0f;
 		if( x == 0u && tabView->selectedHeaderOffset == 0.0f )
 		{
 			uvY = 1u;
@@ -45,9 +45,45 @@ typedef struct ImuiStringView
 #ifndef IMUI_DEFAULT_STRING_POOL_CHUNK_SIZE
 #	define IMUI_DEFAULT_STRING_POOL_CHUNK_SIZE		4096u
 #endif
+#ifndef IMUI_DEFAULT_STRING_ARENA_CHUNK_SIZE
+#	define IMUI_DEFAULT_STRING_ARENA_CHUNK_SIZE		4096u
+#endif
 #ifndef IMUI_DEFAULT_INPUT_STATE_CHUNK_SIZE
 #	define IMUI_DEFAULT_INPUT_STATE_CHUNK_SIZE		16u
 #endif
+#ifndef IMUI_DEFAULT_SLAB_CHUNK_SIZE
+#	define IMUI_DEFAULT_SLAB_CHUNK_SIZE				16384u
+#endif
+#ifndef IMUI_DEFAULT_TEXT_LAYOUT_CACHE_BUDGET
+#	define IMUI_DEFAULT_TEXT_LAYOUT_CACHE_BUDGET	(1024u * 1024u)
+#endif
+#ifndef IMUI_DEFAULT_TEXT_LAYOUT_CACHE_MAX_AGE
+#	define IMUI_DEFAULT_TEXT_LAYOUT_CACHE_MAX_AGE	600u
+#endif
+#ifndef IMUI_DEFAULT_TEXT_SIZE_CACHE_SIZE
+#	define IMUI_DEFAULT_TEXT_SIZE_CACHE_SIZE		512u	// must be power of two
+#endif
+#ifndef IMUI_DEFAULT_TEXT_SIZE_CACHE_TEXT_LENGTH
+#	define IMUI_DEFAULT_TEXT_SIZE_CACHE_TEXT_LENGTH	32u		// longer text is measured without cache
+#endif
+#ifndef IMUI_DEFAULT_THEME_OVERRIDE_STACK_SIZE
+#	define IMUI_DEFAULT_THEME_OVERRIDE_STACK_SIZE	64u
+#endif
+#ifndef IMUI_DEFAULT_FOCUS_GRID_CELL_WIDGET_COUNT
+#	define IMUI_DEFAULT_FOCUS_GRID_CELL_WIDGET_COUNT	16u	// directional focus uses a grid with this many widgets per cell on average
+#endif
+#ifndef IMUI_DEFAULT_DAMAGE_RECT_COUNT
+#	define IMUI_DEFAULT_DAMAGE_RECT_COUNT			8u	// more damaged areas get merged
+#endif
+#ifndef IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP
+#	define IMUI_DEFAULT_TEXT_WRAP_WIDTH_STEP		4.0f
+#endif
+#ifndef IMUI_DEFAULT_TRACE_DETAIL_LENGTH
+#	define IMUI_DEFAULT_TRACE_DETAIL_LENGTH		32u		// longer window names are cut in traces
+#endif
+#ifndef IMUI_DEFAULT_TREE_VIEW_ROW_SHIFTS
+#	define IMUI_DEFAULT_TREE_VIEW_ROW_SHIFTS		64u		// expands and collapses before the node to row map gets rebuilt
+#endif
 
 #define IMUI_FLOAT_INF (FLT_MAX / 100.0f)
 #define IMUI_SIZE_MAX ((uintsize)-1)
@@ -67,10 +103,29 @@ typedef struct ImuiStringView
 #	define IMUI_OFFSETOF( type, member )		__builtin_offsetof( type, member )
 #	define IMUI_COUNT_LEADING_ZEROS32( val )	__builtin_clz( val )
 #	define IMUI_COUNT_LEADING_ZEROS64( val )	__builtin_clzl( val )
+#	define IMUI_POPULATION_COUNT32( val )		__builtin_popcount( val )
 #else
 #	define IMUI_OFFSETOF( type, member )		((uintsize)(&((type*)0)->member))
 #	define IMUI_COUNT_LEADING_ZEROS32( val )	__lzcnt( val )
 #	define IMUI_COUNT_LEADING_ZEROS64( val )	__lzcnt64( val )
+#	define IMUI_POPULATION_COUNT32( val )		imuiPopulationCount32( val )	// __popcnt needs the POPCNT instruction
+
+static inline uint32 imuiPopulationCount32( uint32 value )
+{
+	value = value - ((value >> 1u) & 0x55555555u);
+	value = (value & 0x33333333u) + ((value >> 2u) & 0x33333333u);
+	value = (value + (value >> 4u)) & 0x0f0f0f0fu;
+	return (value * 0x01010101u) >> 24u;
+}
+#endif
+
+// define IMUI_NO_SIMD to use scalar code only
+#if !defined( IMUI_NO_SIMD )
+#	if defined( __SSE2__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+#		define IMUI_SIMD_SSE2
+#	elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#		define IMUI_SIMD_NEON
+#	endif
 #endif
 
 #if defined( _M_X64 ) || defined( __amd64__ ) || defined( _M_ARM64 ) || defined( __aarch64__ )